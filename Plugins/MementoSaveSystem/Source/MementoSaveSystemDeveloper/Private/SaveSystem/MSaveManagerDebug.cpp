@@ -19,7 +19,7 @@
 void UMSaveManagerDebug::Initialize(UMSaveManager* SaveManagerIn)
 {
 	this->SaveManager = SaveManagerIn;
-	SaveManager->OnSaveSlotUpdated.AddUObject(this, &UMSaveManagerDebug::OnSaveSlotUpdated);
+	SaveManager->OnSaveGraphChanged.AddUObject(this, &UMSaveManagerDebug::OnSaveGraphChanged);
 
 	RefreshConsoleCommands();
 
@@ -72,11 +72,17 @@ void UMSaveManagerDebug::Initialize(UMSaveManager* SaveManagerIn)
 		TEXT("Clone a save slot by name and user index to a new name and user index"),
 		FConsoleCommandWithArgsDelegate::CreateUObject(this, &UMSaveManagerDebug::ConsoleCloneSaveSlot),
 		ECVF_Cheat);
+
+	ConsoleManager.RegisterConsoleCommand(
+		TEXT("MSaveManager.CompactGraph"),
+		TEXT("Remove the save nodes of the active slot which the retention settings no longer keep"),
+		FConsoleCommandDelegate::CreateUObject(this, &UMSaveManagerDebug::ConsoleCompactSaveGraph),
+		ECVF_Cheat);
 }
 
 void UMSaveManagerDebug::Deinitialize()
 {
-	SaveManager->OnSaveSlotUpdated.RemoveAll(this);
+	SaveManager->OnSaveGraphChanged.RemoveAll(this);
 
 	if (FSlateApplication::IsInitialized())
 		FSlateApplication::Get().OnApplicationPreInputKeyDownListener().Remove(KeyDownDelegateHandle);
@@ -92,12 +98,16 @@ void UMSaveManagerDebug::Deinitialize()
 	ConsoleManager.UnregisterConsoleObject(TEXT("MSaveManager.LoadSlot"));
 	ConsoleManager.UnregisterConsoleObject(TEXT("MSaveManager.DeleteSlot"));
 	ConsoleManager.UnregisterConsoleObject(TEXT("MSaveManager.CloneSlot"));
+	ConsoleManager.UnregisterConsoleObject(TEXT("MSaveManager.CompactGraph"));
 
 	SaveManager = nullptr;
 }
 
-void UMSaveManagerDebug::OnSaveSlotUpdated(UMSaveGame* SaveGame)
+void UMSaveManagerDebug::OnSaveGraphChanged(const FMSaveGraphEvent& Event)
 {
+	// The auto completion only lists nodes, not which one is active
+	if (Event.Type == EMSaveGraphEventType::ActiveNodeChanged) return;
+
 	RefreshConsoleCommands();
 }
 
@@ -117,18 +127,12 @@ void UMSaveManagerDebug::HandleKeyDown(const FKeyEvent& Event)
 	}
 	else if (Event.GetKey() == EKeys::NumPadThree)
 	{
-		// Load the node whose SequenceParent is the active node
-		bool bFound = false;
-		for (const TTuple<FGuid, FMSaveNodeMetadata>& SaveNode : ActiveSaveGame->SaveNodes)
-		{
-			if (SaveNode.Value.SequenceParentId == ActiveSaveGame->MostRecentNodeId)
-			{
-				ConsoleLoadGame({ SaveNode.Key.ToString() });
-				bFound = true;
-				break;
-			}
-		}
-		if (!bFound && GEngine)
+		// Load the first node whose SequenceParent is the active node
+		TArray<FGuid> SequenceChildren;
+		ActiveSaveGame->GetChildren(ActiveSaveGame->MostRecentNodeId, EMSaveLineage::Sequence, SequenceChildren);
+
+		if (!SequenceChildren.IsEmpty()) ConsoleLoadGame({ SequenceChildren[0].ToString() });
+		else if (GEngine)
 			GEngine->AddOnScreenDebugMessage(0, 5.0f, FColor::Red, TEXT("Failed to load save (no children exist)"));
 	}
 	else if (Event.GetKey() == EKeys::NumPadFive)
@@ -485,3 +489,23 @@ void UMSaveManagerDebug::ConsoleCloneSaveSlot(const TArray<FString>& Args)
 				FCString::Atoi(*Args[3])));
 	}
 }
+
+void UMSaveManagerDebug::ConsoleCompactSaveGraph()
+{
+	bool bStarted = SaveManager->CompactSaveGraph();
+
+	if (!GEngine) return;
+
+	UMSaveGame* ActiveSaveGame = SaveManager->GetActiveSaveGame();
+	if (!ActiveSaveGame) return;
+
+	GEngine->AddOnScreenDebugMessage(
+		0,
+		5.0f,
+		bStarted ? FColor::Green : FColor::Yellow,
+		FString::Printf(
+			TEXT("%s - %s:%d"),
+			bStarted ? TEXT("Compacting save graph") : TEXT("Nothing to compact"),
+			*ActiveSaveGame->SlotName,
+			ActiveSaveGame->UserIndex));
+}
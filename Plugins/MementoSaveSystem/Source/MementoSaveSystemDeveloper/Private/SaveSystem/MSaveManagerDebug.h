@@ -7,10 +7,10 @@
 
 #include "MSaveManagerDebug.generated.h"
 
-class UMSaveGame;
 class UMSaveManager;
 struct FKeyEvent;
 struct FAutoCompleteCommand;
+struct FMSaveGraphEvent;
 
 /** Debug functionality for the UMSaveManager */
 UCLASS()
@@ -30,8 +30,8 @@ private:
 	UPROPERTY()
 	UMSaveManager* SaveManager;
 
-	/** Listener for SaveManager::OnSaveSlotUpdated */
-	void OnSaveSlotUpdated(UMSaveGame* SaveGame);
+	/** Listener for SaveManager::OnSaveGraphChanged */
+	void OnSaveGraphChanged(const FMSaveGraphEvent& Event);
 
 	/** Handles debug key inputs for quick save and load */
 	void HandleKeyDown(const FKeyEvent& EventArgs);
@@ -68,4 +68,7 @@ private:
 
 	/** Calls MSaveManager::CloneSaveSlot(originalSlotName, originalUserIndex, newSlotName, newUserIndex) */
 	void ConsoleCloneSaveSlot(const TArray<FString>& Args);
+
+	/** Calls MSaveManager::CompactSaveGraph() */
+	void ConsoleCompactSaveGraph();
 };
@@ -46,7 +46,7 @@ void FMementoSaveSystemEditorModule::OnPIEStarted(bool bIsSimulating)
 	UMSaveManager* SaveManager = GameInstance->GetSubsystem<UMSaveManager>();
 	if (!SaveManager) return;
 
-	SaveManager->OnSaveSlotUpdated.AddRaw(this, &FMementoSaveSystemEditorModule::OnSaveSlotUpdated);
+	SaveManager->OnSaveGraphChanged.AddRaw(this, &FMementoSaveSystemEditorModule::OnSaveGraphChanged);
 }
 
 void FMementoSaveSystemEditorModule::OnPIEEnded(bool bIsSimulating)
@@ -60,13 +60,13 @@ void FMementoSaveSystemEditorModule::OnPIEEnded(bool bIsSimulating)
 	UMSaveManager* SaveManager = GameInstance->GetSubsystem<UMSaveManager>();
 	if (!SaveManager) return;
 
-	SaveManager->OnSaveSlotUpdated.RemoveAll(this);
+	SaveManager->OnSaveGraphChanged.RemoveAll(this);
 }
 
-void FMementoSaveSystemEditorModule::OnSaveSlotUpdated(UMSaveGame* SaveGame)
+void FMementoSaveSystemEditorModule::OnSaveGraphChanged(const FMSaveGraphEvent& Event)
 {
 	if (!SaveGraphWidget) return;
-	SaveGraphWidget->RefreshGraph(SaveGame);
+	SaveGraphWidget->ApplyGraphEvent(Event);
 }
 
 TSharedRef<SDockTab> FMementoSaveSystemEditorModule::SpawnSaveGraphTab(const FSpawnTabArgs& SpawnTabArgs)
@@ -6,9 +6,9 @@
 #include "Modules/ModuleManager.h"
 
 class SDockTab;
-class UMSaveGame;
 class SMSaveGraph;
 class FSpawnTabArgs;
+struct FMSaveGraphEvent;
 
 /** Memento Save System Editor Module */
 class FMementoSaveSystemEditorModule : public IModuleInterface
@@ -24,14 +24,14 @@ private:
 	/** Save Graph visualization widget */
 	TSharedPtr<SMSaveGraph> SaveGraphWidget;
 
-	/** Subscribe to UMSaveManager::OnSaveSlotUpdated */
+	/** Subscribe to UMSaveManager::OnSaveGraphChanged */
 	void OnPIEStarted(bool bIsSimulating);
 
-	/** Unsubscribe from UMSaveManager::OnSaveSlotUpdated */
+	/** Unsubscribe from UMSaveManager::OnSaveGraphChanged */
 	void OnPIEEnded(bool bIsSimulating);
 
-	/** Handle UMSaveManager::OnSaveSlotUpdated */
-	void OnSaveSlotUpdated(UMSaveGame* SaveGame);
+	/** Handle UMSaveManager::OnSaveGraphChanged */
+	void OnSaveGraphChanged(const FMSaveGraphEvent& Event);
 
 	/** Spawns the Save Graph visualization tab */
 	TSharedRef<SDockTab> SpawnSaveGraphTab(const FSpawnTabArgs& SpawnTabArgs);
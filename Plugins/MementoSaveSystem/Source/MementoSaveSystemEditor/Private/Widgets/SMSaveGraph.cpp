@@ -7,6 +7,7 @@
 #include "Rendering/SlateLayoutTransform.h"
 #include "SaveGraphNode.h"
 #include "SaveSystem/MSaveGame.h"
+#include "SaveSystem/MSaveGraphEvent.h"
 #include "Widgets/SNullWidget.h"
 
 void SMSaveGraph::Construct(const FArguments& InArgs)
@@ -20,44 +21,44 @@ void SMSaveGraph::Construct(const FArguments& InArgs)
 
 void SMSaveGraph::RefreshGraph(UMSaveGame* SaveGame)
 {
-	if (!SaveGame) return;
-
-	SaveSlotLabel = FString::Printf(TEXT("%s:%d"), *SaveGame->SlotName, SaveGame->UserIndex);
 	SaveGraphNodes.Reset();
 	MaximumWidth = NodeSize.X;
 	MaximumHeight = NodeSize.Y;
 
-	if (SaveGame->SaveNodes.IsEmpty()) return;
+	if (!SaveGame)
+	{
+		SaveSlotLabel = TEXT("No save slot loaded");
+		return;
+	}
 
-	// 1. Construct a map of all children
-	TMap<FGuid, TArray<FGuid>> BranchChildren;
-	TMap<FGuid, TArray<FGuid>> SequenceChildren;
-	FGuid					   RootNodeId;
+	SaveSlotLabel = FString::Printf(TEXT("%s:%d"), *SaveGame->SlotName, SaveGame->UserIndex);
 
-	for (const TTuple<FGuid, FMSaveNodeMetadata>& SaveNode : SaveGame->SaveNodes)
-	{
-		if (!SaveNode.Value.BranchParentId.IsValid())
-		{
-			RootNodeId = SaveNode.Key;
-			continue;
-		}
+	if (SaveGame->SaveNodes.IsEmpty()) return;
 
-		BranchChildren.FindOrAdd(SaveNode.Value.BranchParentId).Add(SaveNode.Key);
-		SequenceChildren.FindOrAdd(SaveNode.Value.SequenceParentId).Add(SaveNode.Key);
-	}
+	// 1. Find the root node, i.e. the first child of the invalid id
+	TArray<FGuid> RootNodeIds;
+	SaveGame->GetChildren(FGuid(), EMSaveLineage::Branch, RootNodeIds);
+	if (RootNodeIds.IsEmpty()) return;
+
+	const FGuid& RootNodeId = RootNodeIds[0];
 
 	// 2. Find the y position of all nodes, based on the depth of BranchChildren
 	TQueue<FMSaveGraphNode> DepthQueue;
 	TArray<FMSaveGraphNode> ColumnStack; // Create this ahead of time to save a time on iterations
 
+	TArray<FGuid> RootBranchChildren;
+	TArray<FGuid> RootSequenceChildren;
+	SaveGame->GetChildren(RootNodeId, EMSaveLineage::Branch, RootBranchChildren);
+	SaveGame->GetChildren(RootNodeId, EMSaveLineage::Sequence, RootSequenceChildren);
+
 	DepthQueue.Enqueue({
 		RootNodeId,
 		RootNodeId.ToString().Left(8),
 		{ Spacing.X, Spacing.Y },
 		RootNodeId == SaveGame->MostRecentNodeId,
 		SaveGame->SaveNodes[RootNodeId].bInvisible,
-		BranchChildren.FindRef(RootNodeId),
-		SequenceChildren.FindRef(RootNodeId),
+		RootBranchChildren,
+		RootSequenceChildren,
 	});
 
 	while (!DepthQueue.IsEmpty())
@@ -70,8 +71,10 @@ void SMSaveGraph::RefreshGraph(UMSaveGame* SaveGame)
 
 		for (const FGuid& ChildId : GraphNode.BranchChildren)
 		{
-			TArray<FGuid> NodeBranchChildren = BranchChildren.FindRef(ChildId);
-			TArray<FGuid> NodeSequenceChildren = SequenceChildren.FindRef(ChildId);
+			TArray<FGuid> NodeBranchChildren;
+			TArray<FGuid> NodeSequenceChildren;
+			SaveGame->GetChildren(ChildId, EMSaveLineage::Branch, NodeBranchChildren);
+			SaveGame->GetChildren(ChildId, EMSaveLineage::Sequence, NodeSequenceChildren);
 
 			DepthQueue.Enqueue({
 				ChildId,
@@ -107,6 +110,54 @@ void SMSaveGraph::RefreshGraph(UMSaveGame* SaveGame)
 	}
 }
 
+void SMSaveGraph::ApplyGraphEvent(const FMSaveGraphEvent& Event)
+{
+	// Having missed a revision, the widget cannot tell what else changed
+	bool bInSync = Event.Revision == Revision + 1;
+	Revision = Event.Revision;
+
+	// Moving the selection does not change the layout
+	if (bInSync && Event.Type == EMSaveGraphEventType::ActiveNodeChanged)
+	{
+		if (FMSaveGraphNode* OldNode = SaveGraphNodes.Find(Event.OldNodeId)) OldNode->bSelected = false;
+		if (FMSaveGraphNode* NewNode = SaveGraphNodes.Find(Event.NewNodeId)) NewNode->bSelected = true;
+		return;
+	}
+
+	if (bInSync && Event.Type == EMSaveGraphEventType::NodeAdded && AddGraphNode(Event.Metadata)) return;
+
+	// Removed nodes shift the columns of other nodes, so the layout is redone as a whole
+	RefreshGraph(Event.SaveGame);
+}
+
+bool SMSaveGraph::AddGraphNode(const FMSaveNodeMetadata& Metadata)
+{
+	FMSaveGraphNode* BranchParent = SaveGraphNodes.Find(Metadata.BranchParentId);
+	FMSaveGraphNode* SequenceParent = SaveGraphNodes.Find(Metadata.SequenceParentId);
+	if (!BranchParent || (Metadata.SequenceParentId.IsValid() && !SequenceParent)) return false;
+	if (SaveGraphNodes.Contains(Metadata.SaveId)) return false;
+
+	FMSaveGraphNode GraphNode;
+	GraphNode.SaveId = Metadata.SaveId;
+	GraphNode.Label = Metadata.SaveId.ToString().Left(8);
+	GraphNode.bInvisible = Metadata.bInvisible;
+
+	// A leaf parent hands its column down to its first branch child. Any other child opens a new column to the right,
+	// which only differs from a refreshed layout in the order of the columns.
+	GraphNode.Position.X = BranchParent->BranchChildren.IsEmpty() ? BranchParent->Position.X : MaximumWidth;
+	GraphNode.Position.Y = BranchParent->Position.Y + NodeSize.Y + Spacing.Y;
+
+	BranchParent->BranchChildren.Add(Metadata.SaveId);
+	if (SequenceParent) SequenceParent->SequenceChildren.Add(Metadata.SaveId);
+
+	MaximumWidth = FMath::Max(MaximumWidth, GraphNode.Position.X + NodeSize.X + Spacing.X);
+	MaximumHeight = FMath::Max(MaximumHeight, GraphNode.Position.Y + NodeSize.Y + Spacing.Y);
+
+	// Adding may reallocate the map, so the parents are updated before
+	SaveGraphNodes.Add(Metadata.SaveId, MoveTemp(GraphNode));
+	return true;
+}
+
 int32 SMSaveGraph::OnPaint(
 	const FPaintArgs&		 Args,
 	const FGeometry&		 AllottedGeometry,
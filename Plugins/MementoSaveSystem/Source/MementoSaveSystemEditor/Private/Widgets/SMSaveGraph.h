@@ -6,6 +6,8 @@
 #include "Widgets/SCompoundWidget.h"
 
 class UMSaveGame;
+struct FMSaveGraphEvent;
+struct FMSaveNodeMetadata;
 
 /** Save Graph Widget */
 class SMSaveGraph : public SCompoundWidget
@@ -19,7 +21,13 @@ public:
 	/** Refresh Graph internals */
 	void RefreshGraph(UMSaveGame* SaveGame);
 
+	/** Apply a change to the save graph, only refreshing the whole graph if the layout changed */
+	void ApplyGraphEvent(const FMSaveGraphEvent& Event);
+
 private:
+	/** The revision of the last save graph change applied */
+	int64 Revision = 0;
+
 	/** Node size */
 	FVector2f NodeSize = FVector2f(120.0f, 40.0f);
 
@@ -38,6 +46,9 @@ private:
 	/** Lighter-weight representation of the nodes contained in a UMSaveGame */
 	TMap<FGuid, FMSaveGraphNode> SaveGraphNodes;
 
+	/** Adds a new leaf node without moving any other node. Returns false if the graph has to be refreshed instead. */
+	bool AddGraphNode(const FMSaveNodeMetadata& Metadata);
+
 	/** Display the Save Graph */
 	virtual int32 OnPaint(
 		const FPaintArgs&		 Args,
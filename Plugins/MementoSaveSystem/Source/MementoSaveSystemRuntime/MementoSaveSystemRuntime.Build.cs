@@ -11,7 +11,12 @@ public class MementoSaveSystemRuntime : ModuleRules
 		PublicDependencyModuleNames.AddRange(new string[] {
 			"Core",
 			"CoreUObject",
-			"Engine"
+			"Engine",
+
+			"DeveloperSettings"
 		});
+
+		// Compression dictionaries need zlib itself, FCompression does not expose them
+		AddEngineThirdPartyPrivateStaticDependencies(Target, "zlib");
 	}
 }
@@ -0,0 +1,792 @@
+// Copyright © Bedrockbreaker 2025. MIT License
+
+#include "SaveSystem/MSaveBlobStore.h"
+
+#include "Algo/Sort.h"
+#include "Containers/StaticArray.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/Paths.h"
+#include "SaveSystem/MSaveCodec.h"
+#include "SaveSystem/MSaveData.h"
+#include "SaveSystem/MSaveManager.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+namespace MSaveBlobStore
+{
+	/** Identifies a blob store file */
+	constexpr uint32 FileMagic = 0x424C424D; // "MBLB"
+
+	/** Bumped whenever the file layout changes */
+	constexpr uint32 FileVersion = 1;
+
+	/** Size of the file header (magic + version) */
+	constexpr int64 FileHeaderSize = sizeof(uint32) * 2;
+
+	/** Size of a chunk record header (hash + size + codec + flags + stored size + dictionary hash) */
+	constexpr int64 RecordHeaderSize =
+		sizeof(FIoHash) + sizeof(uint32) + sizeof(uint8) + sizeof(uint8) + sizeof(uint32) + sizeof(FIoHash);
+
+	/** Marks a record holding a compression dictionary rather than payload data */
+	constexpr uint8 DictionaryFlag = 1 << 0;
+
+	/** Returns the path a store is rewritten to before replacing the original, or being used in its place */
+	static FString GetTempPath(const FString& FilePath)
+	{
+		return FilePath + TEXT(".tmp");
+	}
+
+	/** Chunks are never cut smaller than this, and data smaller than this is never split */
+	constexpr int32 MinChunkSize = 2 * 1024;
+
+	/** Chunks are always cut once they reach this size */
+	constexpr int32 MaxChunkSize = 64 * 1024;
+
+	/** A boundary is cut when the top 13 bits of the rolling hash are zero, for an ~8KiB average past the minimum */
+	constexpr uint64 BoundaryMask = 0xFFF8000000000000ull;
+
+	/** Random values for the gear rolling hash. Generated with splitmix64 so they are stable across runs. */
+	static const TStaticArray<uint64, 256>& GetGearTable()
+	{
+		static const TStaticArray<uint64, 256> GearTable = []() -> TStaticArray<uint64, 256> {
+			TStaticArray<uint64, 256> Table;
+			uint64					  State = 0;
+			for (int32 Index = 0; Index < 256; ++Index)
+			{
+				State += 0x9E3779B97F4A7C15ull;
+				uint64 Value = State;
+				Value = (Value ^ (Value >> 30)) * 0xBF58476D1CE4E5B9ull;
+				Value = (Value ^ (Value >> 27)) * 0x94D049BB133111EBull;
+				Table[Index] = Value ^ (Value >> 31);
+			}
+			return Table;
+		}();
+		return GearTable;
+	}
+} // namespace MSaveBlobStore
+
+FMSaveBlobStore::FMSaveBlobStore(const FString& InFilePath) : FilePath(InFilePath), ActivePath(InFilePath) {}
+
+FMSaveBlobStore::~FMSaveBlobStore()
+{
+	Close();
+}
+
+bool FMSaveBlobStore::Store(
+	TConstArrayView<uint8>	Data,
+	TArray<FMSaveChunkRef>& OutChunks,
+	EMSaveCompression		Compression,
+	FMSaveBlobStats*		Stats)
+{
+	OutChunks.Reset();
+
+	TArray<int32> ChunkSizes;
+	FindChunkBoundaries(Data, ChunkSizes);
+
+	// 1. Hash outside of the lock, since it is the most expensive part after compressing
+
+	TArray<int64, TInlineAllocator<16>> ChunkOffsets;
+	OutChunks.Reserve(ChunkSizes.Num());
+	ChunkOffsets.Reserve(ChunkSizes.Num());
+
+	int64 ChunkOffset = 0;
+	for (int32 ChunkSize : ChunkSizes)
+	{
+		FMSaveChunkRef& Chunk = OutChunks.AddDefaulted_GetRef();
+		Chunk.Hash = FIoHash::HashBuffer(Data.GetData() + ChunkOffset, ChunkSize);
+		Chunk.Size = ChunkSize;
+		ChunkOffsets.Add(ChunkOffset);
+		ChunkOffset += ChunkSize;
+	}
+
+	// 2. Find the chunks which are new to the store, and the dictionary to compress them with
+
+	TArray<int32, TInlineAllocator<16>> NewChunks;
+	TSharedPtr<const TArray<uint8>>		Dictionary;
+	FIoHash								NewDictionaryHash = FIoHash::Zero;
+	{
+		FScopeLock ScopeLock(&Lock);
+		if (!OpenLocked()) return false;
+
+		TSet<FIoHash, DefaultKeyFuncs<FIoHash>, TInlineSetAllocator<16>> NewHashes;
+		for (int32 Index = 0; Index < OutChunks.Num(); ++Index)
+		{
+			const FIoHash& Hash = OutChunks[Index].Hash;
+			if (!Chunks.Contains(Hash) && !NewHashes.Contains(Hash))
+			{
+				NewHashes.Add(Hash);
+				NewChunks.Add(Index);
+			}
+		}
+
+		if (FMSaveCodec::UsesDictionary(Compression) && !DictionaryHash.IsZero())
+		{
+			Dictionary = GetDictionaryLocked(DictionaryHash);
+			if (Dictionary) NewDictionaryHash = DictionaryHash;
+		}
+	}
+
+	// 3. Compress the new chunks outside of the lock, so other payloads can be stored meanwhile
+
+	TArray<TArray<uint8>> CompressedChunks;
+	CompressedChunks.SetNum(NewChunks.Num());
+
+	TConstArrayView<uint8> DictionaryData = Dictionary ? TConstArrayView<uint8>(*Dictionary) : TConstArrayView<uint8>();
+
+	double CompressStartTime = FPlatformTime::Seconds();
+	for (int32 Index = 0; Index < NewChunks.Num(); ++Index)
+	{
+		int32				   ChunkIndex = NewChunks[Index];
+		TConstArrayView<uint8> ChunkData(Data.GetData() + ChunkOffsets[ChunkIndex], OutChunks[ChunkIndex].Size);
+		FMSaveCodec::Compress(Compression, DictionaryData, ChunkData, CompressedChunks[Index]);
+	}
+
+	if (Stats)
+	{
+		Stats->PayloadSize += Data.Num();
+		Stats->CodecTime += FPlatformTime::Seconds() - CompressStartTime;
+	}
+
+	// 4. Append every new chunk, unless another payload appended the same one meanwhile
+
+	FScopeLock ScopeLock(&Lock);
+	if (!OpenLocked()) return false;
+
+	for (int32 Index = 0; Index < NewChunks.Num(); ++Index)
+	{
+		const FMSaveChunkRef& Chunk = OutChunks[NewChunks[Index]];
+		if (Chunks.Contains(Chunk.Hash)) continue;
+
+		// Chunks which did not shrink are stored as is
+		bool				   bCompressed = !CompressedChunks[Index].IsEmpty();
+		TConstArrayView<uint8> StoredBytes = bCompressed
+			? TConstArrayView<uint8>(CompressedChunks[Index])
+			: TConstArrayView<uint8>(Data.GetData() + ChunkOffsets[NewChunks[Index]], Chunk.Size);
+
+		bool bAppended = AppendLocked(
+			Chunk.Hash,
+			Chunk.Size,
+			bCompressed ? Compression : EMSaveCompression::None,
+			bCompressed ? NewDictionaryHash : FIoHash::Zero,
+			/* bDictionary = */ false,
+			StoredBytes);
+		if (!bAppended) return false;
+
+		if (Stats)
+		{
+			Stats->NewChunkSize += Chunk.Size;
+			Stats->StoredSize += StoredBytes.Num();
+		}
+	}
+
+	return true;
+}
+
+bool FMSaveBlobStore::Load(TConstArrayView<FMSaveChunkRef> InChunks, TArray<uint8>& OutData, FMSaveBlobStats* Stats)
+{
+	OutData.Reset();
+
+	int64 TotalSize = 0;
+	for (const FMSaveChunkRef& Chunk : InChunks)
+	{
+		TotalSize += Chunk.Size;
+	}
+	OutData.SetNumUninitialized(TotalSize);
+
+	/** A compressed chunk read from the store, to be decompressed outside of the lock */
+	struct FCompressedChunk
+	{
+		int64							DataOffset = 0;
+		uint32							Size = 0;
+		EMSaveCompression				Compression = EMSaveCompression::None;
+		TSharedPtr<const TArray<uint8>> Dictionary;
+		TArray<uint8>					StoredBytes;
+	};
+
+	TArray<FCompressedChunk> CompressedChunks;
+
+	// 1. Read every chunk, uncompressed ones straight into place
+	{
+		FScopeLock ScopeLock(&Lock);
+		if (!OpenLocked()) return false;
+
+		int64 DataOffset = 0;
+		for (const FMSaveChunkRef& Chunk : InChunks)
+		{
+			const FChunkLocation* Location = Chunks.Find(Chunk.Hash);
+			if (!Location || Location->Size != Chunk.Size)
+			{
+				UE_LOG(
+					LogMSaveManager,
+					Warning,
+					TEXT("Blob store %s is missing chunk %s"),
+					*FilePath,
+					*LexToString(Chunk.Hash));
+				OutData.Reset();
+				return false;
+			}
+
+			uint8* Destination = OutData.GetData() + DataOffset;
+			if (Location->Compression != EMSaveCompression::None)
+			{
+				FCompressedChunk& CompressedChunk = CompressedChunks.AddDefaulted_GetRef();
+				CompressedChunk.DataOffset = DataOffset;
+				CompressedChunk.Size = Chunk.Size;
+				CompressedChunk.Compression = Location->Compression;
+				CompressedChunk.StoredBytes.SetNumUninitialized(Location->StoredSize);
+				Destination = CompressedChunk.StoredBytes.GetData();
+
+				if (!Location->DictionaryHash.IsZero())
+				{
+					CompressedChunk.Dictionary = GetDictionaryLocked(Location->DictionaryHash);
+					if (!CompressedChunk.Dictionary)
+					{
+						OutData.Reset();
+						return false;
+					}
+				}
+			}
+
+			if (!FileHandle->Seek(Location->Offset) || !FileHandle->Read(Destination, Location->StoredSize))
+			{
+				UE_LOG(LogMSaveManager, Warning, TEXT("Failed to read chunk from blob store %s"), *FilePath);
+				OutData.Reset();
+				return false;
+			}
+
+			DataOffset += Chunk.Size;
+		}
+	}
+
+	// 2. Decompress the rest outside of the lock
+
+	double DecompressStartTime = FPlatformTime::Seconds();
+	for (const FCompressedChunk& CompressedChunk : CompressedChunks)
+	{
+		TArrayView<uint8>	   Destination(OutData.GetData() + CompressedChunk.DataOffset, CompressedChunk.Size);
+		TConstArrayView<uint8> Dictionary = CompressedChunk.Dictionary
+			? TConstArrayView<uint8>(*CompressedChunk.Dictionary)
+			: TConstArrayView<uint8>();
+
+		if (!FMSaveCodec::Decompress(CompressedChunk.Compression, Dictionary, CompressedChunk.StoredBytes, Destination))
+		{
+			UE_LOG(LogMSaveManager, Warning, TEXT("Failed to decompress chunk from blob store %s"), *FilePath);
+			OutData.Reset();
+			return false;
+		}
+	}
+
+	if (Stats)
+	{
+		Stats->PayloadSize += TotalSize;
+		Stats->CodecTime += FPlatformTime::Seconds() - DecompressStartTime;
+	}
+
+	return true;
+}
+
+TSharedPtr<const FMSaveMappedRegion> FMSaveBlobStore::Map(
+	TConstArrayView<FMSaveChunkRef> InChunks, TArray<FMemoryView>& OutViews)
+{
+	OutViews.Reset(InChunks.Num());
+
+	FScopeLock ScopeLock(&Lock);
+	if (!OpenLocked()) return nullptr;
+
+	// 1. Locate every chunk first, so a stale mapping is replaced at most once
+
+	TArray<FChunkLocation, TInlineAllocator<16>> Locations;
+	Locations.Reserve(InChunks.Num());
+
+	int64 MappedEnd = 0;
+	for (const FMSaveChunkRef& Chunk : InChunks)
+	{
+		const FChunkLocation* Location = Chunks.Find(Chunk.Hash);
+		if (!Location || Location->Size != Chunk.Size) return nullptr;
+
+		// Compressed chunks have to be decompressed into memory of their own
+		if (Location->Compression != EMSaveCompression::None) return nullptr;
+
+		Locations.Add(*Location);
+		MappedEnd = FMath::Max(MappedEnd, Location->Offset + Location->Size);
+	}
+
+	// 2. Map the store file, unless the current mapping already covers every chunk
+
+	if (!MappedRegion || MappedRegion->Region->GetMappedSize() < MappedEnd)
+	{
+		// Chunks appended since the file was last flushed would not be visible to the mapping
+		FileHandle->Flush();
+
+		TSharedRef<FMSaveMappedRegion> NewRegion = MakeShared<FMSaveMappedRegion>();
+		NewRegion->Handle.Reset(FPlatformFileManager::Get().GetPlatformFile().OpenMapped(*ActivePath));
+		if (NewRegion->Handle) NewRegion->Region.Reset(NewRegion->Handle->MapRegion(0, EndOffset));
+		if (!NewRegion->Region) return nullptr;
+
+		MappedRegion = NewRegion;
+	}
+
+	// 3. Point into the mapping
+
+	const uint8* MappedData = MappedRegion->Region->GetMappedPtr();
+	for (const FChunkLocation& Location : Locations)
+	{
+		OutViews.Add(FMemoryView(MappedData + Location.Offset, Location.Size));
+	}
+
+	return MappedRegion;
+}
+
+bool FMSaveBlobStore::Contains(const FIoHash& Hash)
+{
+	FScopeLock ScopeLock(&Lock);
+	return OpenLocked() && Chunks.Contains(Hash);
+}
+
+int64 FMSaveBlobStore::GetTotalSize()
+{
+	FScopeLock ScopeLock(&Lock);
+	return OpenLocked() ? EndOffset : 0;
+}
+
+bool FMSaveBlobStore::Compact(const TSet<FIoHash>& LiveChunks)
+{
+	using namespace MSaveBlobStore;
+
+	FScopeLock ScopeLock(&Lock);
+	if (!OpenLocked()) return false;
+
+	// A compacted store still in use in place of the store file can't be replaced safely until that one is gone
+	if (ActivePath != FilePath)
+	{
+		UE_LOG(LogMSaveManager, Log, TEXT("Skipped compacting blob store %s, it is still being replaced"), *FilePath);
+		return true;
+	}
+
+	// 1. Gather the live chunks, along with the dictionaries they were compressed with
+
+	TSet<FIoHash> KeptHashes;
+	for (const TTuple<FIoHash, FChunkLocation>& Chunk : Chunks)
+	{
+		if (Chunk.Value.bDictionary || !LiveChunks.Contains(Chunk.Key)) continue;
+
+		KeptHashes.Add(Chunk.Key);
+		if (!Chunk.Value.DictionaryHash.IsZero()) KeptHashes.Add(Chunk.Value.DictionaryHash);
+	}
+
+	if (!DictionaryHash.IsZero()) KeptHashes.Add(DictionaryHash);
+	if (KeptHashes.Num() == Chunks.Num()) return true;
+
+	// 2. Copy them into a temporary store in their original order. The latest dictionary is the one new chunks are
+	// compressed with once the store is reopened, so the current dictionary goes last.
+
+	TArray<FIoHash> KeptOrder = KeptHashes.Array();
+	Algo::Sort(KeptOrder, [this](const FIoHash& A, const FIoHash& B) {
+		if ((A == DictionaryHash) != (B == DictionaryHash)) return B == DictionaryHash;
+		return Chunks[A].Offset < Chunks[B].Offset;
+	});
+
+	FString		  TempPath = GetTempPath(FilePath);
+	IFileManager& FileManager = IFileManager::Get();
+	FileManager.Delete(*TempPath);
+
+	bool bSuccess = true;
+	{
+		FMSaveBlobStore TempStore(TempPath);
+		FScopeLock		TempLock(&TempStore.Lock);
+		bSuccess = TempStore.OpenLocked();
+
+		TArray<uint8> StoredBytes;
+		for (int32 Index = 0; Index < KeptOrder.Num() && bSuccess; ++Index)
+		{
+			const FChunkLocation& Location = Chunks[KeptOrder[Index]];
+			StoredBytes.SetNumUninitialized(Location.StoredSize);
+
+			// Chunks are copied as they are stored, so nothing is decompressed or compressed again
+			bSuccess = FileHandle->Seek(Location.Offset)
+					&& FileHandle->Read(StoredBytes.GetData(), Location.StoredSize)
+					&& TempStore.AppendLocked(
+						KeptOrder[Index],
+						Location.Size,
+						Location.Compression,
+						Location.DictionaryHash,
+						Location.bDictionary,
+						StoredBytes);
+		}
+
+		bSuccess = bSuccess && TempStore.FileHandle->Flush();
+		TempStore.FileHandle.Reset();
+	}
+
+	// 3. Swap it in. Payloads mapped from the store may keep the platform from replacing it, the compacted store is
+	// then used in its place instead. Chunks keep their hashes, so those payloads stay valid either way. The store is
+	// reopened on next use, whether or not anything was swapped in.
+
+	FileHandle.Reset();
+	Chunks.Reset();
+	EndOffset = 0;
+	DictionaryHash = FIoHash::Zero;
+	Dictionaries.Reset();
+	MappedRegion.Reset();
+
+	if (bSuccess && !FileManager.Move(*FilePath, *TempPath, /* bReplace = */ true))
+	{
+		bSuccess = FileManager.Move(*GetCompactedPath(FilePath), *TempPath, /* bReplace = */ true);
+		if (bSuccess)
+		{
+			UE_LOG(LogMSaveManager, Log, TEXT("Blob store %s is still mapped, replacing it once reopened"), *FilePath);
+		}
+	}
+
+	if (!bSuccess)
+	{
+		UE_LOG(LogMSaveManager, Warning, TEXT("Failed to compact blob store %s"), *FilePath);
+		FileManager.Delete(*TempPath);
+		return false;
+	}
+
+	return true;
+}
+
+bool FMSaveBlobStore::Flush()
+{
+	FScopeLock ScopeLock(&Lock);
+	return !FileHandle || FileHandle->Flush();
+}
+
+void FMSaveBlobStore::Close()
+{
+	FScopeLock ScopeLock(&Lock);
+	FileHandle.Reset();
+	Chunks.Reset();
+	EndOffset = 0;
+	DictionaryHash = FIoHash::Zero;
+	Dictionaries.Reset();
+
+	// Payloads still pointing into the mapping keep it alive on their own
+	MappedRegion.Reset();
+}
+
+FString FMSaveBlobStore::GetCompactedPath(const FString& FilePath)
+{
+	return FilePath + TEXT(".compacted");
+}
+
+void FMSaveBlobStore::FindChunkBoundaries(TConstArrayView<uint8> Data, TArray<int32>& OutChunkSizes)
+{
+	using namespace MSaveBlobStore;
+
+	OutChunkSizes.Reset();
+
+	const TStaticArray<uint64, 256>& GearTable = GetGearTable();
+	const int32						 DataSize = Data.Num();
+
+	for (int32 ChunkStart = 0; ChunkStart < DataSize;)
+	{
+		int32 Remaining = DataSize - ChunkStart;
+		int32 ChunkSize = FMath::Min(Remaining, MaxChunkSize);
+
+		// Gear hash over the bytes past the minimum size, cutting as soon as the boundary condition is met
+		if (Remaining > MinChunkSize)
+		{
+			const uint8* ChunkData = Data.GetData() + ChunkStart;
+			uint64		 Hash = 0;
+			for (int32 Index = MinChunkSize; Index < ChunkSize; ++Index)
+			{
+				Hash = (Hash << 1) + GearTable[ChunkData[Index]];
+				if ((Hash & BoundaryMask) == 0)
+				{
+					ChunkSize = Index + 1;
+					break;
+				}
+			}
+		}
+
+		OutChunkSizes.Add(ChunkSize);
+		ChunkStart += ChunkSize;
+	}
+}
+
+bool FMSaveBlobStore::OpenLocked()
+{
+	using namespace MSaveBlobStore;
+
+	if (FileHandle) return true;
+
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	PlatformFile.CreateDirectoryTree(*FPaths::GetPath(FilePath));
+
+	// 1. Finish replacing the store file with a compacted store, which is used in its place for as long as the store
+	// file can't be replaced
+
+	FString CompactedPath = GetCompactedPath(FilePath);
+	ActivePath = FilePath;
+	if (PlatformFile.FileExists(*CompactedPath)
+		&& !IFileManager::Get().Move(*FilePath, *CompactedPath, /* bReplace = */ true))
+	{
+		ActivePath = CompactedPath;
+	}
+
+	FileHandle.Reset(PlatformFile.OpenWrite(*ActivePath, /* bAppend = */ true, /* bAllowRead = */ true));
+	if (!FileHandle)
+	{
+		UE_LOG(LogMSaveManager, Warning, TEXT("Failed to open blob store %s"), *ActivePath);
+		return false;
+	}
+
+	int64 FileSize = FileHandle->Size();
+
+	// 2. Write the header for new stores, or validate it for existing ones
+
+	if (FileSize < FileHeaderSize)
+	{
+		TArray<uint8> Header;
+		FMemoryWriter Writer(Header);
+		uint32		  Magic = FileMagic;
+		uint32		  Version = FileVersion;
+		Writer << Magic;
+		Writer << Version;
+
+		if (!FileHandle->Seek(0) || !FileHandle->Write(Header.GetData(), Header.Num()))
+		{
+			FileHandle.Reset();
+			return false;
+		}
+
+		Chunks.Reset();
+		EndOffset = FileHeaderSize;
+		DictionaryHash = FIoHash::Zero;
+		return true;
+	}
+
+	uint8 HeaderBytes[FileHeaderSize];
+	FileHandle->Seek(0);
+	FileHandle->Read(HeaderBytes, FileHeaderSize);
+
+	FMemoryReaderView HeaderReader(MakeArrayView(HeaderBytes, FileHeaderSize));
+	uint32			  Magic = 0;
+	uint32			  Version = 0;
+	HeaderReader << Magic;
+	HeaderReader << Version;
+
+	if (Magic != FileMagic || Version != FileVersion)
+	{
+		UE_LOG(LogMSaveManager, Warning, TEXT("Blob store %s has an unknown format"), *ActivePath);
+		FileHandle.Reset();
+		return false;
+	}
+
+	// 3. Rebuild the index by walking the chunk records
+
+	Chunks.Reset();
+	EndOffset = FileHeaderSize;
+	DictionaryHash = FIoHash::Zero;
+
+	uint8 RecordHeader[RecordHeaderSize];
+	while (EndOffset + RecordHeaderSize <= FileSize)
+	{
+		FileHandle->Seek(EndOffset);
+		if (!FileHandle->Read(RecordHeader, RecordHeaderSize)) break;
+
+		FMemoryReaderView RecordReader(MakeArrayView(RecordHeader, RecordHeaderSize));
+		FIoHash			  Hash;
+		FChunkLocation	  Location;
+		uint8			  Codec = 0;
+		uint8			  Flags = 0;
+		RecordReader << Hash;
+		RecordReader << Location.Size;
+		RecordReader << Codec;
+		RecordReader << Flags;
+		RecordReader << Location.StoredSize;
+		RecordReader << Location.DictionaryHash;
+
+		if (Codec > static_cast<uint8>(EMSaveCompression::Oodle)) break;
+		Location.Compression = static_cast<EMSaveCompression>(Codec);
+
+		int64 RecordEnd = EndOffset + RecordHeaderSize + Location.StoredSize;
+		if (RecordEnd > FileSize) break;
+
+		Location.Offset = EndOffset + RecordHeaderSize;
+		Location.bDictionary = (Flags & DictionaryFlag) != 0;
+		Chunks.Add(Hash, Location);
+		EndOffset = RecordEnd;
+
+		// The latest dictionary is the one new chunks are compressed with
+		if (Location.bDictionary) DictionaryHash = Hash;
+	}
+
+	// A partially written record (e.g. from a crash) is discarded, and will be overwritten by the next chunk
+	if (EndOffset != FileSize)
+	{
+		UE_LOG(
+			LogMSaveManager,
+			Warning,
+			TEXT("Blob store %s has %lld trailing bytes, discarding them"),
+			*ActivePath,
+			FileSize - EndOffset);
+		FileHandle->Truncate(EndOffset);
+	}
+
+	return true;
+}
+
+bool FMSaveBlobStore::AppendLocked(
+	const FIoHash&		   Hash,
+	uint32				   Size,
+	EMSaveCompression	   Compression,
+	const FIoHash&		   InDictionaryHash,
+	bool				   bDictionary,
+	TConstArrayView<uint8> StoredBytes)
+{
+	using namespace MSaveBlobStore;
+
+	TArray<uint8> Record;
+	Record.Reserve(RecordHeaderSize + StoredBytes.Num());
+
+	FMemoryWriter Writer(Record);
+	FIoHash		  RecordHash = Hash;
+	uint32		  RecordSize = Size;
+	uint8		  Codec = static_cast<uint8>(Compression);
+	uint8		  Flags = bDictionary ? DictionaryFlag : 0;
+	uint32		  StoredSize = StoredBytes.Num();
+	FIoHash		  RecordDictionaryHash = InDictionaryHash;
+	Writer << RecordHash;
+	Writer << RecordSize;
+	Writer << Codec;
+	Writer << Flags;
+	Writer << StoredSize;
+	Writer << RecordDictionaryHash;
+
+	int64 HeaderSize = Record.Num();
+	Writer.Serialize(const_cast<uint8*>(StoredBytes.GetData()), StoredBytes.Num());
+
+	if (!FileHandle->Seek(EndOffset) || !FileHandle->Write(Record.GetData(), Record.Num()))
+	{
+		UE_LOG(LogMSaveManager, Warning, TEXT("Failed to write chunk to blob store %s"), *FilePath);
+		return false;
+	}
+
+	FChunkLocation Location;
+	Location.Offset = EndOffset + HeaderSize;
+	Location.Size = Size;
+	Location.StoredSize = StoredBytes.Num();
+	Location.Compression = Compression;
+	Location.DictionaryHash = InDictionaryHash;
+	Location.bDictionary = bDictionary;
+	Chunks.Add(Hash, Location);
+	EndOffset += Record.Num();
+
+	return true;
+}
+
+TSharedPtr<const TArray<uint8>> FMSaveBlobStore::GetDictionaryLocked(const FIoHash& Hash)
+{
+	if (const TSharedRef<const TArray<uint8>>* Dictionary = Dictionaries.Find(Hash)) return *Dictionary;
+
+	// Dictionaries are always stored as is
+	const FChunkLocation* Location = Chunks.Find(Hash);
+	if (!Location || !Location->bDictionary || Location->Compression != EMSaveCompression::None)
+	{
+		UE_LOG(LogMSaveManager, Warning, TEXT("Blob store %s is missing dictionary %s"), *FilePath, *LexToString(Hash));
+		return nullptr;
+	}
+
+	TSharedRef<TArray<uint8>> Dictionary = MakeShared<TArray<uint8>>();
+	Dictionary->SetNumUninitialized(Location->Size);
+	if (!FileHandle->Seek(Location->Offset) || !FileHandle->Read(Dictionary->GetData(), Location->Size))
+	{
+		UE_LOG(LogMSaveManager, Warning, TEXT("Failed to read dictionary from blob store %s"), *FilePath);
+		return nullptr;
+	}
+
+	Dictionaries.Add(Hash, Dictionary);
+	return Dictionary;
+}
+
+bool FMSaveBlobStore::TrainDictionary()
+{
+	using namespace MSaveBlobStore;
+
+	FScopeLock ScopeLock(&Lock);
+	if (!OpenLocked()) return false;
+
+	// 1. Gather the most recently stored chunks, up to the dictionary size
+
+	TArray<FIoHash> ChunkHashes;
+	ChunkHashes.Reserve(Chunks.Num());
+	for (const TTuple<FIoHash, FChunkLocation>& Chunk : Chunks)
+	{
+		if (!Chunk.Value.bDictionary) ChunkHashes.Add(Chunk.Key);
+	}
+
+	Algo::Sort(ChunkHashes, [this](const FIoHash& A, const FIoHash& B) { return Chunks[A].Offset > Chunks[B].Offset; });
+
+	TArray<TArray<uint8>> Samples;
+	int32				  DictionarySize = 0;
+	for (const FIoHash& Hash : ChunkHashes)
+	{
+		if (DictionarySize >= FMSaveCodec::MaxDictionarySize) break;
+
+		const FChunkLocation& Location = Chunks[Hash];
+		TArray<uint8>		  StoredBytes;
+		StoredBytes.SetNumUninitialized(Location.StoredSize);
+		if (!FileHandle->Seek(Location.Offset) || !FileHandle->Read(StoredBytes.GetData(), Location.StoredSize)) break;
+
+		TArray<uint8>& Sample = Samples.AddDefaulted_GetRef();
+		if (Location.Compression == EMSaveCompression::None)
+		{
+			Sample = MoveTemp(StoredBytes);
+		}
+		else
+		{
+			TSharedPtr<const TArray<uint8>> ChunkDictionary;
+			if (!Location.DictionaryHash.IsZero()) ChunkDictionary = GetDictionaryLocked(Location.DictionaryHash);
+
+			Sample.SetNumUninitialized(Location.Size);
+			TConstArrayView<uint8> DictionaryData =
+				ChunkDictionary ? TConstArrayView<uint8>(*ChunkDictionary) : TConstArrayView<uint8>();
+			if (!FMSaveCodec::Decompress(Location.Compression, DictionaryData, StoredBytes, Sample))
+			{
+				Samples.Pop();
+				continue;
+			}
+		}
+
+		DictionarySize += Sample.Num();
+	}
+
+	if (Samples.IsEmpty()) return false;
+
+	// 2. Lay the samples out oldest first, since zlib favours the end of the dictionary. Only the tail is kept.
+
+	TArray<uint8> Dictionary;
+	Dictionary.Reserve(DictionarySize);
+	for (int32 Index = Samples.Num() - 1; Index >= 0; --Index)
+	{
+		Dictionary.Append(Samples[Index]);
+	}
+
+	if (Dictionary.Num() > FMSaveCodec::MaxDictionarySize)
+		Dictionary.RemoveAt(0, Dictionary.Num() - FMSaveCodec::MaxDictionarySize, EAllowShrinking::No);
+
+	// 3. Store it, so chunks compressed with it can still be read back after the store is reopened
+
+	FIoHash Hash = FIoHash::HashBuffer(Dictionary.GetData(), Dictionary.Num());
+	if (!Chunks.Contains(Hash))
+	{
+		bool bAppended = AppendLocked(
+			Hash,
+			Dictionary.Num(),
+			EMSaveCompression::None,
+			FIoHash::Zero,
+			/* bDictionary = */ true,
+			Dictionary);
+		if (!bAppended) return false;
+	}
+
+	Dictionaries.Add(Hash, MakeShared<TArray<uint8>>(MoveTemp(Dictionary)));
+	DictionaryHash = Hash;
+	return true;
+}
@@ -0,0 +1,159 @@
+// Copyright © Bedrockbreaker 2025. MIT License
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Async/MappedFileHandle.h"
+#include "HAL/CriticalSection.h"
+#include "IO/IoHash.h"
+#include "Memory/MemoryView.h"
+#include "SaveSystem/MSaveCompression.h"
+
+class IFileHandle;
+struct FMSaveChunkRef;
+
+/** A read-only memory mapping of a blob store file. Stays valid for as long as anything points into it. */
+struct FMSaveMappedRegion
+{
+	TUniquePtr<IMappedFileHandle> Handle;
+	TUniquePtr<IMappedFileRegion> Region;
+};
+
+/** Sizes and timings of storing or loading payloads, accumulated across calls */
+struct FMSaveBlobStats
+{
+	/** The uncompressed size of every payload */
+	int64 PayloadSize = 0;
+
+	/** The uncompressed size of the chunks which were not in the store yet */
+	int64 NewChunkSize = 0;
+
+	/** The size those chunks were stored with, after compression */
+	int64 StoredSize = 0;
+
+	/** Time spent compressing or decompressing, in seconds */
+	double CodecTime = 0.0;
+};
+
+/**
+ * Per-slot content-addressed store for save data payloads.
+ *
+ * Payloads are split into content-defined chunks, and every distinct chunk is appended to the store exactly once.
+ * Save nodes only reference chunks by hash, so unchanged data is shared between every node in the slot.
+ *
+ * Each chunk is compressed on its own, with the codec chosen when it was stored. Zlib chunks are primed with the
+ * store's dictionary, trained from the most recently stored chunks, since consecutive nodes tend to be very similar.
+ * Dictionaries are stored in the store as well, and stay there for as long as any chunk was compressed with them.
+ * Thread-safe.
+ */
+class FMSaveBlobStore
+{
+public:
+	explicit FMSaveBlobStore(const FString& InFilePath);
+	~FMSaveBlobStore();
+
+	/** Splits data into content-defined chunks, compressing and appending any chunk not already in the store */
+	bool Store(
+		TConstArrayView<uint8>	Data,
+		TArray<FMSaveChunkRef>& OutChunks,
+		EMSaveCompression		Compression = EMSaveCompression::None,
+		FMSaveBlobStats*		Stats = nullptr);
+
+	/** Reassembles data from its chunks, decompressing them as needed */
+	bool Load(TConstArrayView<FMSaveChunkRef> InChunks, TArray<uint8>& OutData, FMSaveBlobStats* Stats = nullptr);
+
+	/**
+	 * Maps the store file into memory and returns a view of every chunk in place, without reading or copying them.
+	 * Returns null if the store could not be mapped (e.g. on platforms without mapped files) or any of the chunks is
+	 * compressed, Load still works then.
+	 */
+	TSharedPtr<const FMSaveMappedRegion> Map(TConstArrayView<FMSaveChunkRef> InChunks, TArray<FMemoryView>& OutViews);
+
+	/** Whether a chunk is present in the store */
+	bool Contains(const FIoHash& Hash);
+
+	/** Returns the total size of the store on disk, in bytes */
+	int64 GetTotalSize();
+
+	/**
+	 * Trains a new compression dictionary from the most recently stored chunks, used for every chunk stored from then
+	 * on.
+	 * Returns false if the store holds nothing to train from.
+	 */
+	bool TrainDictionary();
+
+	/**
+	 * Rewrites the store without any chunk outside of LiveChunks, keeping the dictionaries the remaining chunks were
+	 * compressed with, and the one new chunks are compressed with.
+	 * The remaining chunks are copied into a new file which then replaces the store, so a rewrite cut short leaves the
+	 * store as it was. Some platforms refuse to replace a file while payloads are still mapped from it, in which case
+	 * the new file is used in its place (see GetCompactedPath) until it can replace it, the next time the store opens.
+	 */
+	bool Compact(const TSet<FIoHash>& LiveChunks);
+
+	/** Flushes any buffered writes to disk */
+	bool Flush();
+
+	/** Closes the underlying file, so it can be moved or deleted. The store reopens it on next use. */
+	void Close();
+
+	/** Splits data into content-defined chunks, returning the size of each chunk */
+	static void FindChunkBoundaries(TConstArrayView<uint8> Data, TArray<int32>& OutChunkSizes);
+
+	/** Returns the path of a compacted store which could not replace the store file yet, and is used in its place */
+	static FString GetCompactedPath(const FString& FilePath);
+
+private:
+	/** Where a chunk lives within the store file, and how it is stored there */
+	struct FChunkLocation
+	{
+		int64			  Offset = 0;
+		uint32			  Size = 0;
+		uint32			  StoredSize = 0;
+		EMSaveCompression Compression = EMSaveCompression::None;
+		FIoHash			  DictionaryHash = FIoHash::Zero;
+		bool			  bDictionary = false;
+	};
+
+	/** The path of the store file */
+	FString FilePath;
+
+	/** The path of the file the store currently lives in. FilePath, unless a compacted store is used in its place. */
+	FString ActivePath;
+
+	/** Maps chunk hashes to their location within the store file */
+	TMap<FIoHash, FChunkLocation> Chunks;
+
+	/** Read/write handle to the store file, opened lazily */
+	TUniquePtr<IFileHandle> FileHandle;
+
+	/** The offset one past the last valid chunk record */
+	int64 EndOffset = 0;
+
+	/** The dictionary newly stored chunks are primed with. Zero if the store has none. */
+	FIoHash DictionaryHash = FIoHash::Zero;
+
+	/** Dictionaries read back from the store, keyed by hash */
+	TMap<FIoHash, TSharedRef<const TArray<uint8>>> Dictionaries;
+
+	/** The latest mapping of the store file. Replaced once chunks are needed past its end, not unmapped while used. */
+	TSharedPtr<const FMSaveMappedRegion> MappedRegion;
+
+	/** Guards all file access and the chunk index */
+	FCriticalSection Lock;
+
+	/** Opens the store file and rebuilds the chunk index from it, if not already open */
+	bool OpenLocked();
+
+	/** Appends a chunk record, with the chunk's bytes as they are to be stored */
+	bool AppendLocked(
+		const FIoHash&		   Hash,
+		uint32				   Size,
+		EMSaveCompression	   Compression,
+		const FIoHash&		   InDictionaryHash,
+		bool				   bDictionary,
+		TConstArrayView<uint8> StoredBytes);
+
+	/** Reads a dictionary, or returns null if it is missing from the store */
+	TSharedPtr<const TArray<uint8>> GetDictionaryLocked(const FIoHash& Hash);
+};
@@ -0,0 +1,129 @@
+// Copyright © Bedrockbreaker 2025. MIT License
+
+#include "SaveSystem/MSaveCodec.h"
+
+#include "Misc/Compression.h"
+
+THIRD_PARTY_INCLUDES_START
+#include "zlib.h"
+THIRD_PARTY_INCLUDES_END
+
+namespace MSaveCodec
+{
+	/** Returns the name FCompression knows a codec by */
+	static FName GetFormatName(EMSaveCompression Compression)
+	{
+		switch (Compression)
+		{
+			case EMSaveCompression::LZ4:
+				return NAME_LZ4;
+			case EMSaveCompression::Zlib:
+				return NAME_Zlib;
+			case EMSaveCompression::Oodle:
+				return NAME_Oodle;
+			default:
+				return NAME_None;
+		}
+	}
+
+	/** FCompression has no notion of dictionaries, so primed zlib streams go through zlib directly */
+	static bool CompressWithDictionary(
+		TConstArrayView<uint8> Dictionary, TConstArrayView<uint8> Data, TArray<uint8>& OutCompressed)
+	{
+		z_stream Stream = {};
+		if (deflateInit(&Stream, Z_DEFAULT_COMPRESSION) != Z_OK) return false;
+
+		bool bSuccess = deflateSetDictionary(&Stream, Dictionary.GetData(), Dictionary.Num()) == Z_OK;
+		OutCompressed.SetNumUninitialized(deflateBound(&Stream, Data.Num()));
+
+		Stream.next_in = const_cast<Bytef*>(Data.GetData());
+		Stream.avail_in = Data.Num();
+		Stream.next_out = OutCompressed.GetData();
+		Stream.avail_out = OutCompressed.Num();
+		bSuccess = bSuccess && deflate(&Stream, Z_FINISH) == Z_STREAM_END;
+
+		OutCompressed.SetNum(Stream.total_out, EAllowShrinking::No);
+		deflateEnd(&Stream);
+		return bSuccess;
+	}
+
+	/** Decompresses a zlib stream which was primed with a dictionary */
+	static bool DecompressWithDictionary(
+		TConstArrayView<uint8> Dictionary, TConstArrayView<uint8> Compressed, TArrayView<uint8> OutData)
+	{
+		z_stream Stream = {};
+		if (inflateInit(&Stream) != Z_OK) return false;
+
+		Stream.next_in = const_cast<Bytef*>(Compressed.GetData());
+		Stream.avail_in = Compressed.Num();
+		Stream.next_out = OutData.GetData();
+		Stream.avail_out = OutData.Num();
+
+		// The stream asks for its dictionary once it has read the header
+		int Result = inflate(&Stream, Z_FINISH);
+		if (Result == Z_NEED_DICT)
+		{
+			Result = inflateSetDictionary(&Stream, Dictionary.GetData(), Dictionary.Num()) == Z_OK
+				? inflate(&Stream, Z_FINISH)
+				: Z_DATA_ERROR;
+		}
+
+		bool bSuccess = Result == Z_STREAM_END && Stream.total_out == static_cast<uLong>(OutData.Num());
+		inflateEnd(&Stream);
+		return bSuccess;
+	}
+} // namespace MSaveCodec
+
+bool FMSaveCodec::Compress(
+	EMSaveCompression	   Compression,
+	TConstArrayView<uint8> Dictionary,
+	TConstArrayView<uint8> Data,
+	TArray<uint8>&		   OutCompressed)
+{
+	using namespace MSaveCodec;
+
+	OutCompressed.Reset();
+	if (Compression == EMSaveCompression::None || Data.IsEmpty()) return false;
+
+	bool bCompressed = false;
+	if (UsesDictionary(Compression) && !Dictionary.IsEmpty())
+	{
+		bCompressed = CompressWithDictionary(Dictionary, Data, OutCompressed);
+	}
+	else
+	{
+		FName FormatName = GetFormatName(Compression);
+		int32 CompressedSize = FCompression::CompressMemoryBound(FormatName, Data.Num());
+		OutCompressed.SetNumUninitialized(CompressedSize);
+
+		bCompressed = FCompression::CompressMemory(
+			FormatName, OutCompressed.GetData(), CompressedSize, Data.GetData(), Data.Num());
+		OutCompressed.SetNum(bCompressed ? CompressedSize : 0, EAllowShrinking::No);
+	}
+
+	// Incompressible chunks (e.g. already compressed textures) are cheaper to store as is
+	if (!bCompressed || OutCompressed.Num() >= Data.Num())
+	{
+		OutCompressed.Reset();
+		return false;
+	}
+
+	return true;
+}
+
+bool FMSaveCodec::Decompress(
+	EMSaveCompression	   Compression,
+	TConstArrayView<uint8> Dictionary,
+	TConstArrayView<uint8> Compressed,
+	TArrayView<uint8>	   OutData)
+{
+	using namespace MSaveCodec;
+
+	if (Compression == EMSaveCompression::None) return false;
+
+	if (UsesDictionary(Compression) && !Dictionary.IsEmpty())
+		return DecompressWithDictionary(Dictionary, Compressed, OutData);
+
+	return FCompression::UncompressMemory(
+		GetFormatName(Compression), OutData.GetData(), OutData.Num(), Compressed.GetData(), Compressed.Num());
+}
@@ -0,0 +1,34 @@
+// Copyright © Bedrockbreaker 2025. MIT License
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SaveSystem/MSaveCompression.h"
+
+/** Compresses and decompresses individual chunks of save data. Thread-safe. */
+class FMSaveCodec
+{
+public:
+	/** The maximum size of a compression dictionary, which is as far back as zlib can reference */
+	static constexpr int32 MaxDictionarySize = 32 * 1024;
+
+	/** Whether a codec is primed with the slot's dictionary, if it has one */
+	static bool UsesDictionary(EMSaveCompression Compression) { return Compression == EMSaveCompression::Zlib; }
+
+	/**
+	 * Compresses data, priming the codec with a dictionary if it uses one.
+	 * Returns false if the data could not be compressed or did not shrink, it should then be stored as is.
+	 */
+	static bool Compress(
+		EMSaveCompression	   Compression,
+		TConstArrayView<uint8> Dictionary,
+		TConstArrayView<uint8> Data,
+		TArray<uint8>&		   OutCompressed);
+
+	/** Decompresses data into a buffer of exactly its uncompressed size, with the dictionary it was compressed with */
+	static bool Decompress(
+		EMSaveCompression	   Compression,
+		TConstArrayView<uint8> Dictionary,
+		TConstArrayView<uint8> Compressed,
+		TArrayView<uint8>	   OutData);
+};
@@ -0,0 +1,121 @@
+// Copyright © Bedrockbreaker 2025. MIT License
+
+#include "SaveSystem/MSaveData.h"
+
+#include "Serialization/MemoryWriter.h"
+
+int64 FMSaveData::GetPayloadSize() const
+{
+	if (!IsPayloadMapped()) return Data.Num();
+
+	int64 Size = 0;
+	for (const FMemoryView& Chunk : MappedChunks)
+	{
+		Size += Chunk.GetSize();
+	}
+
+	return Size;
+}
+
+TConstArrayView<FMemoryView> FMSaveData::GetPayloadSegments(FMemoryView& OutDataView) const
+{
+	if (IsPayloadMapped()) return MappedChunks;
+
+	OutDataView = MakeMemoryView(Data);
+	return MakeArrayView(&OutDataView, 1);
+}
+
+void FMSaveData::LoadMappedPayload()
+{
+	if (!IsPayloadMapped()) return;
+
+	Data.SetNumUninitialized(GetPayloadSize());
+
+	int64 Offset = 0;
+	for (const FMemoryView& Chunk : MappedChunks)
+	{
+		FMemory::Memcpy(Data.GetData() + Offset, Chunk.GetData(), Chunk.GetSize());
+		Offset += Chunk.GetSize();
+	}
+
+	MappedChunks.Reset();
+	MappedRegion.Reset();
+}
+
+bool FMSaveData::IsIdentical(const FMSaveData& Other) const
+{
+	if (bOmitted || Other.bOmitted) return false;
+
+	if (ActorFName != Other.ActorFName || ClassName != Other.ClassName || Partition != Other.Partition
+		|| bSpawned != Other.bSpawned || !Transform.Equals(Other.Transform, 0.0))
+		return false;
+
+	if (!IsPayloadMapped() && !Other.IsPayloadMapped()) return Data == Other.Data;
+	if (GetPayloadSize() != Other.GetPayloadSize()) return false;
+
+	// Walk both payloads segment by segment, so neither has to be copied out of its mapping
+	FMemoryView					 DataView;
+	FMemoryView					 OtherDataView;
+	TConstArrayView<FMemoryView> Segments = GetPayloadSegments(DataView);
+	TConstArrayView<FMemoryView> OtherSegments = Other.GetPayloadSegments(OtherDataView);
+
+	int32  Index = 0;
+	int32  OtherIndex = 0;
+	uint64 Offset = 0;
+	uint64 OtherOffset = 0;
+	while (Index < Segments.Num() && OtherIndex < OtherSegments.Num())
+	{
+		const FMemoryView& Segment = Segments[Index];
+		const FMemoryView& OtherSegment = OtherSegments[OtherIndex];
+
+		uint64 Size = FMath::Min(Segment.GetSize() - Offset, OtherSegment.GetSize() - OtherOffset);
+		if (!Segment.Mid(Offset, Size).EqualBytes(OtherSegment.Mid(OtherOffset, Size))) return false;
+
+		Offset += Size;
+		OtherOffset += Size;
+
+		if (Offset == Segment.GetSize())
+		{
+			++Index;
+			Offset = 0;
+		}
+
+		if (OtherOffset == OtherSegment.GetSize())
+		{
+			++OtherIndex;
+			OtherOffset = 0;
+		}
+	}
+
+	return true;
+}
+
+FIoHash FMSaveData::GetContentHash() const
+{
+	if (bOmitted) return FIoHash::Zero;
+
+	// Everything but the payload is small, so serialize it up front
+	TArray<uint8> Header;
+	FMemoryWriter Writer(Header);
+	FString		  Class = ClassName;
+	FString		  ActorName = ActorFName.ToString();
+	FTransform	  ActorTransform = Transform;
+	bool		  bSpawnedActor = bSpawned;
+	FString		  PartitionName = Partition.ToString();
+	Writer << Class;
+	Writer << ActorName;
+	Writer << ActorTransform;
+	Writer << bSpawnedActor;
+	Writer << PartitionName;
+
+	FIoHashBuilder Builder;
+	Builder.Update(Header.GetData(), Header.Num());
+
+	FMemoryView DataView;
+	for (const FMemoryView& Segment : GetPayloadSegments(DataView))
+	{
+		Builder.Update(Segment);
+	}
+
+	return Builder.Finalize();
+}
@@ -0,0 +1,166 @@
+// Copyright © Bedrockbreaker 2025. MIT License
+
+#include "SaveSystem/MSaveGame.h"
+
+#include "Algo/Sort.h"
+
+FMSaveNodeMetadata& UMSaveGame::AddSaveNode(const FMSaveNodeMetadata& Metadata)
+{
+	// Re-adding a node may move it to other parents, which the intrusive lists cannot do in place
+	if (SaveNodes.Contains(Metadata.SaveId)) Adjacency.bDirty = true;
+
+	FMSaveNodeMetadata& NodeMetadata = SaveNodes.Add(Metadata.SaveId, Metadata);
+	if (!Adjacency.bDirty) LinkSaveNode(NodeMetadata);
+
+	return NodeMetadata;
+}
+
+bool UMSaveGame::RemoveSaveNode(const FGuid& SaveId, FMSaveNodeMetadata* OutMetadata)
+{
+	FMSaveNodeMetadata Metadata;
+	if (!SaveNodes.RemoveAndCopyValue(SaveId, Metadata)) return false;
+
+	Adjacency.bDirty = true;
+	if (OutMetadata) *OutMetadata = MoveTemp(Metadata);
+	return true;
+}
+
+void UMSaveGame::GetChildren(const FGuid& SaveId, EMSaveLineage Lineage, TArray<FGuid>& OutChildren) const
+{
+	OutChildren.Reset();
+	UpdateAdjacency();
+
+	int32 NodeIndex = FindNodeIndex(SaveId);
+	if (NodeIndex == INDEX_NONE) return;
+
+	const int32 L = static_cast<int32>(Lineage);
+	OutChildren.Reserve(Adjacency.NumChildren[L][NodeIndex]);
+	for (int32 Child = Adjacency.FirstChild[L][NodeIndex]; Child != INDEX_NONE; Child = Adjacency.NextSibling[L][Child])
+	{
+		OutChildren.Add(Adjacency.NodeIds[Child]);
+	}
+}
+
+int32 UMSaveGame::GetNumChildren(const FGuid& SaveId, EMSaveLineage Lineage) const
+{
+	UpdateAdjacency();
+
+	int32 NodeIndex = FindNodeIndex(SaveId);
+	return NodeIndex != INDEX_NONE ? Adjacency.NumChildren[static_cast<int32>(Lineage)][NodeIndex] : 0;
+}
+
+void UMSaveGame::RebuildAdjacency() const
+{
+	Adjacency.NodeIndices.Reset();
+	Adjacency.NodeIds.Reset();
+	Adjacency.NodeIndices.Reserve(SaveNodes.Num());
+	Adjacency.NodeIds.Reserve(SaveNodes.Num() + 1);
+
+	for (int32 L = 0; L < 2; ++L)
+	{
+		Adjacency.FirstChild[L].Reset(SaveNodes.Num() + 1);
+		Adjacency.LastChild[L].Reset(SaveNodes.Num() + 1);
+		Adjacency.NextSibling[L].Reset(SaveNodes.Num() + 1);
+		Adjacency.NumChildren[L].Reset(SaveNodes.Num() + 1);
+	}
+
+	// 1. Index the virtual root, then every node in timestamp order, so siblings end up in the order they were created
+
+	TArray<const FMSaveNodeMetadata*> SortedNodes;
+	SortedNodes.Reserve(SaveNodes.Num());
+	for (const TTuple<FGuid, FMSaveNodeMetadata>& Entry : SaveNodes)
+	{
+		SortedNodes.Add(&Entry.Value);
+	}
+	Algo::SortBy(SortedNodes, [](const FMSaveNodeMetadata* Metadata) { return Metadata->Timestamp; });
+
+	AddNodeIndex(FGuid());
+	for (const FMSaveNodeMetadata* Metadata : SortedNodes)
+	{
+		AddNodeIndex(Metadata->SaveId);
+	}
+
+	// 2. Link every node to its parents. Nodes whose parent is missing from the graph become roots.
+
+	for (int32 NodeIndex = 1; NodeIndex < Adjacency.NodeIds.Num(); ++NodeIndex)
+	{
+		const FMSaveNodeMetadata& Metadata = SaveNodes[Adjacency.NodeIds[NodeIndex]];
+		const FGuid				  ParentIds[2] = { Metadata.BranchParentId, Metadata.SequenceParentId };
+
+		for (int32 L = 0; L < 2; ++L)
+		{
+			int32 ParentIndex = FindNodeIndex(ParentIds[L]);
+			AppendChild(L, ParentIndex != INDEX_NONE ? ParentIndex : 0, NodeIndex);
+		}
+	}
+
+	Adjacency.bDirty = false;
+}
+
+void UMSaveGame::UpdateAdjacency() const
+{
+	// SaveNodes is a public property, so it may have been modified without going through AddSaveNode
+	if (Adjacency.bDirty || Adjacency.NodeIds.Num() != SaveNodes.Num() + 1) RebuildAdjacency();
+}
+
+void UMSaveGame::LinkSaveNode(const FMSaveNodeMetadata& Metadata) const
+{
+	if (Adjacency.NodeIds.IsEmpty())
+	{
+		Adjacency.bDirty = true;
+		return;
+	}
+
+	const FGuid ParentIds[2] = { Metadata.BranchParentId, Metadata.SequenceParentId };
+	int32		ParentIndices[2];
+	for (int32 L = 0; L < 2; ++L)
+	{
+		// A parent which is not indexed yet (e.g. added out of order) needs a full rebuild to end up linked correctly
+		ParentIndices[L] = FindNodeIndex(ParentIds[L]);
+		if (ParentIndices[L] == INDEX_NONE)
+		{
+			Adjacency.bDirty = true;
+			return;
+		}
+	}
+
+	int32 NodeIndex = AddNodeIndex(Metadata.SaveId);
+	for (int32 L = 0; L < 2; ++L)
+	{
+		AppendChild(L, ParentIndices[L], NodeIndex);
+	}
+}
+
+int32 UMSaveGame::AddNodeIndex(const FGuid& SaveId) const
+{
+	int32 NodeIndex = Adjacency.NodeIds.Add(SaveId);
+	if (SaveId.IsValid()) Adjacency.NodeIndices.Add(SaveId, NodeIndex);
+
+	for (int32 L = 0; L < 2; ++L)
+	{
+		Adjacency.FirstChild[L].Add(INDEX_NONE);
+		Adjacency.LastChild[L].Add(INDEX_NONE);
+		Adjacency.NextSibling[L].Add(INDEX_NONE);
+		Adjacency.NumChildren[L].Add(0);
+	}
+
+	return NodeIndex;
+}
+
+void UMSaveGame::AppendChild(int32 Lineage, int32 ParentIndex, int32 ChildIndex) const
+{
+	int32 LastChild = Adjacency.LastChild[Lineage][ParentIndex];
+	if (LastChild == INDEX_NONE) Adjacency.FirstChild[Lineage][ParentIndex] = ChildIndex;
+	else Adjacency.NextSibling[Lineage][LastChild] = ChildIndex;
+
+	Adjacency.LastChild[Lineage][ParentIndex] = ChildIndex;
+	++Adjacency.NumChildren[Lineage][ParentIndex];
+}
+
+int32 UMSaveGame::FindNodeIndex(const FGuid& SaveId) const
+{
+	if (!SaveId.IsValid()) return 0;
+
+	const int32* NodeIndex = Adjacency.NodeIndices.Find(SaveId);
+	return NodeIndex ? *NodeIndex : INDEX_NONE;
+}
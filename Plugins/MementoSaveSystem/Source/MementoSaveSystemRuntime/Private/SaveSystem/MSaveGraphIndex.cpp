@@ -0,0 +1,181 @@
+// Copyright © Bedrockbreaker 2025. MIT License
+
+#include "SaveSystem/MSaveGraphIndex.h"
+
+void FMSaveGraphIndex::Reset()
+{
+	NodeIndices.Reset();
+	NodeIds.Reset();
+
+	for (FLineage& Lineage : Lineages)
+	{
+		Lineage.Parents.Reset();
+		Lineage.Jumps.Reset();
+		Lineage.Depths.Reset();
+	}
+}
+
+bool FMSaveGraphIndex::AddNode(const FGuid& SaveNodeId, const TMap<FGuid, FMSaveNodeMetadata>& SaveNodes)
+{
+	return FindOrAddNode(SaveNodeId, SaveNodes) != INDEX_NONE;
+}
+
+FGuid FMSaveGraphIndex::GetNthAncestor(
+	const FGuid& SaveNodeId, int32 N, EMSaveLineage Lineage, const TMap<FGuid, FMSaveNodeMetadata>& SaveNodes)
+{
+	int32 Index = FindOrAddNode(SaveNodeId, SaveNodes);
+	if (Index == INDEX_NONE || N < 0) return FGuid();
+
+	const FLineage& Skips = Lineages[static_cast<uint8>(Lineage)];
+	if (N > Skips.Depths[Index]) return FGuid();
+
+	return NodeIds[GetAncestorAtDepth(Skips, Index, Skips.Depths[Index] - N)];
+}
+
+bool FMSaveGraphIndex::IsAncestor(
+	const FGuid&							AncestorId,
+	const FGuid&							SaveNodeId,
+	EMSaveLineage							Lineage,
+	const TMap<FGuid, FMSaveNodeMetadata>& SaveNodes)
+{
+	int32 AncestorIndex = FindOrAddNode(AncestorId, SaveNodes);
+	int32 Index = FindOrAddNode(SaveNodeId, SaveNodes);
+	if (AncestorIndex == INDEX_NONE || Index == INDEX_NONE) return false;
+
+	const FLineage& Skips = Lineages[static_cast<uint8>(Lineage)];
+	if (Skips.Depths[AncestorIndex] >= Skips.Depths[Index]) return false;
+
+	return GetAncestorAtDepth(Skips, Index, Skips.Depths[AncestorIndex]) == AncestorIndex;
+}
+
+FGuid FMSaveGraphIndex::FindCommonAncestor(
+	const FGuid&							A,
+	const FGuid&							B,
+	EMSaveLineage							Lineage,
+	const TMap<FGuid, FMSaveNodeMetadata>& SaveNodes)
+{
+	int32 IndexA = FindOrAddNode(A, SaveNodes);
+	int32 IndexB = FindOrAddNode(B, SaveNodes);
+	if (IndexA == INDEX_NONE || IndexB == INDEX_NONE) return FGuid();
+
+	const FLineage& Skips = Lineages[static_cast<uint8>(Lineage)];
+
+	// 1. Lift the deeper node to the depth of the other
+
+	int32 Depth = FMath::Min(Skips.Depths[IndexA], Skips.Depths[IndexB]);
+	IndexA = GetAncestorAtDepth(Skips, IndexA, Depth);
+	IndexB = GetAncestorAtDepth(Skips, IndexB, Depth);
+
+	// 2. Lift both in lockstep. Jump pointers only depend on depth, so both jumps always land at the same depth.
+
+	while (IndexA != IndexB)
+	{
+		// Nodes in different trees of the lineage (e.g. two roots) have no common ancestor
+		if (Skips.Depths[IndexA] == 0) return FGuid();
+
+		if (Skips.Jumps[IndexA] != Skips.Jumps[IndexB])
+		{
+			IndexA = Skips.Jumps[IndexA];
+			IndexB = Skips.Jumps[IndexB];
+		}
+		else
+		{
+			IndexA = Skips.Parents[IndexA];
+			IndexB = Skips.Parents[IndexB];
+		}
+	}
+
+	return NodeIds[IndexA];
+}
+
+int32 FMSaveGraphIndex::GetDepth(
+	const FGuid& SaveNodeId, EMSaveLineage Lineage, const TMap<FGuid, FMSaveNodeMetadata>& SaveNodes)
+{
+	int32 Index = FindOrAddNode(SaveNodeId, SaveNodes);
+	return Index != INDEX_NONE ? Lineages[static_cast<uint8>(Lineage)].Depths[Index] : INDEX_NONE;
+}
+
+int32 FMSaveGraphIndex::FindOrAddNode(const FGuid& SaveNodeId, const TMap<FGuid, FMSaveNodeMetadata>& SaveNodes)
+{
+	if (const int32* Index = NodeIndices.Find(SaveNodeId)) return *Index;
+	if (!SaveNodes.Contains(SaveNodeId)) return INDEX_NONE;
+
+	// Parents must be indexed before their children, so walk up to the indexed part of the graph without recursing
+	TArray<const FMSaveNodeMetadata*, TInlineAllocator<16>> Pending;
+	Pending.Add(&SaveNodes[SaveNodeId]);
+
+	while (!Pending.IsEmpty())
+	{
+		const FMSaveNodeMetadata* Metadata = Pending.Last();
+		if (NodeIndices.Contains(Metadata->SaveId))
+		{
+			Pending.Pop();
+			continue;
+		}
+
+		// Every push is a parent of the node below it, so only a cycle can grow the stack past twice the graph
+		bool bAcyclic = Pending.Num() <= SaveNodes.Num() * 2;
+		if (!ensureMsgf(bAcyclic, TEXT("Save graph has a cycle above %s"), *SaveNodeId.ToString())) return INDEX_NONE;
+
+		bool bParentsIndexed = true;
+		for (const FGuid& ParentId : { Metadata->BranchParentId, Metadata->SequenceParentId })
+		{
+			const FMSaveNodeMetadata* Parent = SaveNodes.Find(ParentId);
+			if (!Parent || NodeIndices.Contains(ParentId)) continue;
+
+			Pending.Add(Parent);
+			bParentsIndexed = false;
+		}
+
+		if (bParentsIndexed)
+		{
+			AppendNode(*Metadata);
+			Pending.Pop();
+		}
+	}
+
+	return NodeIndices[SaveNodeId];
+}
+
+void FMSaveGraphIndex::AppendNode(const FMSaveNodeMetadata& Metadata)
+{
+	int32 Index = NodeIds.Add(Metadata.SaveId);
+	NodeIndices.Add(Metadata.SaveId, Index);
+
+	const FGuid ParentIds[] = { Metadata.BranchParentId, Metadata.SequenceParentId };
+	for (int32 LineageIndex = 0; LineageIndex < UE_ARRAY_COUNT(Lineages); ++LineageIndex)
+	{
+		FLineage&	 Skips = Lineages[LineageIndex];
+		const int32* ParentIndex = NodeIndices.Find(ParentIds[LineageIndex]);
+
+		if (!ParentIndex)
+		{
+			Skips.Parents.Add(INDEX_NONE);
+			Skips.Jumps.Add(Index);
+			Skips.Depths.Add(0);
+			continue;
+		}
+
+		// If the parent's jump spans as many levels as its jump's jump, merge both into one twice as long
+		int32 Parent = *ParentIndex;
+		int32 ParentJump = Skips.Jumps[Parent];
+		int32 ParentJumpJump = Skips.Jumps[ParentJump];
+		bool  bMerge = Skips.Depths[Parent] - Skips.Depths[ParentJump]
+			== Skips.Depths[ParentJump] - Skips.Depths[ParentJumpJump];
+
+		Skips.Parents.Add(Parent);
+		Skips.Jumps.Add(bMerge ? ParentJumpJump : Parent);
+		Skips.Depths.Add(Skips.Depths[Parent] + 1);
+	}
+}
+
+int32 FMSaveGraphIndex::GetAncestorAtDepth(const FLineage& Lineage, int32 Index, int32 Depth)
+{
+	while (Lineage.Depths[Index] > Depth)
+	{
+		int32 Jump = Lineage.Jumps[Index];
+		Index = Lineage.Depths[Jump] >= Depth ? Jump : Lineage.Parents[Index];
+	}
+
+	return Index;
+}
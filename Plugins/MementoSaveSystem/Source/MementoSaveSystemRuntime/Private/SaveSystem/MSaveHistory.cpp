@@ -2,21 +2,123 @@
 
 #include "SaveSystem/MSaveHistory.h"
 
-#include "Kismet/GameplayStatics.h"
+#include "Algo/SortBy.h"
+#include "Async/Async.h"
 #include "SaveSystem/MSaveData.h"
 #include "SaveSystem/MSaveGame.h"
+#include "SaveSystem/MSaveManager.h"
 #include "SaveSystem/MSaveNode.h"
+#include "SaveSystem/MSaveSettings.h"
+#include "SaveSystem/MSaveStorage.h"
+
+namespace MSaveHistory
+{
+	/** Approximates the memory a save node holds on to. Mapped payloads only cost their views, not their pages. */
+	static int64 GetNodeMemorySize(const UMSaveNode& SaveNode)
+	{
+		int64 Size = sizeof(UMSaveNode) + SaveNode.SaveData.GetAllocatedSize();
+		for (const TTuple<FString, FMSaveData>& Entry : SaveNode.SaveData)
+		{
+			const FMSaveData& SaveData = Entry.Value;
+			Size += Entry.Key.GetAllocatedSize() + SaveData.ClassName.GetAllocatedSize();
+			Size += SaveData.Data.GetAllocatedSize() + SaveData.Chunks.GetAllocatedSize();
+			Size += SaveData.MappedChunks.GetAllocatedSize();
+		}
+
+		for (const FString& RemovedSaveId : SaveNode.RemovedSaveIds)
+		{
+			Size += RemovedSaveId.GetAllocatedSize();
+		}
+
+		return Size;
+	}
+
+	/** Returns the content hash of every saveable in a node's resolved save data */
+	static TMap<FString, FIoHash> GetContentHashes(const TMap<FString, FMSaveData>& SaveData)
+	{
+		TMap<FString, FIoHash> ContentHashes;
+		ContentHashes.Reserve(SaveData.Num());
+		for (const TTuple<FString, FMSaveData>& Entry : SaveData)
+		{
+			ContentHashes.Add(Entry.Key, Entry.Value.GetContentHash());
+		}
+
+		return ContentHashes;
+	}
+} // namespace MSaveHistory
 
 void UMSaveHistory::Initialize(UMSaveGame* InSaveGame)
 {
+	// Nodes are loaded on demand, so initializing never touches the disk
+	ResetCache();
+	GraphIndex.Reset();
+	++Generation;
+	bBackfillStarted = false;
+	bTimelineBackfilled = false;
+	NodesToBackfill.Reset();
+	NumToWarm = 0;
+	NumWarmed = 0;
+
 	SaveGame = InSaveGame;
 	if (SaveGame)
+		Storage = FMSaveStorage::Open(SaveGame->SlotName, SaveGame->UserIndex);
+	else
+		Storage.Reset();
+}
+
+void UMSaveHistory::AsyncInitialize(UMSaveGame* InSaveGame)
+{
+	Initialize(InSaveGame);
+	if (!SaveGame) return;
+
+	// Queries would start the backfill anyway, so get a head start on it
+	BackfillTimeline();
+
+	// 1. Gather the pinned nodes, along with the delta chains needed to resolve them
+
+	UpdatePinnedNodes();
+
+	TSet<FGuid> NodeIds;
+	for (const FGuid& PinnedNodeId : PinnedNodeIds)
 	{
-		LoadAllNodes();
+		for (FGuid SaveNodeId = PinnedNodeId; SaveNodeId.IsValid() && !NodeIds.Contains(SaveNodeId);)
+		{
+			const FMSaveNodeMetadata* Metadata = SaveGame->SaveNodes.Find(SaveNodeId);
+			if (!Metadata) break;
+
+			NodeIds.Add(SaveNodeId);
+			SaveNodeId = Metadata->DeltaBaseId;
+		}
 	}
-	else
+
+	NumToWarm = NodeIds.Num();
+	if (NumToWarm == 0) return;
+
+	UE_LOG(
+		LogMSaveManager,
+		Log,
+		TEXT("Warming save history - %s:%d (%d nodes)"),
+		*SaveGame->SlotName,
+		SaveGame->UserIndex,
+		NumToWarm);
+
+	// 2. Load them all on worker threads, caching each as it arrives
+
+	for (const FGuid& SaveNodeId : NodeIds)
 	{
-		SaveNodes.Reset();
+		Storage->AsyncLoadNode(
+			SaveNodeId,
+			[WeakThis = TWeakObjectPtr<UMSaveHistory>(this), SaveNodeId, WarmGeneration = Generation](
+				UMSaveNode* SaveNode) -> void {
+				UMSaveHistory* This = WeakThis.Get();
+				if (!This || This->Generation != WarmGeneration) return;
+
+				// A query may have loaded the node on the spot meanwhile
+				if (SaveNode && !This->SaveNodes.Contains(SaveNodeId)) This->AddToCache(SaveNode);
+
+				++This->NumWarmed;
+				This->OnProgress.Broadcast(This->NumWarmed, This->NumToWarm);
+			});
 	}
 }
 
@@ -28,52 +130,306 @@ bool UMSaveHistory::GetLastSaveState(const FString& SaveableId, FMSaveData& OutS
 bool UMSaveHistory::GetNthLastSaveState(const FString& SaveableId, int32 N, FMSaveData& OutSaveData) const
 {
 	checkf(N > 0, TEXT("N must be greater than 0."));
-	if (!SaveGame || SaveNodes.IsEmpty()) return false;
+	if (!SaveGame || !Storage) return false;
 
-	FGuid SaveNodeId = SaveGame->MostRecentNodeId;
+	FGuid SaveNodeId = GetNthAncestor(SaveGame->MostRecentNodeId, N, EMSaveLineage::Sequence);
 	if (!SaveNodeId.IsValid()) return false;
 
-	for (int32 Index = 0; Index < N; ++Index)
-	{
-		if (!SaveNodes.Contains(SaveNodeId)) return false;
-		SaveNodeId = SaveGame->SaveNodes[SaveNodeId].SequenceParentId;
-	}
-
-	UMSaveNode* SaveNode = SaveNodes.FindChecked(SaveNodeId);
-	if (!SaveNode->SaveData.Contains(SaveableId)) return false;
+	// Delta nodes only contain what changed, so the saveable's data may live further up the delta chain
+	const FMSaveData* SaveData =
+		FMSaveStorage::FindSaveData(SaveNodeId, SaveableId, [this](const FGuid& NodeId) -> UMSaveNode* {
+			return GetSaveNode(NodeId);
+		});
+	if (!SaveData) return false;
 
-	OutSaveData = SaveNode->SaveData[SaveableId];
+	// The caller owns the returned data, so it must not depend on the blob store staying mapped
+	OutSaveData = *SaveData;
+	OutSaveData.LoadMappedPayload();
 	return true;
 }
 
 bool UMSaveHistory::GetAllSaveStates(const FString& SaveableId, TArray<FMSaveData>& OutSaveData) const
 {
-	return false;
+	OutSaveData.Reset();
+	if (!SaveGame || !Storage) return false;
+
+	BackfillTimeline();
+
+	TArray<FMSaveTimelineEntry> Entries = Storage->GetTimeline().GetEntries(SaveableId);
+	if (Entries.IsEmpty()) return false;
+
+	// The timeline knows which nodes hold each state, so only those are ever loaded
+	for (const FMSaveTimelineEntry& Entry : Entries)
+	{
+		if (Entry.IsRemoval()) continue;
+
+		const FMSaveData* SaveData = FMSaveStorage::FindSaveData(
+			Entry.NodeId, SaveableId, [this](const FGuid& NodeId) -> UMSaveNode* { return GetSaveNode(NodeId); });
+		if (!SaveData) continue;
+
+		// The caller owns the returned data, so it must not depend on the blob store staying mapped
+		FMSaveData& State = OutSaveData.Add_GetRef(*SaveData);
+		State.LoadMappedPayload();
+	}
+
+	return true;
 }
 
 int32 UMSaveHistory::GetDistinctStateCount(const FString& SaveableId) const
 {
-	return 0;
+	if (!SaveGame || !Storage) return 0;
+
+	BackfillTimeline();
+	return Storage->GetTimeline().GetDistinctStateCount(SaveableId);
+}
+
+FGuid UMSaveHistory::GetNthAncestor(const FGuid& SaveNodeId, int32 N, EMSaveLineage Lineage) const
+{
+	if (!SaveGame) return FGuid();
+
+	return GraphIndex.GetNthAncestor(SaveNodeId, N, Lineage, SaveGame->SaveNodes);
+}
+
+bool UMSaveHistory::IsAncestor(const FGuid& AncestorId, const FGuid& SaveNodeId, EMSaveLineage Lineage) const
+{
+	if (!SaveGame) return false;
+
+	return GraphIndex.IsAncestor(AncestorId, SaveNodeId, Lineage, SaveGame->SaveNodes);
+}
+
+FGuid UMSaveHistory::FindCommonAncestor(const FGuid& A, const FGuid& B, EMSaveLineage Lineage) const
+{
+	if (!SaveGame) return FGuid();
+
+	return GraphIndex.FindCommonAncestor(A, B, Lineage, SaveGame->SaveNodes);
 }
 
 int32 UMSaveHistory::GetBranchChildrenCount(const FGuid& SaveNodeId) const
 {
-	return 0;
+	return SaveGame ? SaveGame->GetNumChildren(SaveNodeId, EMSaveLineage::Branch) : 0;
+}
+
+void UMSaveHistory::CacheSaveNode(UMSaveNode* SaveNode)
+{
+	if (!SaveGame || !SaveNode) return;
+
+	GraphIndex.AddNode(SaveNode->SaveId, SaveGame->SaveNodes);
+	AddToCache(SaveNode);
+}
+
+void UMSaveHistory::AddReferencedObjects(UObject* InThis, FReferenceCollector& Collector)
+{
+	Super::AddReferencedObjects(InThis, Collector);
+
+	UMSaveHistory* This = CastChecked<UMSaveHistory>(InThis);
+	for (TTuple<FGuid, FCachedNode>& CachedNode : This->SaveNodes)
+	{
+		Collector.AddReferencedObject(CachedNode.Value.SaveNode, This);
+	}
+}
+
+UMSaveNode* UMSaveHistory::GetSaveNode(const FGuid& SaveNodeId) const
+{
+	if (FCachedNode* CachedNode = SaveNodes.Find(SaveNodeId))
+	{
+		// Move to the front of the LRU list
+		LruList.RemoveNode(CachedNode->LruNode, /* bDeleteNode = */ false);
+		LruList.AddHead(CachedNode->LruNode);
+		return CachedNode->SaveNode;
+	}
+
+	if (!Storage || !SaveGame->SaveNodes.Contains(SaveNodeId)) return nullptr;
+
+	UMSaveNode* SaveNode = Storage->LoadNode(SaveNodeId);
+	if (!SaveNode)
+	{
+		UE_LOG(LogMSaveManager, Warning, TEXT("Failed to load save node for history - %s"), *SaveNodeId.ToString());
+		return nullptr;
+	}
+
+	AddToCache(SaveNode);
+	return SaveNode;
+}
+
+void UMSaveHistory::AddToCache(UMSaveNode* SaveNode) const
+{
+	// A node which is cached again (e.g. after being rewritten) replaces the previous one
+	FCachedNode& CachedNode = SaveNodes.FindOrAdd(SaveNode->SaveId);
+	if (CachedNode.LruNode)
+	{
+		CacheSize -= CachedNode.Size;
+		LruList.RemoveNode(CachedNode.LruNode, /* bDeleteNode = */ false);
+		LruList.AddHead(CachedNode.LruNode);
+	}
+	else
+	{
+		LruList.AddHead(SaveNode->SaveId);
+		CachedNode.LruNode = LruList.GetHead();
+	}
+
+	CachedNode.SaveNode = SaveNode;
+	CachedNode.Size = MSaveHistory::GetNodeMemorySize(*SaveNode);
+	CacheSize += CachedNode.Size;
+
+	EvictNodes();
 }
 
-void UMSaveHistory::LoadAllNodes()
+void UMSaveHistory::EvictNodes() const
+{
+	const int64 Budget = static_cast<int64>(GetDefault<UMSaveSettings>()->HistoryCacheBudgetMB) * 1024 * 1024;
+	if (CacheSize <= Budget) return;
+
+	UpdatePinnedNodes();
+
+	// Walk from the least recently used node, skipping over pinned ones. The most recently used node always stays.
+	TDoubleLinkedList<FGuid>::TDoubleLinkedListNode* LruNode = LruList.GetTail();
+	while (CacheSize > Budget && LruNode && LruNode != LruList.GetHead())
+	{
+		TDoubleLinkedList<FGuid>::TDoubleLinkedListNode* PrevNode = LruNode->GetPrevNode();
+		const FGuid&									 SaveNodeId = LruNode->GetValue();
+
+		if (!PinnedNodeIds.Contains(SaveNodeId))
+		{
+			CacheSize -= SaveNodes.FindChecked(SaveNodeId).Size;
+			SaveNodes.Remove(SaveNodeId);
+			LruList.RemoveNode(LruNode);
+		}
+
+		LruNode = PrevNode;
+	}
+}
+
+void UMSaveHistory::ResetCache()
 {
 	SaveNodes.Reset();
+	LruList.Empty();
+	CacheSize = 0;
+	PinnedNodeIds.Reset();
+	PinnedForNodeId.Invalidate();
+}
 
-	if (!SaveGame) return;
+void UMSaveHistory::UpdatePinnedNodes() const
+{
+	if (!SaveGame || PinnedForNodeId == SaveGame->MostRecentNodeId) return;
+
+	PinnedForNodeId = SaveGame->MostRecentNodeId;
+	PinnedNodeIds.Reset();
+
+	// The most recent node itself, plus its nearest sequence ancestors
+	int32 NumPinned = GetDefault<UMSaveSettings>()->HistoryPinnedAncestors + 1;
+	for (FGuid SaveNodeId = PinnedForNodeId; SaveNodeId.IsValid() && PinnedNodeIds.Num() < NumPinned;)
+	{
+		const FMSaveNodeMetadata* Metadata = SaveGame->SaveNodes.Find(SaveNodeId);
+		if (!Metadata) break;
+
+		PinnedNodeIds.Add(SaveNodeId);
+		SaveNodeId = Metadata->SequenceParentId;
+	}
+}
+
+void UMSaveHistory::BackfillTimeline() const
+{
+	if (bBackfillStarted || !SaveGame || !Storage) return;
+	bBackfillStarted = true;
+
+	FMSaveTimeline& Timeline = Storage->GetTimeline();
 
+	TArray<const FMSaveNodeMetadata*> MissingNodes;
 	for (const TTuple<FGuid, FMSaveNodeMetadata>& Node : SaveGame->SaveNodes)
 	{
-		FString		SlotName = SaveGame->SlotName + Node.Key.ToString();
-		UMSaveNode* SaveNode = Cast<UMSaveNode>(UGameplayStatics::LoadGameFromSlot(SlotName, SaveGame->UserIndex));
+		if (!Timeline.Contains(Node.Key)) MissingNodes.Add(&Node.Value);
+	}
+
+	if (MissingNodes.IsEmpty())
+	{
+		bTimelineBackfilled = true;
+		return;
+	}
 
-		if (!SaveNode) continue;
+	UE_LOG(
+		LogMSaveManager,
+		Log,
+		TEXT("Backfilling timeline - %s:%d (%d nodes)"),
+		*SaveGame->SlotName,
+		SaveGame->UserIndex,
+		MissingNodes.Num());
 
-		SaveNodes.Add(Node.Key, SaveNode);
+	// Nodes are recorded in the order they were created, like they would have been when committed
+	Algo::SortBy(MissingNodes, [](const FMSaveNodeMetadata* Metadata) { return Metadata->Timestamp; });
+
+	NodesToBackfill.Reserve(MissingNodes.Num());
+	for (int32 Index = MissingNodes.Num() - 1; Index >= 0; --Index)
+	{
+		NodesToBackfill.Add(MissingNodes[Index]->SaveId);
 	}
+
+	BackfillNextNode();
+}
+
+void UMSaveHistory::BackfillNextNode() const
+{
+	check(IsInGameThread());
+
+	// 1. Find the next node which still needs to be recorded (e.g. it may have been removed by a compaction meanwhile)
+
+	const FMSaveNodeMetadata* Metadata = nullptr;
+	while (!Metadata && !NodesToBackfill.IsEmpty())
+	{
+		FGuid SaveNodeId = NodesToBackfill.Pop();
+		Metadata = SaveGame->SaveNodes.Find(SaveNodeId);
+		if (Metadata && Storage->GetTimeline().Contains(SaveNodeId)) Metadata = nullptr;
+	}
+
+	if (!Metadata)
+	{
+		UE_LOG(LogMSaveManager, Log, TEXT("Backfilled timeline - %s:%d"), *SaveGame->SlotName, SaveGame->UserIndex);
+		bTimelineBackfilled = true;
+		return;
+	}
+
+	// 2. Resolve it along with its delta chain on a worker thread
+
+	TArray<FGuid> DeltaChain;
+	for (FGuid SaveNodeId = Metadata->SaveId; SaveNodeId.IsValid() && !DeltaChain.Contains(SaveNodeId);)
+	{
+		const FMSaveNodeMetadata* ChainMetadata = SaveGame->SaveNodes.Find(SaveNodeId);
+		if (!ChainMetadata) break;
+
+		DeltaChain.Add(SaveNodeId);
+		SaveNodeId = ChainMetadata->DeltaBaseId;
+	}
+
+	UMSaveNode*					SaveNode = nullptr;
+	FMSaveStorage::FResolveTask ResolveTask = Storage->LaunchResolveNode(DeltaChain, nullptr, SaveNode);
+
+	// 3. Record it on the worker thread as well, then move on to the next node
+
+	UE::Tasks::Launch(
+		UE_SOURCE_LOCATION,
+		[WeakThis = TWeakObjectPtr<const UMSaveHistory>(this),
+		 BackfillGeneration = Generation,
+		 SlotStorage = Storage,
+		 SaveNodeId = Metadata->SaveId,
+		 ResolveTask]() mutable -> void {
+			TSharedPtr<const TMap<FString, FMSaveData>> SaveData = ResolveTask.GetResult();
+			if (SaveData) SlotStorage->GetTimeline().Append(SaveNodeId, MSaveHistory::GetContentHashes(*SaveData));
+
+			AsyncTask(
+				ENamedThreads::GameThread,
+				[WeakThis, BackfillGeneration, SaveNodeId, bResolved = SaveData.IsValid()]() -> void {
+					const UMSaveHistory* This = WeakThis.Get();
+					if (!This || This->Generation != BackfillGeneration) return;
+
+					// Chains holding legacy nodes can only be decoded on the game thread
+					TMap<FString, FMSaveData> LegacySaveData;
+					auto GetNode = [This](const FGuid& NodeId) -> UMSaveNode* { return This->GetSaveNode(NodeId); };
+					if (!bResolved && FMSaveStorage::ResolveSaveData(SaveNodeId, GetNode, LegacySaveData))
+					{
+						This->Storage->GetTimeline().Append(SaveNodeId, MSaveHistory::GetContentHashes(LegacySaveData));
+					}
+
+					This->BackfillNextNode();
+				});
+		},
+		UE::Tasks::Prerequisites(ResolveTask));
 }
@@ -0,0 +1,44 @@
+// Copyright © Bedrockbreaker 2025. MIT License
+
+#include "SaveSystem/MSaveIndex.h"
+
+FMSlotSummary& UMSaveIndex::AddSlot(const FMSlotId& SlotId)
+{
+	FMSlotSummary& Summary = Slots.Add(SlotId);
+	Summary.SlotId = SlotId;
+	return Summary;
+}
+
+bool UMSaveIndex::RemoveSlot(const FMSlotId& SlotId)
+{
+	return Slots.Remove(SlotId) > 0;
+}
+
+TArray<FMSlotId> UMSaveIndex::GetSlotIds() const
+{
+	TArray<FMSlotId> SlotIds;
+	Slots.GenerateKeyArray(SlotIds);
+	return SlotIds;
+}
+
+TArray<FMSlotSummary> UMSaveIndex::GetSlotSummaries() const
+{
+	TArray<FMSlotSummary> Summaries;
+	Slots.GenerateValueArray(Summaries);
+	return Summaries;
+}
+
+void UMSaveIndex::Serialize(FArchive& Ar)
+{
+	Super::Serialize(Ar);
+
+	if (!Ar.IsLoading() || SaveSlots.IsEmpty()) return;
+
+	// Their summaries are filled in as each slot is loaded again
+	for (const FMSlotId& SlotId : SaveSlots)
+	{
+		if (!Slots.Contains(SlotId)) AddSlot(SlotId);
+	}
+
+	SaveSlots.Empty();
+}
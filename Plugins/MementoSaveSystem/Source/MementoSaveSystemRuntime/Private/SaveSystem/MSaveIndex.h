@@ -3,19 +3,43 @@
 #pragma once
 
 #include "GameFramework/SaveGame.h"
+#include "SaveSystem/MSlotId.h"
+#include "SaveSystem/MSlotSummary.h"
 
 #include "MSaveIndex.generated.h"
 
-struct FMSlotId;
-
-/** A list of all known save slots */
+/** The index of all known save slots, along with a summary of each */
 UCLASS()
 class UMSaveIndex : public USaveGame
 {
 	GENERATED_BODY()
 
 public:
+	/** Adds a slot, or resets the summary of an existing one. Returns the slot's summary. */
+	FMSlotSummary& AddSlot(const FMSlotId& SlotId);
+
+	/** Removes a slot. Returns whether it was in the index. */
+	bool RemoveSlot(const FMSlotId& SlotId);
+
+	/** Returns the summary of a slot (null if the slot is not in the index) */
+	FMSlotSummary*		 FindSlot(const FMSlotId& SlotId) { return Slots.Find(SlotId); }
+	const FMSlotSummary* FindSlot(const FMSlotId& SlotId) const { return Slots.Find(SlotId); }
+
+	/** Returns the id of every slot */
+	TArray<FMSlotId> GetSlotIds() const;
+
+	/** Returns the summary of every slot */
+	TArray<FMSlotSummary> GetSlotSummaries() const;
+
+	/** Moves slots of an index saved before slots had summaries into Slots */
+	virtual void Serialize(FArchive& Ar) override;
+
+private:
+	/** Every slot by id, with its summary */
+	UPROPERTY()
+	TMap<FMSlotId, FMSlotSummary> Slots;
+
+	/** The slots of an index saved before slots had summaries. Empty once loaded. */
 	UPROPERTY()
-	/** A list of all save slots */
 	TArray<FMSlotId> SaveSlots;
 };
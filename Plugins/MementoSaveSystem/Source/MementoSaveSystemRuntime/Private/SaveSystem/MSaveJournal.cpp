@@ -0,0 +1,429 @@
+// Copyright © Bedrockbreaker 2025. MIT License
+
+#include "SaveSystem/MSaveJournal.h"
+
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/Crc.h"
+#include "Misc/Paths.h"
+#include "SaveSystem/MSaveGame.h"
+#include "SaveSystem/MSaveManager.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+namespace MSaveJournal
+{
+	/** Identifies a journal file */
+	constexpr uint32 FileMagic = 0x4C4E4A4D; // "MJNL"
+
+	/** Bumped whenever the file layout (or the layout of an op) changes */
+	constexpr uint32 FileVersion = 1;
+
+	/** Size of the file header (magic + version) */
+	constexpr int64 FileHeaderSize = sizeof(uint32) * 2;
+
+	/** Starts every record */
+	constexpr uint32 RecordMagic = 0x43524A4D; // "MJRC"
+
+	/** Size of a record header (magic + sequence + payload size + payload crc) */
+	constexpr int64 RecordHeaderSize = sizeof(uint32) + sizeof(int64) + sizeof(uint32) + sizeof(uint32);
+
+	/** Returns the path a journal is rewritten to before replacing the original */
+	static FString GetTempPath(const FString& FilePath)
+	{
+		return FilePath + TEXT(".tmp");
+	}
+
+	/** Returns the encoded file header */
+	static TArray<uint8> MakeHeader()
+	{
+		TArray<uint8> Header;
+		FMemoryWriter Writer(Header);
+		uint32		  Magic = FileMagic;
+		uint32		  Version = FileVersion;
+		Writer << Magic;
+		Writer << Version;
+		return Header;
+	}
+} // namespace MSaveJournal
+
+FMSaveJournalOp FMSaveJournalOp::NodeAdded(const FMSaveNodeMetadata& InMetadata)
+{
+	FMSaveJournalOp Op;
+	Op.Type = EMSaveJournalOp::NodeAdded;
+	Op.Metadata = InMetadata;
+	return Op;
+}
+
+FMSaveJournalOp FMSaveJournalOp::MostRecentChanged(const FGuid& InNodeId)
+{
+	FMSaveJournalOp Op;
+	Op.Type = EMSaveJournalOp::MostRecentChanged;
+	Op.NodeId = InNodeId;
+	return Op;
+}
+
+FMSaveJournalOp FMSaveJournalOp::CompressionChanged(EMSaveCompression InCompression)
+{
+	FMSaveJournalOp Op;
+	Op.Type = EMSaveJournalOp::CompressionChanged;
+	Op.Compression = InCompression;
+	return Op;
+}
+
+FMSaveJournalOp FMSaveJournalOp::NodeRemoved(const FGuid& InNodeId)
+{
+	FMSaveJournalOp Op;
+	Op.Type = EMSaveJournalOp::NodeRemoved;
+	Op.NodeId = InNodeId;
+	return Op;
+}
+
+FMSaveJournalOp FMSaveJournalOp::NodeUpdated(const FMSaveNodeMetadata& InMetadata)
+{
+	FMSaveJournalOp Op;
+	Op.Type = EMSaveJournalOp::NodeUpdated;
+	Op.Metadata = InMetadata;
+	return Op;
+}
+
+void FMSaveJournalOp::ApplyTo(UMSaveGame& SaveGame) const
+{
+	switch (Type)
+	{
+		case EMSaveJournalOp::NodeAdded:
+		case EMSaveJournalOp::NodeUpdated:
+			SaveGame.AddSaveNode(Metadata);
+			break;
+		case EMSaveJournalOp::MostRecentChanged:
+			SaveGame.MostRecentNodeId = NodeId;
+			break;
+		case EMSaveJournalOp::CompressionChanged:
+			SaveGame.Compression = Compression;
+			break;
+		case EMSaveJournalOp::NodeRemoved:
+			SaveGame.RemoveSaveNode(NodeId);
+			break;
+	}
+}
+
+FArchive& operator<<(FArchive& Ar, FMSaveJournalOp& Op)
+{
+	Ar << Op.Type;
+
+	switch (Op.Type)
+	{
+		case EMSaveJournalOp::NodeAdded:
+		case EMSaveJournalOp::NodeUpdated:
+			Ar << Op.Metadata.SaveId;
+			Ar << Op.Metadata.BranchParentId;
+			Ar << Op.Metadata.SequenceParentId;
+			Ar << Op.Metadata.Timestamp;
+			Ar << Op.Metadata.bInvisible;
+			Ar << Op.Metadata.DeltaBaseId;
+			Ar << Op.Metadata.DeltaDepth;
+			break;
+		case EMSaveJournalOp::MostRecentChanged:
+		case EMSaveJournalOp::NodeRemoved:
+			Ar << Op.NodeId;
+			break;
+		case EMSaveJournalOp::CompressionChanged:
+			Ar << Op.Compression;
+			break;
+		default:
+			Ar.SetError();
+			break;
+	}
+
+	return Ar;
+}
+
+FMSaveJournal::FMSaveJournal(const FString& InFilePath) : FilePath(InFilePath) {}
+
+FMSaveJournal::~FMSaveJournal()
+{
+	Close();
+}
+
+bool FMSaveJournal::Append(TConstArrayView<FMSaveJournalOp> Ops)
+{
+	FScopeLock ScopeLock(&Lock);
+	if (!OpenLocked()) return false;
+
+	TArray<uint8> Record;
+	EncodeRecord(LastSequence + 1, Ops, Record);
+
+	if (!FileHandle->Seek(EndOffset) || !FileHandle->Write(Record.GetData(), Record.Num()) || !FileHandle->Flush())
+	{
+		UE_LOG(LogMSaveManager, Warning, TEXT("Failed to append to journal %s"), *FilePath);
+		return false;
+	}
+
+	EndOffset += Record.Num();
+	LastSequence += 1;
+	NumRecords += 1;
+	return true;
+}
+
+bool FMSaveJournal::Replay(UMSaveGame& SaveGame)
+{
+	FScopeLock ScopeLock(&Lock);
+	if (!OpenLocked()) return false;
+
+	TArray<FRecord> Records;
+	if (!ReadRecordsLocked(&Records)) return false;
+
+	int32 NumReplayed = 0;
+	for (const FRecord& Record : Records)
+	{
+		if (Record.Sequence <= SaveGame.JournalSequence) continue;
+
+		for (const FMSaveJournalOp& Op : Record.Ops)
+		{
+			Op.ApplyTo(SaveGame);
+		}
+
+		SaveGame.JournalSequence = Record.Sequence;
+		++NumReplayed;
+	}
+
+	// New records must sort after everything the checkpoint already contains, even if the journal was reset
+	LastSequence = FMath::Max(LastSequence, SaveGame.JournalSequence);
+
+	if (NumReplayed > 0)
+	{
+		UE_LOG(
+			LogMSaveManager,
+			Log,
+			TEXT("Replayed %d journal records - %s:%d"),
+			NumReplayed,
+			*SaveGame.SlotName,
+			SaveGame.UserIndex);
+	}
+
+	return true;
+}
+
+bool FMSaveJournal::Truncate(int64 Sequence)
+{
+	using namespace MSaveJournal;
+
+	FScopeLock ScopeLock(&Lock);
+	if (!OpenLocked()) return false;
+
+	TArray<FRecord> Records;
+	if (!ReadRecordsLocked(&Records)) return false;
+
+	// 1. Rewrite the records newer than the checkpoint into a temporary file
+
+	TArray<uint8> Bytes = MakeHeader();
+	int32		  NumKept = 0;
+	for (const FRecord& Record : Records)
+	{
+		if (Record.Sequence <= Sequence) continue;
+
+		TArray<uint8> RecordBytes;
+		EncodeRecord(Record.Sequence, Record.Ops, RecordBytes);
+		Bytes.Append(RecordBytes);
+		++NumKept;
+	}
+
+	FString		  TempPath = GetTempPath(FilePath);
+	IFileManager& FileManager = IFileManager::Get();
+
+	TUniquePtr<FArchive> TempWriter(FileManager.CreateFileWriter(*TempPath));
+	if (!TempWriter) return false;
+
+	TempWriter->Serialize(Bytes.GetData(), Bytes.Num());
+	if (!TempWriter->Close()) return false;
+	TempWriter.Reset();
+
+	// 2. Swap it in. If this is interrupted, the temporary file is picked up again when the journal is next opened.
+
+	FileHandle.Reset();
+	if (!FileManager.Move(*FilePath, *TempPath, /* bReplace = */ true))
+	{
+		UE_LOG(LogMSaveManager, Warning, TEXT("Failed to compact journal %s"), *FilePath);
+		return false;
+	}
+
+	return OpenLocked() && NumRecords == NumKept;
+}
+
+int64 FMSaveJournal::GetLastSequence()
+{
+	FScopeLock ScopeLock(&Lock);
+	OpenLocked();
+	return LastSequence;
+}
+
+int32 FMSaveJournal::GetNumRecords()
+{
+	FScopeLock ScopeLock(&Lock);
+	OpenLocked();
+	return NumRecords;
+}
+
+void FMSaveJournal::Close()
+{
+	FScopeLock ScopeLock(&Lock);
+	FileHandle.Reset();
+	EndOffset = 0;
+	NumRecords = 0;
+
+	// LastSequence is intentionally kept, so sequences never go backwards while this journal is alive
+}
+
+bool FMSaveJournal::OpenLocked()
+{
+	using namespace MSaveJournal;
+
+	if (FileHandle) return true;
+
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	PlatformFile.CreateDirectoryTree(*FPaths::GetPath(FilePath));
+
+	// 1. Recover from an interrupted compaction. A temporary file next to an intact journal is incomplete.
+
+	FString TempPath = GetTempPath(FilePath);
+	if (PlatformFile.FileExists(*TempPath))
+	{
+		if (PlatformFile.FileExists(*FilePath))
+			PlatformFile.DeleteFile(*TempPath);
+		else
+			PlatformFile.MoveFile(*FilePath, *TempPath);
+	}
+
+	FileHandle.Reset(PlatformFile.OpenWrite(*FilePath, /* bAppend = */ true, /* bAllowRead = */ true));
+	if (!FileHandle)
+	{
+		UE_LOG(LogMSaveManager, Warning, TEXT("Failed to open journal %s"), *FilePath);
+		return false;
+	}
+
+	// 2. Write the header for new journals, or validate the existing records
+
+	if (FileHandle->Size() < FileHeaderSize)
+	{
+		TArray<uint8> Header = MakeHeader();
+		if (!FileHandle->Seek(0) || !FileHandle->Write(Header.GetData(), Header.Num()))
+		{
+			FileHandle.Reset();
+			return false;
+		}
+
+		EndOffset = FileHeaderSize;
+		NumRecords = 0;
+		return true;
+	}
+
+	if (!ReadRecordsLocked(nullptr))
+	{
+		FileHandle.Reset();
+		return false;
+	}
+
+	return true;
+}
+
+bool FMSaveJournal::ReadRecordsLocked(TArray<FRecord>* OutRecords)
+{
+	using namespace MSaveJournal;
+
+	int64		  FileSize = FileHandle->Size();
+	TArray<uint8> Bytes;
+	Bytes.SetNumUninitialized(static_cast<int32>(FileSize));
+	if (!FileHandle->Seek(0) || !FileHandle->Read(Bytes.GetData(), FileSize)) return false;
+
+	FMemoryReader Reader(Bytes);
+	uint32		  Magic = 0;
+	uint32		  Version = 0;
+	Reader << Magic;
+	Reader << Version;
+
+	if (Magic != FileMagic || Version != FileVersion)
+	{
+		UE_LOG(LogMSaveManager, Warning, TEXT("Journal %s has an unknown format"), *FilePath);
+		return false;
+	}
+
+	EndOffset = FileHeaderSize;
+	NumRecords = 0;
+
+	while (EndOffset + RecordHeaderSize <= FileSize)
+	{
+		Reader.Seek(EndOffset);
+
+		int64  Sequence = 0;
+		uint32 PayloadSize = 0;
+		uint32 PayloadCrc = 0;
+		Reader << Magic;
+		Reader << Sequence;
+		Reader << PayloadSize;
+		Reader << PayloadCrc;
+
+		int64 RecordEnd = EndOffset + RecordHeaderSize + PayloadSize;
+		if (Magic != RecordMagic || RecordEnd > FileSize) break;
+
+		const uint8* Payload = Bytes.GetData() + EndOffset + RecordHeaderSize;
+		if (FCrc::MemCrc32(Payload, PayloadSize) != PayloadCrc) break;
+
+		if (OutRecords)
+		{
+			FMemoryReaderView PayloadReader(MakeArrayView(Payload, PayloadSize));
+			FRecord&		  Record = OutRecords->AddDefaulted_GetRef();
+			Record.Sequence = Sequence;
+			PayloadReader << Record.Ops;
+
+			if (PayloadReader.IsError())
+			{
+				OutRecords->Pop();
+				break;
+			}
+		}
+
+		LastSequence = FMath::Max(LastSequence, Sequence);
+		EndOffset = RecordEnd;
+		++NumRecords;
+	}
+
+	// A torn record (e.g. from a crash) is discarded as a whole, along with anything after it
+	if (EndOffset != FileSize)
+	{
+		UE_LOG(
+			LogMSaveManager,
+			Warning,
+			TEXT("Journal %s has %lld trailing bytes, discarding them"),
+			*FilePath,
+			FileSize - EndOffset);
+		FileHandle->Truncate(EndOffset);
+	}
+
+	return true;
+}
+
+void FMSaveJournal::EncodeRecord(int64 Sequence, TConstArrayView<FMSaveJournalOp> Ops, TArray<uint8>& OutBytes)
+{
+	using namespace MSaveJournal;
+
+	TArray<uint8> Payload;
+	FMemoryWriter PayloadWriter(Payload);
+	int32		  NumOps = Ops.Num();
+	PayloadWriter << NumOps;
+	for (const FMSaveJournalOp& Op : Ops)
+	{
+		// Saving never modifies the op, the archive API just isn't const
+		PayloadWriter << const_cast<FMSaveJournalOp&>(Op);
+	}
+
+	OutBytes.Reset(RecordHeaderSize + Payload.Num());
+	FMemoryWriter Writer(OutBytes);
+	uint32		  Magic = RecordMagic;
+	uint32		  PayloadSize = Payload.Num();
+	uint32		  PayloadCrc = FCrc::MemCrc32(Payload.GetData(), Payload.Num());
+	Writer << Magic;
+	Writer << Sequence;
+	Writer << PayloadSize;
+	Writer << PayloadCrc;
+	Writer.Serialize(Payload.GetData(), Payload.Num());
+}
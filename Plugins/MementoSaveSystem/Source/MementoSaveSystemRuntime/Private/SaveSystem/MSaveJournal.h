@@ -0,0 +1,123 @@
+// Copyright © Bedrockbreaker 2025. MIT License
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include "SaveSystem/MSaveCompression.h"
+#include "SaveSystem/MSaveNodeMetadata.h"
+
+class IFileHandle;
+class UMSaveGame;
+
+/** The kinds of change a slot's metadata journal records */
+enum class EMSaveJournalOp : uint8
+{
+	/** A save node was added to the save graph */
+	NodeAdded = 0,
+
+	/** The most recent save node changed */
+	MostRecentChanged = 1,
+
+	/** The codec new save data is compressed with changed */
+	CompressionChanged = 2,
+
+	/** A save node was removed from the save graph, by compaction */
+	NodeRemoved = 3,
+
+	/** A save node's parents or delta base were rewritten, by compaction */
+	NodeUpdated = 4,
+};
+
+/** A single change to a slot's metadata */
+struct FMSaveJournalOp
+{
+	EMSaveJournalOp Type = EMSaveJournalOp::NodeAdded;
+
+	/** The added node's metadata, for NodeAdded, or its new metadata, for NodeUpdated */
+	FMSaveNodeMetadata Metadata;
+
+	/** The new most recent node, for MostRecentChanged, or the removed node, for NodeRemoved */
+	FGuid NodeId;
+
+	/** The new codec, for CompressionChanged */
+	EMSaveCompression Compression = EMSaveCompression::None;
+
+	static FMSaveJournalOp NodeAdded(const FMSaveNodeMetadata& InMetadata);
+	static FMSaveJournalOp MostRecentChanged(const FGuid& InNodeId);
+	static FMSaveJournalOp CompressionChanged(EMSaveCompression InCompression);
+	static FMSaveJournalOp NodeRemoved(const FGuid& InNodeId);
+	static FMSaveJournalOp NodeUpdated(const FMSaveNodeMetadata& InMetadata);
+
+	/** Applies this change to a slot */
+	void ApplyTo(UMSaveGame& SaveGame) const;
+
+	friend FArchive& operator<<(FArchive& Ar, FMSaveJournalOp& Op);
+};
+
+/**
+ * Per-slot write-ahead journal of metadata changes, on top of the checkpoint stored in the slot's UMSaveGame.
+ *
+ * Every record holds one or more ops, and is checksummed so a torn record is discarded as a whole.
+ * Records carry increasing sequence numbers. The checkpoint remembers the last sequence it contains, so replaying only
+ * applies newer records, and the journal can be truncated once a checkpoint has been written. Thread-safe.
+ */
+class FMSaveJournal
+{
+public:
+	explicit FMSaveJournal(const FString& InFilePath);
+	~FMSaveJournal();
+
+	/** Appends ops as a single atomic record, and flushes it to disk */
+	bool Append(TConstArrayView<FMSaveJournalOp> Ops);
+
+	/** Applies every record newer than the slot's checkpoint to it */
+	bool Replay(UMSaveGame& SaveGame);
+
+	/** Drops every record up to and including a sequence, once a checkpoint containing them has been written */
+	bool Truncate(int64 Sequence);
+
+	/** The sequence of the last record appended (0 if none) */
+	int64 GetLastSequence();
+
+	/** The number of records in the journal */
+	int32 GetNumRecords();
+
+	/** Closes the underlying file, so it can be moved or deleted. The journal reopens it on next use. */
+	void Close();
+
+private:
+	/** A record read back from the journal file */
+	struct FRecord
+	{
+		int64					Sequence = 0;
+		TArray<FMSaveJournalOp> Ops;
+	};
+
+	/** The path of the journal file */
+	FString FilePath;
+
+	/** Read/write handle to the journal file, opened lazily */
+	TUniquePtr<IFileHandle> FileHandle;
+
+	/** The offset one past the last valid record */
+	int64 EndOffset = 0;
+
+	/** The sequence of the last record */
+	int64 LastSequence = 0;
+
+	/** The number of valid records */
+	int32 NumRecords = 0;
+
+	/** Guards all file access */
+	FCriticalSection Lock;
+
+	/** Opens the journal file and validates its records, if not already open */
+	bool OpenLocked();
+
+	/** Reads every valid record, discarding anything past the last valid one */
+	bool ReadRecordsLocked(TArray<FRecord>* OutRecords);
+
+	/** Encodes a record, including its header */
+	static void EncodeRecord(int64 Sequence, TConstArrayView<FMSaveJournalOp> Ops, TArray<uint8>& OutBytes);
+};
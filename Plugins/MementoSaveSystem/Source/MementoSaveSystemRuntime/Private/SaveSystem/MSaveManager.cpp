@@ -2,7 +2,16 @@
 
 #include "SaveSystem/MSaveManager.h"
 
-#include "EngineUtils.h"
+#include "Algo/Sort.h"
+#include "Async/Async.h"
+#include "Async/ParallelFor.h"
+#include "CoreGlobals.h"
+#include "Engine/GameInstance.h"
+#include "Engine/Level.h"
+#include "Engine/World.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/PlatformTime.h"
 #include "Kismet/GameplayStatics.h"
 #include "SaveSystem/IMSaveable.h"
 #include "SaveSystem/MSaveData.h"
@@ -11,7 +20,12 @@
 #include "SaveSystem/MSaveIndex.h"
 #include "SaveSystem/MSaveNode.h"
 #include "SaveSystem/MSaveNodeMetadata.h"
+#include "SaveSystem/MSavePayloadReader.h"
+#include "SaveSystem/MSaveSettings.h"
+#include "SaveSystem/MSaveStorage.h"
+#include "SaveSystem/MSaveTableArchive.h"
 #include "SaveSystem/MSlotId.h"
+#include "SaveSystem/MSlotSummary.h"
 #include "Serialization/Archive.h"
 #include "Serialization/MemoryReader.h"
 #include "Serialization/MemoryWriter.h"
@@ -21,12 +35,278 @@
 
 DEFINE_LOG_CATEGORY(LogMSaveManager);
 
+namespace MSaveManager
+{
+	/** Whether any entry which was omitted while loading belongs to a saveable in the given set */
+	static bool HasOmittedSaveData(const TMap<FString, FMSaveData>& SaveData, const TSet<FString>& SaveableIds)
+	{
+		for (const TTuple<FString, FMSaveData>& Entry : SaveData)
+		{
+			if (Entry.Value.bOmitted && SaveableIds.Contains(Entry.Key)) return true;
+		}
+
+		return false;
+	}
+
+	/**
+	 * Whether an actor was spawned at runtime, and should be spawned again if missing when loading.
+	 * Players are left out, the game mode spawns them instead.
+	 */
+	static bool IsSpawnedActor(const AActor* Actor)
+	{
+		if (!Actor || Actor->HasAnyFlags(RF_WasLoaded) || Actor->IsA<APlayerController>()) return false;
+
+		const APawn* Pawn = Cast<APawn>(Actor);
+		return !Pawn || !Pawn->IsPlayerControlled();
+	}
+
+	/**
+	 * The partition of a level: the package of a streaming level or World Partition cell, without any PIE prefix so it
+	 * stays the same across sessions. The persistent level is always resident, so it has no partition.
+	 */
+	static FName GetLevelPartition(const ULevel* Level)
+	{
+		if (!Level || Level->IsPersistentLevel()) return NAME_None;
+
+		return FName(UWorld::RemovePIEPrefix(Level->GetOutermost()->GetName()));
+	}
+
+	/**
+	 * Fills a save node with the captured save data which differs from its delta base (or all of it, for keyframes).
+	 * Runs on worker threads, so must only touch the node and the immutable captured and base save data.
+	 */
+	static void AssembleSaveNode(
+		UMSaveNode&						 SaveNode,
+		const TMap<FString, FMSaveData>& CapturedSaveData,
+		const TMap<FString, FMSaveData>* BaseSaveData)
+	{
+		if (!BaseSaveData)
+		{
+			SaveNode.SaveData = CapturedSaveData;
+			return;
+		}
+
+		TArray<const TTuple<FString, FMSaveData>*> Entries;
+		Entries.Reserve(CapturedSaveData.Num());
+		for (const TTuple<FString, FMSaveData>& Entry : CapturedSaveData)
+		{
+			Entries.Add(&Entry);
+		}
+
+		// Comparing payloads is the expensive part of diffing, so spread it across workers
+		TArray<bool> bChanged;
+		bChanged.SetNumZeroed(Entries.Num());
+		ParallelFor(Entries.Num(), [&Entries, &bChanged, BaseSaveData](int32 Index) -> void {
+			const FMSaveData* BaseEntry = BaseSaveData->Find(Entries[Index]->Key);
+			bChanged[Index] = !BaseEntry || !BaseEntry->IsIdentical(Entries[Index]->Value);
+		});
+
+		for (int32 Index = 0; Index < Entries.Num(); ++Index)
+		{
+			if (bChanged[Index]) SaveNode.SaveData.Add(*Entries[Index]);
+		}
+
+		for (const TTuple<FString, FMSaveData>& Entry : *BaseSaveData)
+		{
+			if (!CapturedSaveData.Contains(Entry.Key)) SaveNode.RemovedSaveIds.Add(Entry.Key);
+		}
+	}
+
+	/** Hashes every saveable's save data, for the slot's timeline or to diff against. Runs on worker threads. */
+	static void HashSaveData(const TMap<FString, FMSaveData>& SaveData, TMap<FString, FIoHash>& OutContentHashes)
+	{
+		TArray<const TTuple<FString, FMSaveData>*> Entries;
+		Entries.Reserve(SaveData.Num());
+		for (const TTuple<FString, FMSaveData>& Entry : SaveData)
+		{
+			Entries.Add(&Entry);
+		}
+
+		TArray<FIoHash> ContentHashes;
+		ContentHashes.SetNum(Entries.Num());
+		ParallelFor(Entries.Num(), [&Entries, &ContentHashes](int32 Index) -> void {
+			ContentHashes[Index] = Entries[Index]->Value.GetContentHash();
+		});
+
+		OutContentHashes.Reset();
+		OutContentHashes.Reserve(Entries.Num());
+		for (int32 Index = 0; Index < Entries.Num(); ++Index)
+		{
+			OutContentHashes.Add(Entries[Index]->Key, ContentHashes[Index]);
+		}
+	}
+
+	/**
+	 * Selects the save nodes the retention settings no longer keep.
+	 * Protected nodes, roots and nodes which branch (more than one child in either lineage) are always kept.
+	 */
+	static TSet<FGuid> SelectRemovedNodes(
+		const UMSaveGame& SaveGame, const TSet<FGuid>& ProtectedIds, const UMSaveSettings& Settings)
+	{
+		auto IsKept = [&SaveGame, &ProtectedIds](const FMSaveNodeMetadata& Node) -> bool {
+			return ProtectedIds.Contains(Node.SaveId)
+				|| (!Node.BranchParentId.IsValid() && !Node.SequenceParentId.IsValid())
+				|| SaveGame.GetNumChildren(Node.SaveId, EMSaveLineage::Branch) > 1
+				|| SaveGame.GetNumChildren(Node.SaveId, EMSaveLineage::Sequence) > 1;
+		};
+
+		TSet<FGuid> RemovedIds;
+
+		// 1. Invisible nodes past the newest MaxInvisibleNodes
+
+		if (Settings.MaxInvisibleNodes >= 0)
+		{
+			TArray<const FMSaveNodeMetadata*> InvisibleNodes;
+			for (const TTuple<FGuid, FMSaveNodeMetadata>& Node : SaveGame.SaveNodes)
+			{
+				if (Node.Value.bInvisible) InvisibleNodes.Add(&Node.Value);
+			}
+
+			Algo::Sort(InvisibleNodes, [](const FMSaveNodeMetadata* A, const FMSaveNodeMetadata* B) {
+				return A->Timestamp > B->Timestamp;
+			});
+
+			for (int32 Index = Settings.MaxInvisibleNodes; Index < InvisibleNodes.Num(); ++Index)
+			{
+				if (!IsKept(*InvisibleNodes[Index])) RemovedIds.Add(InvisibleNodes[Index]->SaveId);
+			}
+		}
+
+		// 2. Old visible nodes whose only sequence child was saved within the same thinning interval, so every
+		// interval keeps the last node of the sequence
+
+		if (Settings.SequenceThinningAgeHours > 0.0f)
+		{
+			FDateTime Cutoff = FDateTime::UtcNow() - FTimespan::FromHours(Settings.SequenceThinningAgeHours);
+			int64	  IntervalTicks =
+				FMath::Max<int64>(FTimespan::FromMinutes(Settings.SequenceThinningIntervalMinutes).GetTicks(), 1);
+
+			TArray<FGuid> SequenceChildren;
+			for (const TTuple<FGuid, FMSaveNodeMetadata>& Node : SaveGame.SaveNodes)
+			{
+				if (Node.Value.bInvisible || Node.Value.Timestamp >= Cutoff || IsKept(Node.Value)) continue;
+
+				SaveGame.GetChildren(Node.Key, EMSaveLineage::Sequence, SequenceChildren);
+				const FMSaveNodeMetadata* Child =
+					SequenceChildren.Num() == 1 ? SaveGame.SaveNodes.Find(SequenceChildren[0]) : nullptr;
+				if (!Child || Child->bInvisible) continue;
+
+				if (Child->Timestamp.GetTicks() / IntervalTicks == Node.Value.Timestamp.GetTicks() / IntervalTicks)
+					RemovedIds.Add(Node.Key);
+			}
+		}
+
+		return RemovedIds;
+	}
+
+	/** Follows a parent link across removed nodes up to the nearest remaining node, caching it for every node passed */
+	static FGuid FindRemainingAncestor(
+		const UMSaveGame&		  SaveGame,
+		const TSet<FGuid>&		  RemovedIds,
+		FGuid FMSaveNodeMetadata::*Link,
+		const FGuid&			  NodeId,
+		TMap<FGuid, FGuid>&		  Cache)
+	{
+		TArray<FGuid, TInlineAllocator<8>> Path;
+
+		FGuid Ancestor = NodeId;
+		while (RemovedIds.Contains(Ancestor))
+		{
+			if (const FGuid* Cached = Cache.Find(Ancestor))
+			{
+				Ancestor = *Cached;
+				break;
+			}
+
+			Path.Add(Ancestor);
+			const FMSaveNodeMetadata* Node = SaveGame.SaveNodes.Find(Ancestor);
+			Ancestor = Node ? Node->*Link : FGuid();
+		}
+
+		for (const FGuid& PathId : Path)
+		{
+			Cache.Add(PathId, Ancestor);
+		}
+
+		return Ancestor;
+	}
+
+	/**
+	 * Links the remaining nodes past removed ones, to their nearest remaining ancestor in each lineage and delta chain.
+	 * Collects the metadata of every remaining node which changed, and the nodes whose delta base is removed.
+	 */
+	static void RelinkRemainingNodes(
+		const UMSaveGame&			SaveGame,
+		const TSet<FGuid>&			RemovedIds,
+		TArray<FMSaveNodeMetadata>& OutUpdatedNodes,
+		TArray<FGuid>&				OutRebasedIds)
+	{
+		TMap<FGuid, FGuid>			   BranchCache;
+		TMap<FGuid, FGuid>			   SequenceCache;
+		TMap<FGuid, FGuid>			   DeltaBaseCache;
+		TMap<FGuid, FMSaveNodeMetadata> Relinked;
+		for (const TTuple<FGuid, FMSaveNodeMetadata>& Node : SaveGame.SaveNodes)
+		{
+			if (RemovedIds.Contains(Node.Key)) continue;
+
+			FMSaveNodeMetadata& Metadata = Relinked.Add(Node.Key, Node.Value);
+			Metadata.BranchParentId = FindRemainingAncestor(
+				SaveGame, RemovedIds, &FMSaveNodeMetadata::BranchParentId, Metadata.BranchParentId, BranchCache);
+			Metadata.SequenceParentId = FindRemainingAncestor(
+				SaveGame, RemovedIds, &FMSaveNodeMetadata::SequenceParentId, Metadata.SequenceParentId, SequenceCache);
+			Metadata.DeltaBaseId = FindRemainingAncestor(
+				SaveGame, RemovedIds, &FMSaveNodeMetadata::DeltaBaseId, Metadata.DeltaBaseId, DeltaBaseCache);
+
+			if (Metadata.DeltaBaseId != Node.Value.DeltaBaseId) OutRebasedIds.Add(Node.Key);
+		}
+
+		// Delta chains only ever get shorter, so depths are recounted from each node's keyframe
+		TFunction<int32(const FGuid&)> GetDeltaDepth = [&Relinked, &GetDeltaDepth](const FGuid& NodeId) -> int32 {
+			FMSaveNodeMetadata* Metadata = Relinked.Find(NodeId);
+			if (!Metadata || !Metadata->DeltaBaseId.IsValid()) return 0;
+
+			Metadata->DeltaDepth = GetDeltaDepth(Metadata->DeltaBaseId) + 1;
+			return Metadata->DeltaDepth;
+		};
+
+		for (TTuple<FGuid, FMSaveNodeMetadata>& Node : Relinked)
+		{
+			GetDeltaDepth(Node.Key);
+
+			const FMSaveNodeMetadata& Original = SaveGame.SaveNodes[Node.Key];
+			if (Node.Value.BranchParentId != Original.BranchParentId
+				|| Node.Value.SequenceParentId != Original.SequenceParentId
+				|| Node.Value.DeltaBaseId != Original.DeltaBaseId || Node.Value.DeltaDepth != Original.DeltaDepth)
+			{
+				OutUpdatedNodes.Add(Node.Value);
+			}
+		}
+	}
+} // namespace MSaveManager
+
+bool FMUnresolvedReference::IsPatchable() const
+{
+	return Owner.IsValid() && (bInline || Frame == GFrameCounter);
+}
+
+void FMUnresolvedReference::Patch(UObject* Saveable) const
+{
+	if (ObjectSlot && !*ObjectSlot) *ObjectSlot = Saveable;
+	if (ObjectPtrSlot && !*ObjectPtrSlot) *ObjectPtrSlot = FObjectPtr(Saveable);
+	if (WeakSlot && WeakSlot->IsExplicitlyNull()) *WeakSlot = Saveable;
+}
+
 UMSaveNode* UMSaveManager::SaveGame(bool bInvisible)
 {
 	checkf(ActiveSaveGame, TEXT("A save slot must be created/loaded before saving."));
 
-	UMSaveNode* SaveNode = CreateSaveNode(
-		ActiveSaveGame->MostRecentNodeId, ActiveSaveGame->MostRecentNodeId, /* bRecall = */ false, bInvisible);
+	UE::Tasks::TTask<bool> WriteTask;
+	UMSaveNode*			   SaveNode = CreateSaveNode(
+		  ActiveSaveGame->MostRecentNodeId,
+		  ActiveSaveGame->MostRecentNodeId,
+		  /* bRecall = */ false,
+		  bInvisible,
+		  WriteTask);
 	if (!SaveNode) return nullptr;
 
 	UE_LOG(
@@ -37,13 +317,8 @@ UMSaveNode* UMSaveManager::SaveGame(bool bInvisible)
 		ActiveSaveGame->UserIndex,
 		*SaveNode->SaveId.ToString());
 
-	FString SlotName = ActiveSaveGame->SlotName + SaveNode->SaveId.ToString();
-
-	bool bSuccess = UGameplayStatics::SaveGameToSlot(SaveNode, SlotName, ActiveSaveGame->UserIndex);
-	bSuccess = bSuccess
-		&& UGameplayStatics::SaveGameToSlot(ActiveSaveGame, ActiveSaveGame->SlotName, ActiveSaveGame->UserIndex);
-
-	if (bSuccess) OnSaveSlotUpdated.Broadcast(ActiveSaveGame);
+	bool bSuccess = FinishSaveNode(SaveNode, WriteTask.GetResult());
+	if (bSuccess) BroadcastNodeAdded(SaveNode->SaveId);
 
 	return bSuccess ? SaveNode : nullptr;
 }
@@ -52,24 +327,25 @@ void UMSaveManager::AsyncSaveGame(FMAsyncSaveGameDelegate Delegate, bool bInvisi
 {
 	checkf(ActiveSaveGame, TEXT("A save slot must be created/loaded before saving."));
 
-	UMSaveNode* SaveNode = CreateSaveNode(
-		ActiveSaveGame->MostRecentNodeId, ActiveSaveGame->MostRecentNodeId, /** bRecall = */ false, bInvisible);
+	UE::Tasks::TTask<bool> WriteTask;
+	UMSaveNode*			   SaveNode = CreateSaveNode(
+		  ActiveSaveGame->MostRecentNodeId,
+		  ActiveSaveGame->MostRecentNodeId,
+		  /** bRecall = */ false,
+		  bInvisible,
+		  WriteTask,
+		  [Delegate, SlotName = ActiveSaveGame->SlotName, UserIndex = ActiveSaveGame->UserIndex, this](
+			  UMSaveNode* WrittenNode, bool bWritten) -> void {
+			  bool bSuccess = FinishSaveNode(WrittenNode, bWritten);
+			  if (bSuccess) BroadcastNodeAdded(WrittenNode->SaveId);
+			  Delegate.ExecuteIfBound(SlotName, UserIndex, bSuccess ? WrittenNode : nullptr);
+		  });
 	if (!SaveNode)
 	{
 		Delegate.ExecuteIfBound(ActiveSaveGame->SlotName, ActiveSaveGame->UserIndex, nullptr);
 		return;
 	}
 
-	FAsyncSaveGameToSlotDelegate SaveDelegate;
-	if (Delegate.IsBound())
-	{
-		SaveDelegate.BindLambda(
-			[Delegate, SaveNode, this](const FString& SlotName, const int32 UserIndex, bool bSuccess) -> void {
-				if (bSuccess) OnSaveSlotUpdated.Broadcast(ActiveSaveGame);
-				Delegate.ExecuteIfBound(SlotName, UserIndex, bSuccess ? SaveNode : nullptr);
-			});
-	}
-
 	UE_LOG(
 		LogMSaveManager,
 		Log,
@@ -77,12 +353,6 @@ void UMSaveManager::AsyncSaveGame(FMAsyncSaveGameDelegate Delegate, bool bInvisi
 		*ActiveSaveGame->SlotName,
 		ActiveSaveGame->UserIndex,
 		*SaveNode->SaveId.ToString());
-
-	FString SlotName = ActiveSaveGame->SlotName + SaveNode->SaveId.ToString();
-
-	UGameplayStatics::AsyncSaveGameToSlot(SaveNode, SlotName, ActiveSaveGame->UserIndex, MoveTemp(SaveDelegate));
-	// TODO: the slot save also needs to be factored in for returning success
-	UGameplayStatics::AsyncSaveGameToSlot(ActiveSaveGame, ActiveSaveGame->SlotName, ActiveSaveGame->UserIndex, nullptr);
 }
 
 void UMSaveManager::AsyncSaveGameDynamic(FMAsyncSaveGameDelegateDynamic Delegate, bool bInvisible)
@@ -111,14 +381,18 @@ UMSaveNode* UMSaveManager::LoadGame(FGuid SaveId)
 		ActiveSaveGame->UserIndex,
 		*SaveId.ToString());
 
-	FString		SlotName = ActiveSaveGame->SlotName + SaveId.ToString();
-	UMSaveNode* SaveNode = Cast<UMSaveNode>(UGameplayStatics::LoadGameFromSlot(SlotName, ActiveSaveGame->UserIndex));
+	// Entries for saveables which are not present stay on disk, they would not be applied anyway. A prefetch still in
+	// flight is not waited on, the node is read the regular way instead.
+	TSharedRef<const TSet<FString>> SaveableIds = GetRegisteredSaveableIds();
+	UMSaveNode*						SaveNode = FindCachedNode(SaveId, *SaveableIds);
+	if (!SaveNode) SaveNode = GetActiveStorage().LoadNode(SaveId, &SaveableIds.Get());
 
 	bool bSuccess = LoadSaveNode(SaveNode, /** bRecall = */ false);
 	if (bSuccess)
 	{
 		ActiveSaveGame->MostRecentNodeId = SaveId;
-		OnSaveSlotUpdated.Broadcast(ActiveSaveGame);
+		CommitJournal({ FMSaveJournalOp::MostRecentChanged(SaveId) });
+		BroadcastActiveNodeChanged();
 	}
 
 	return SaveNode;
@@ -136,31 +410,62 @@ void UMSaveManager::AsyncLoadGame(FMAsyncLoadGameDelegate Delegate, FGuid SaveId
 		ActiveSaveGame->UserIndex,
 		*SaveId.ToString());
 
-	FString SlotName = ActiveSaveGame->SlotName + SaveId.ToString();
+	FString SlotName = ActiveSaveGame->SlotName;
+	int32	UserIndex = ActiveSaveGame->UserIndex;
 
-	FAsyncLoadGameFromSlotDelegate LoadDelegate;
-	LoadDelegate.BindLambda(
-		[Delegate, SaveId, this](const FString& InSlotName, const int32 InUserIndex, USaveGame* SaveNode) -> void {
-			UMSaveNode* MSaveNode = Cast<UMSaveNode>(SaveNode);
-			bool		bSuccess = MSaveNode != nullptr;
+	auto OnLoaded = [Delegate, SaveId, SlotName, UserIndex, this](UMSaveNode* SaveNode) -> void {
+		if (!SaveNode)
+		{
+			Delegate.ExecuteIfBound(SlotName, UserIndex, nullptr);
+			return;
+		}
 
-			if (!bSuccess)
-			{
-				Delegate.ExecuteIfBound(InSlotName, InUserIndex, MSaveNode);
-				return;
-			}
+		bool bSuccess = LoadSaveNode(SaveNode, /** bRecall = */ false);
+		if (bSuccess)
+		{
+			ActiveSaveGame->MostRecentNodeId = SaveId;
+			CommitJournal({ FMSaveJournalOp::MostRecentChanged(SaveId) });
+			BroadcastActiveNodeChanged();
+		}
 
-			bSuccess = LoadSaveNode(MSaveNode, /** bRecall = */ false);
-			if (bSuccess)
-			{
-				ActiveSaveGame->MostRecentNodeId = SaveId;
-				OnSaveSlotUpdated.Broadcast(ActiveSaveGame);
-			}
+		Delegate.ExecuteIfBound(SlotName, UserIndex, SaveNode);
+	};
 
-			Delegate.ExecuteIfBound(InSlotName, InUserIndex, MSaveNode);
-		});
+	// A prefetched node only has to be applied, once the worker thread resolving it is done
+	if (const FMPrefetchedNode* Prefetched = PrefetchedNodes.Find(SaveId))
+	{
+		UE::Tasks::Launch(
+			UE_SOURCE_LOCATION,
+			[SaveId, OnLoaded = MoveTemp(OnLoaded), this]() mutable -> void {
+				AsyncTask(ENamedThreads::GameThread, [SaveId, OnLoaded = MoveTemp(OnLoaded), this]() mutable -> void {
+					TSharedRef<const TSet<FString>> SaveableIds = GetRegisteredSaveableIds();
+					if (const FMPrefetchedNode* Resolved = FindPrefetchedNode(SaveId, *SaveableIds))
+					{
+						OnLoaded(Resolved->SaveNode.Get());
+						return;
+					}
+
+					// The prefetch failed, went stale, or was replaced by one which is still in flight
+					GetActiveStorage().AsyncLoadNode(SaveId, MoveTemp(OnLoaded), SaveableIds);
+				});
+			},
+			UE::Tasks::Prerequisites(Prefetched->Task));
+		return;
+	}
+
+	GetActiveStorage().AsyncLoadNode(SaveId, MoveTemp(OnLoaded), GetRegisteredSaveableIds());
+}
+
+bool UMSaveManager::PrefetchNode(FGuid SaveId)
+{
+	checkf(ActiveSaveGame, TEXT("A save slot must be created/loaded before prefetching."));
+
+	return StartPrefetch(SaveId, /* bWarm = */ false);
+}
 
-	UGameplayStatics::AsyncLoadGameFromSlot(SlotName, ActiveSaveGame->UserIndex, MoveTemp(LoadDelegate));
+void UMSaveManager::ReleasePrefetchedNode(FGuid SaveId)
+{
+	PrefetchedNodes.Remove(SaveId);
 }
 
 void UMSaveManager::AsyncLoadGameDynamic(FMAsyncLoadGameDelegateDynamic Delegate, FGuid SaveId)
@@ -183,16 +488,18 @@ UMSaveNode* UMSaveManager::RecallGame(FGuid BranchParentId, FGuid SequenceParent
 
 	// 1. Load save objects
 
-	FString		BranchSlotName = ActiveSaveGame->SlotName + BranchParentId.ToString();
-	UMSaveNode* BranchNode =
-		Cast<UMSaveNode>(UGameplayStatics::LoadGameFromSlot(BranchSlotName, ActiveSaveGame->UserIndex));
+	TSharedRef<const TSet<FString>> SaveableIds = GetRegisteredSaveableIds();
+	UMSaveNode*						BranchNode = FindCachedNode(BranchParentId, *SaveableIds);
+	if (!BranchNode) BranchNode = GetActiveStorage().LoadNode(BranchParentId, &SaveableIds.Get());
 
 	bool bSuccess = LoadSaveNode(BranchNode, /** bRecall = */ true);
 	if (!bSuccess) return nullptr;
 
 	// 2. Save save objects
 	SequenceParentId = SequenceParentId.IsValid() ? SequenceParentId : ActiveSaveGame->MostRecentNodeId;
-	UMSaveNode* SaveNode = CreateSaveNode(BranchParentId, SequenceParentId, /* bRecall = */ true, bInvisible);
+	UE::Tasks::TTask<bool> WriteTask;
+	UMSaveNode*			   SaveNode =
+		CreateSaveNode(BranchParentId, SequenceParentId, /* bRecall = */ true, bInvisible, WriteTask);
 	if (!SaveNode) return nullptr;
 
 	UE_LOG(
@@ -203,17 +510,8 @@ UMSaveNode* UMSaveManager::RecallGame(FGuid BranchParentId, FGuid SequenceParent
 		ActiveSaveGame->UserIndex,
 		*SaveNode->SaveId.ToString());
 
-	FString SlotName = ActiveSaveGame->SlotName + SaveNode->SaveId.ToString();
-
-	bSuccess = UGameplayStatics::SaveGameToSlot(SaveNode, SlotName, ActiveSaveGame->UserIndex);
-	bSuccess = bSuccess
-		&& UGameplayStatics::SaveGameToSlot(ActiveSaveGame, ActiveSaveGame->SlotName, ActiveSaveGame->UserIndex);
-
-	if (bSuccess)
-	{
-		ActiveSaveGame->MostRecentNodeId = SaveNode->SaveId;
-		OnSaveSlotUpdated.Broadcast(ActiveSaveGame);
-	}
+	bSuccess = FinishSaveNode(SaveNode, WriteTask.GetResult());
+	if (bSuccess) BroadcastNodeAdded(SaveNode->SaveId);
 
 	return bSuccess ? SaveNode : nullptr;
 }
@@ -225,42 +523,37 @@ void UMSaveManager::AsyncRecallGame(
 
 	// 1. Load save objects
 
-	FString BranchSlotName = ActiveSaveGame->SlotName + BranchParentId.ToString();
-
-	FAsyncLoadGameFromSlotDelegate LoadDelegate;
-	LoadDelegate.BindLambda(
-		[Delegate, BranchParentId, bInvisible, this](
-			const FString& InSlotName, const int32 InUserIndex, USaveGame* BranchParent) -> void {
-			UMSaveNode* MBranchParent = Cast<UMSaveNode>(BranchParent);
-
-			bool bSuccess = LoadSaveNode(MBranchParent, /** bRecall = */ true);
+	GetActiveStorage().AsyncLoadNode(
+		BranchParentId,
+		[Delegate, bInvisible, SlotName = ActiveSaveGame->SlotName, UserIndex = ActiveSaveGame->UserIndex, this](
+			UMSaveNode* BranchParent) -> void {
+			bool bSuccess = LoadSaveNode(BranchParent, /** bRecall = */ true);
 			if (!bSuccess)
 			{
-				Delegate.ExecuteIfBound(InSlotName, InUserIndex, nullptr);
+				Delegate.ExecuteIfBound(SlotName, UserIndex, nullptr);
 				return;
 			}
 
 			// 2. Save save objects
 
-			UMSaveNode* SaveNode = CreateSaveNode(
-				ActiveSaveGame->MostRecentNodeId, ActiveSaveGame->MostRecentNodeId, /** bRecall = */ true, bInvisible);
+			UE::Tasks::TTask<bool> WriteTask;
+			UMSaveNode*			   SaveNode = CreateSaveNode(
+				  ActiveSaveGame->MostRecentNodeId,
+				  ActiveSaveGame->MostRecentNodeId,
+				  /** bRecall = */ true,
+				  bInvisible,
+				  WriteTask,
+				  [Delegate, SlotName, UserIndex, this](UMSaveNode* WrittenNode, bool bWritten) -> void {
+					  bool bCommitted = FinishSaveNode(WrittenNode, bWritten);
+					  if (bCommitted) BroadcastNodeAdded(WrittenNode->SaveId);
+					  Delegate.ExecuteIfBound(SlotName, UserIndex, bCommitted ? WrittenNode : nullptr);
+				  });
 			if (!SaveNode)
 			{
-				Delegate.ExecuteIfBound(ActiveSaveGame->SlotName, ActiveSaveGame->UserIndex, nullptr);
+				Delegate.ExecuteIfBound(SlotName, UserIndex, nullptr);
 				return;
 			}
 
-			FAsyncSaveGameToSlotDelegate SaveDelegate;
-			SaveDelegate.BindLambda(
-				[Delegate, SaveNode, this](const FString& SlotName, const int32 UserIndex, bool bSuccess) -> void {
-					if (bSuccess)
-					{
-						ActiveSaveGame->MostRecentNodeId = SaveNode->SaveId;
-						OnSaveSlotUpdated.Broadcast(ActiveSaveGame);
-					}
-					Delegate.ExecuteIfBound(SlotName, UserIndex, bSuccess ? SaveNode : nullptr);
-				});
-
 			UE_LOG(
 				LogMSaveManager,
 				Log,
@@ -268,17 +561,8 @@ void UMSaveManager::AsyncRecallGame(
 				*ActiveSaveGame->SlotName,
 				ActiveSaveGame->UserIndex,
 				*SaveNode->SaveId.ToString());
-
-			FString SlotName = ActiveSaveGame->SlotName + SaveNode->SaveId.ToString();
-
-			UGameplayStatics::AsyncSaveGameToSlot(
-				SaveNode, SlotName, ActiveSaveGame->UserIndex, MoveTemp(SaveDelegate));
-			// TODO: the slot save also needs to be factored in for returning success
-			UGameplayStatics::AsyncSaveGameToSlot(
-				ActiveSaveGame, ActiveSaveGame->SlotName, ActiveSaveGame->UserIndex, nullptr);
-		});
-
-	UGameplayStatics::AsyncLoadGameFromSlot(BranchSlotName, ActiveSaveGame->UserIndex, MoveTemp(LoadDelegate));
+		},
+		GetRegisteredSaveableIds());
 }
 
 void UMSaveManager::AsyncRecallGameDynamic(
@@ -302,15 +586,26 @@ UMSaveGame* UMSaveManager::CreateSaveSlot(const FString& SlotName, const int32 U
 
 	UE_LOG(LogMSaveManager, Log, TEXT("Creating save slot - %s:%d"), *SlotName, UserIndex);
 
+	// A journal left behind by a slot which was not deleted cleanly would otherwise be replayed onto this one
+	FMSaveStorage::DeleteSlotFiles(SlotName, UserIndex);
+
 	UMSaveGame* SaveGame = Cast<UMSaveGame>(UGameplayStatics::CreateSaveGameObject(UMSaveGame::StaticClass()));
 	SaveGame->SlotName = SlotName;
 	SaveGame->UserIndex = UserIndex;
+	SaveGame->Compression = GetDefault<UMSaveSettings>()->DefaultCompression;
 
 	bool bSuccess = UGameplayStatics::SaveGameToSlot(SaveGame, SlotName, UserIndex);
 
+	// The slot's own files are only usable where save games are plain files, see FMSaveStorage
+	if (bSuccess && !FMSaveStorage::IsFileStorageSupported(SlotName))
+	{
+		UGameplayStatics::DeleteGameInSlot(SlotName, UserIndex);
+		bSuccess = false;
+	}
+
 	if (bSuccess && SaveIndex)
 	{
-		SaveIndex->SaveSlots.Add({ SlotName, UserIndex });
+		SaveIndex->AddSlot({ SlotName, UserIndex });
 		bSuccess = bSuccess && UGameplayStatics::SaveGameToSlot(SaveIndex, TEXT("SaveIndex"), 0);
 		OnSaveIndexUpdated.Broadcast(SaveIndex);
 	}
@@ -318,7 +613,7 @@ UMSaveGame* UMSaveManager::CreateSaveSlot(const FString& SlotName, const int32 U
 	if (bSuccess)
 	{
 		ActiveSaveGame = SaveGame;
-		OnSaveSlotUpdated.Broadcast(ActiveSaveGame);
+		BroadcastSlotSwitched();
 	}
 	else
 	{
@@ -333,19 +628,29 @@ void UMSaveManager::AsyncCreateSaveSlot(
 {
 	FMAsyncDeleteSlotDelegate NativeDelegate = FMAsyncDeleteSlotDelegate::CreateLambda(
 		[Delegate, this](const FString& InSlotName, const int32 InUserIndex, bool bSuccess) -> void {
+			FMSaveStorage::DeleteSlotFiles(InSlotName, InUserIndex);
+
 			UMSaveGame* SaveGame = Cast<UMSaveGame>(UGameplayStatics::CreateSaveGameObject(UMSaveGame::StaticClass()));
 			SaveGame->SlotName = InSlotName;
 			SaveGame->UserIndex = InUserIndex;
+			SaveGame->Compression = GetDefault<UMSaveSettings>()->DefaultCompression;
 
 			FAsyncSaveGameToSlotDelegate SaveDelegate = FAsyncSaveGameToSlotDelegate::CreateLambda(
 				[Delegate, SaveGame, this](const FString& SlotName, const int32 UserIndex, bool bSuccess) -> void {
+					// The slot's own files are only usable where save games are plain files, see FMSaveStorage
+					if (bSuccess && !FMSaveStorage::IsFileStorageSupported(SlotName))
+					{
+						UGameplayStatics::DeleteGameInSlot(SlotName, UserIndex);
+						bSuccess = false;
+					}
+
 					FAsyncSaveGameToSlotDelegate SaveIndexDelegate = FAsyncSaveGameToSlotDelegate::CreateLambda(
 						[Delegate, SaveGame, this](
 							const FString& SlotName, const int32 UserIndex, bool bSuccess) -> void {
 							if (bSuccess)
 							{
 								ActiveSaveGame = SaveGame;
-								OnSaveSlotUpdated.Broadcast(ActiveSaveGame);
+								BroadcastSlotSwitched();
 								OnSaveIndexUpdated.Broadcast(SaveIndex);
 							}
 
@@ -354,7 +659,7 @@ void UMSaveManager::AsyncCreateSaveSlot(
 
 					if (bSuccess && SaveIndex)
 					{
-						SaveIndex->SaveSlots.Add({ SlotName, UserIndex });
+						SaveIndex->AddSlot({ SlotName, UserIndex });
 						UGameplayStatics::AsyncSaveGameToSlot(
 							SaveIndex, TEXT("SaveIndex"), 0, MoveTemp(SaveIndexDelegate));
 					}
@@ -399,11 +704,20 @@ UMSaveGame* UMSaveManager::LoadSaveSlot(const FString& SlotName, const int32 Use
 	UE_LOG(LogMSaveManager, Log, TEXT("Loading save slot - %s:%d"), *SlotName, UserIndex);
 
 	UMSaveGame* SaveGame = Cast<UMSaveGame>(UGameplayStatics::LoadGameFromSlot(SlotName, UserIndex));
+	if (SaveGame)
+	{
+		// Cloned slots are copied byte for byte, so they still carry the original's name
+		SaveGame->SlotName = SlotName;
+		SaveGame->UserIndex = UserIndex;
+		FMSaveStorage::Open(SlotName, UserIndex)->ReplayJournal(*SaveGame);
+		SaveGame->RebuildAdjacency();
+	}
+
 	if (bSetActive && SaveGame)
 	{
 		ActiveSaveGame = SaveGame;
 		SaveHistory->Initialize(SaveGame);
-		OnSaveSlotUpdated.Broadcast(ActiveSaveGame);
+		BroadcastSlotSwitched();
 	}
 	return SaveGame;
 }
@@ -415,11 +729,20 @@ void UMSaveManager::AsyncLoadSaveSlot(
 	LoadDelegate.BindLambda(
 		[Delegate, bSetActive, this](const FString& SlotName, const int32 UserIndex, USaveGame* SaveGame) -> void {
 			UMSaveGame* MSaveGame = Cast<UMSaveGame>(SaveGame);
+			if (MSaveGame)
+			{
+				// Cloned slots are copied byte for byte, so they still carry the original's name
+				MSaveGame->SlotName = SlotName;
+				MSaveGame->UserIndex = UserIndex;
+				FMSaveStorage::Open(SlotName, UserIndex)->ReplayJournal(*MSaveGame);
+				MSaveGame->RebuildAdjacency();
+			}
+
 			if (bSetActive && MSaveGame)
 			{
 				ActiveSaveGame = MSaveGame;
-				SaveHistory->Initialize(MSaveGame);
-				OnSaveSlotUpdated.Broadcast(ActiveSaveGame);
+				SaveHistory->AsyncInitialize(MSaveGame);
+				BroadcastSlotSwitched();
 			}
 
 			Delegate.ExecuteIfBound(SlotName, UserIndex, MSaveGame);
@@ -492,66 +815,32 @@ void UMSaveManager::AsyncLoadOrCreateSaveSlotDynamic(
 
 bool UMSaveManager::DeleteSaveSlot(const FString& SlotName, const int32 UserIndex)
 {
-	UMSaveGame* SaveGame = LoadSaveSlot(SlotName, UserIndex, false);
-	if (!SaveGame) return false;
-
-	UE_LOG(LogMSaveManager, Log, TEXT("Deleting save slot - %s:%d"), *SlotName, UserIndex);
-
-	DeleteSaveGraph(SaveGame);
-
-	if (ActiveSaveGame && SaveGame->SlotName == ActiveSaveGame->SlotName
-		&& SaveGame->UserIndex == ActiveSaveGame->UserIndex)
-	{
-		ActiveSaveGame = nullptr;
-		SaveHistory->Initialize(nullptr);
-		OnSaveSlotUpdated.Broadcast(ActiveSaveGame);
-	}
-
-	SaveIndex->SaveSlots.Remove({ SlotName, UserIndex });
-	UGameplayStatics::SaveGameToSlot(SaveIndex, TEXT("SaveIndex"), 0);
-
-	OnSaveIndexUpdated.Broadcast(SaveIndex);
+	if (!UGameplayStatics::DoesSaveGameExist(SlotName, UserIndex)) return false;
 
-	return UGameplayStatics::DeleteGameInSlot(SlotName, UserIndex);
+	// The save nodes are still deleted on a worker thread, this only waits for them
+	return DeleteSaveGraph(SlotName, UserIndex).GetResult();
 }
 
 void UMSaveManager::AsyncDeleteSaveSlot(
 	FMAsyncDeleteSlotDelegate Delegate, const FString& SlotName, const int32 UserIndex)
 {
-	FMAsyncLoadSlotDelegate LoadDelegate;
-	LoadDelegate.BindLambda(
-		[Delegate, this](const FString& InSlotName, const int32 InUserIndex, UMSaveGame* SaveGame) -> void {
-			if (!SaveGame)
-			{
-				Delegate.ExecuteIfBound(InSlotName, InUserIndex, false);
-				return;
-			}
-
-			UE_LOG(LogMSaveManager, Log, TEXT("Deleting save slot - %s:%d"), *InSlotName, InUserIndex);
-
-			DeleteSaveGraph(SaveGame);
-
-			if (ActiveSaveGame && SaveGame->SlotName == ActiveSaveGame->SlotName
-				&& SaveGame->UserIndex == ActiveSaveGame->UserIndex)
-			{
-				ActiveSaveGame = nullptr;
-				SaveHistory->Initialize(nullptr);
-				OnSaveSlotUpdated.Broadcast(ActiveSaveGame);
-			}
+	if (!UGameplayStatics::DoesSaveGameExist(SlotName, UserIndex))
+	{
+		Delegate.ExecuteIfBound(SlotName, UserIndex, false);
+		return;
+	}
 
-			SaveIndex->SaveSlots.Remove({ InSlotName, InUserIndex });
-			FAsyncSaveGameToSlotDelegate SaveIndexDelegate = FAsyncSaveGameToSlotDelegate::CreateLambda(
-				[Delegate, InSlotName, InUserIndex, this](
-					const FString& SlotName, const int32 UserIndex, bool bSuccess) -> void {
-					// TODO: Index updated event
-					bSuccess = bSuccess && UGameplayStatics::DeleteGameInSlot(InSlotName, InUserIndex);
-					Delegate.ExecuteIfBound(InSlotName, InUserIndex, bSuccess);
+	UE::Tasks::TTask<bool> DeleteTask = DeleteSaveGraph(SlotName, UserIndex);
+	UE::Tasks::Launch(
+		UE_SOURCE_LOCATION,
+		[DeleteTask, Delegate = MoveTemp(Delegate), SlotName, UserIndex]() mutable -> void {
+			AsyncTask(
+				ENamedThreads::GameThread,
+				[bSuccess = DeleteTask.GetResult(), Delegate = MoveTemp(Delegate), SlotName, UserIndex]() -> void {
+					Delegate.ExecuteIfBound(SlotName, UserIndex, bSuccess);
 				});
-
-			UGameplayStatics::AsyncSaveGameToSlot(SaveIndex, TEXT("SaveIndex"), 0, MoveTemp(SaveIndexDelegate));
-		});
-
-	AsyncLoadSaveSlot(MoveTemp(LoadDelegate), SlotName, UserIndex, false);
+		},
+		DeleteTask);
 }
 
 void UMSaveManager::AsyncDeleteSaveSlotDynamic(
@@ -574,75 +863,540 @@ UMSaveGame* UMSaveManager::CloneSaveSlot(
 	const FString& NewSlotName,
 	const int32	   NewUserIndex)
 {
-	if (!UGameplayStatics::DoesSaveGameExist(OriginalSlotName, OriginalUserIndex)) return nullptr;
-
-	UE_LOG(
-		LogMSaveManager,
-		Log,
-		TEXT("Cloning save slot - %s:%d -> %s:%d"),
-		*OriginalSlotName,
-		OriginalUserIndex,
-		*NewSlotName,
-		NewUserIndex);
+	TOptional<UE::Tasks::TTask<bool>> CopyTask =
+		LaunchCloneSaveSlot(OriginalSlotName, OriginalUserIndex, NewSlotName, NewUserIndex);
+	if (!CopyTask || !CopyTask->GetResult()) return nullptr;
 
-	UMSaveGame* OriginalSaveGame = LoadSaveSlot(OriginalSlotName, OriginalUserIndex, false);
-	if (!OriginalSaveGame) return nullptr;
+	UMSaveGame* NewSaveGame = LoadSaveSlot(NewSlotName, NewUserIndex, false);
+	if (NewSaveGame) FinishCloneSaveSlot({ OriginalSlotName, OriginalUserIndex }, *NewSaveGame);
 
-	UMSaveGame* NewSaveGame = CreateSaveSlot(NewSlotName, NewUserIndex);
-	if (!NewSaveGame) return nullptr;
+	return NewSaveGame;
+}
 
-	NewSaveGame->SlotName = NewSlotName;
-	NewSaveGame->UserIndex = NewUserIndex;
-	NewSaveGame->MostRecentNodeId = OriginalSaveGame->MostRecentNodeId;
+void UMSaveManager::AsyncCloneSaveSlot(
+	FMAsyncCloneSlotDelegate Delegate,
+	const FString&			 OriginalSlotName,
+	const int32				 OriginalUserIndex,
+	const FString&			 NewSlotName,
+	const int32				 NewUserIndex)
+{
+	TOptional<UE::Tasks::TTask<bool>> CopyTask =
+		LaunchCloneSaveSlot(OriginalSlotName, OriginalUserIndex, NewSlotName, NewUserIndex);
+	if (!CopyTask)
+	{
+		Delegate.ExecuteIfBound(NewSlotName, NewUserIndex, nullptr);
+		return;
+	}
 
-	bool bSuccess = true;
+	FMAsyncLoadSlotDelegate LoadDelegate = FMAsyncLoadSlotDelegate::CreateLambda(
+		[Delegate, OriginalSlotName, OriginalUserIndex, this](
+			const FString& SlotName, const int32 UserIndex, UMSaveGame* SaveGame) -> void {
+			if (SaveGame) FinishCloneSaveSlot({ OriginalSlotName, OriginalUserIndex }, *SaveGame);
 
-	for (const TTuple<FGuid, FMSaveNodeMetadata>& OriginalMetadata : OriginalSaveGame->SaveNodes)
-	{
-		FString		OriginalNodeSlotName = OriginalSaveGame->SlotName + OriginalMetadata.Key.ToString();
-		UMSaveNode* OriginalSaveNode =
-			Cast<UMSaveNode>(UGameplayStatics::LoadGameFromSlot(OriginalNodeSlotName, OriginalSaveGame->UserIndex));
-		UMSaveNode* NewSaveNode = CloneSaveNode(OriginalSaveNode);
-		if (!NewSaveNode) return nullptr;
+			Delegate.ExecuteIfBound(SlotName, UserIndex, SaveGame);
+		});
 
-		FString NewNodeSlotName = NewSlotName + NewSaveNode->SaveId.ToString();
-		bSuccess = bSuccess && UGameplayStatics::SaveGameToSlot(NewSaveNode, NewNodeSlotName, NewSaveGame->UserIndex);
-		if (!bSuccess) return nullptr;
+	UE::Tasks::Launch(
+		UE_SOURCE_LOCATION,
+		[CopyTask = *CopyTask, LoadDelegate = MoveTemp(LoadDelegate), NewSlotName, NewUserIndex, this]() mutable
+		-> void {
+			bool bSuccess = CopyTask.GetResult();
+			AsyncTask(
+				ENamedThreads::GameThread,
+				[bSuccess, LoadDelegate = MoveTemp(LoadDelegate), NewSlotName, NewUserIndex, this]() mutable -> void {
+					if (bSuccess)
+						AsyncLoadSaveSlot(MoveTemp(LoadDelegate), NewSlotName, NewUserIndex, false);
+					else
+						LoadDelegate.Execute(NewSlotName, NewUserIndex, nullptr);
+				});
+		},
+		*CopyTask);
+}
 
-		NewSaveGame->SaveNodes.Add(OriginalMetadata.Key, OriginalMetadata.Value);
+void UMSaveManager::AsyncCloneSaveSlotDynamic(
+	FMAsyncCloneSlotDelegateDynamic Delegate,
+	const FString&					OriginalSlotName,
+	const int32						OriginalUserIndex,
+	const FString&					NewSlotName,
+	const int32						NewUserIndex)
+{
+	FMAsyncCloneSlotDelegate NativeDelegate;
+	if (Delegate.IsBound())
+	{
+		NativeDelegate.BindLambda(
+			[Delegate](const FString& SlotName, const int32 UserIndex, UMSaveGame* SaveGame) -> void {
+				Delegate.ExecuteIfBound(SlotName, UserIndex, SaveGame);
+			});
 	}
 
-	bSuccess = bSuccess && UGameplayStatics::SaveGameToSlot(NewSaveGame, NewSlotName, NewSaveGame->UserIndex);
-
-	return bSuccess ? NewSaveGame : nullptr;
+	AsyncCloneSaveSlot(MoveTemp(NativeDelegate), OriginalSlotName, OriginalUserIndex, NewSlotName, NewUserIndex);
 }
 
 TArray<FMSlotId> UMSaveManager::GetSaveIndex() const
 {
-	return SaveIndex ? SaveIndex->SaveSlots : TArray<FMSlotId>();
+	return SaveIndex ? SaveIndex->GetSlotIds() : TArray<FMSlotId>();
 }
 
-void UMSaveManager::Initialize(FSubsystemCollectionBase& Collection)
+TArray<FMSlotSummary> UMSaveManager::GetSlotSummaries() const
 {
-	Super::Initialize(Collection);
+	return SaveIndex ? SaveIndex->GetSlotSummaries() : TArray<FMSlotSummary>();
+}
 
-	if (!UGameplayStatics::DoesSaveGameExist(TEXT("SaveIndex"), 0))
+bool UMSaveManager::GetSlotSummary(const FString& SlotName, const int32 UserIndex, FMSlotSummary& OutSummary) const
+{
+	const FMSlotSummary* Summary = SaveIndex ? SaveIndex->FindSlot({ SlotName, UserIndex }) : nullptr;
+	if (!Summary) return false;
+
+	OutSummary = *Summary;
+	return true;
+}
+
+bool UMSaveManager::SetSlotUserData(const TArray<uint8>& UserData)
+{
+	checkf(ActiveSaveGame, TEXT("A save slot must be created/loaded before setting its user data."));
+
+	int32 MaxBytes = GetDefault<UMSaveSettings>()->MaxSlotUserDataBytes;
+	if (UserData.Num() > MaxBytes)
 	{
-		UMSaveIndex* Index = Cast<UMSaveIndex>(UGameplayStatics::CreateSaveGameObject(UMSaveIndex::StaticClass()));
-		FAsyncSaveGameToSlotDelegate Delegate = FAsyncSaveGameToSlotDelegate::CreateLambda(
-			[Index, this](const FString& SlotName, int32 UserIndex, bool bSuccess) -> void {
-				if (bSuccess)
-					SaveIndex = Index;
-				else
-					UE_LOG(LogMSaveManager, Warning, TEXT("Failed to create SaveIndex"));
-			});
-		UGameplayStatics::AsyncSaveGameToSlot(Index, TEXT("SaveIndex"), 0, MoveTemp(Delegate));
+		UE_LOG(
+			LogMSaveManager,
+			Warning,
+			TEXT("Slot user data of %d bytes is over the %d bytes limit"),
+			UserData.Num(),
+			MaxBytes);
+		return false;
 	}
-	else
+
+	FMSlotSummary* Summary =
+		SaveIndex ? SaveIndex->FindSlot({ ActiveSaveGame->SlotName, ActiveSaveGame->UserIndex }) : nullptr;
+	if (!Summary) return false;
+	if (Summary->UserData == UserData) return true;
+
+	Summary->UserData = UserData;
+	OnSaveIndexUpdated.Broadcast(SaveIndex);
+	WriteSaveIndex();
+
+	return true;
+}
+
+void UMSaveManager::WriteSaveIndex()
+{
+	if (!SaveIndex) return;
+
+	// Writes never overlap, so an older index can't land on disk after a newer one
+	if (bWritingSaveIndex)
 	{
-		FAsyncLoadGameFromSlotDelegate Delegate = FAsyncLoadGameFromSlotDelegate::CreateLambda(
-			[this](const FString& SlotName, int32 UserIndex, USaveGame* SaveGame) -> void {
-				UMSaveIndex* Index = Cast<UMSaveIndex>(SaveGame);
+		bSaveIndexDirty = true;
+		return;
+	}
+
+	bWritingSaveIndex = true;
+	bSaveIndexDirty = false;
+
+	FAsyncSaveGameToSlotDelegate Delegate = FAsyncSaveGameToSlotDelegate::CreateLambda(
+		[this](const FString& SlotName, const int32 UserIndex, bool bSuccess) -> void {
+			bWritingSaveIndex = false;
+			if (!bSuccess) UE_LOG(LogMSaveManager, Warning, TEXT("Failed to write SaveIndex"));
+
+			if (bSaveIndexDirty) WriteSaveIndex();
+		});
+	UGameplayStatics::AsyncSaveGameToSlot(SaveIndex, TEXT("SaveIndex"), 0, MoveTemp(Delegate));
+}
+
+void UMSaveManager::CommitJournal(TArray<FMSaveJournalOp> JournalOps)
+{
+	GetActiveStorage().LaunchCommitJournal(
+		MoveTemp(JournalOps),
+		[Manager = TWeakObjectPtr<UMSaveManager>(this),
+		 SaveGame = TWeakObjectPtr<UMSaveGame>(ActiveSaveGame)](bool bSuccess) -> void {
+			if (bSuccess && Manager.IsValid() && SaveGame.IsValid())
+				Manager->UpdateSlotSummary(*SaveGame, /* bFullScan = */ false);
+		});
+}
+
+void UMSaveManager::UpdateSlotSummary(const UMSaveGame& SaveGame, bool bFullScan)
+{
+	FMSlotSummary* Summary = SaveIndex ? SaveIndex->FindSlot({ SaveGame.SlotName, SaveGame.UserIndex }) : nullptr;
+	if (!Summary) return;
+
+	FMSlotSummary Updated = *Summary;
+	Updated.NumNodes = SaveGame.SaveNodes.Num();
+	Updated.HeadNodeId = SaveGame.MostRecentNodeId;
+
+	// Only known once the slot was written since it was opened, until then its last summarized size still holds
+	int64 TotalBytes = FMSaveStorage::FindSlotFilesSize(SaveGame.SlotName, SaveGame.UserIndex);
+	if (TotalBytes != INDEX_NONE) Updated.TotalBytes = TotalBytes;
+
+	if (bFullScan)
+	{
+		Updated.LastSaved = FDateTime();
+		for (const TTuple<FGuid, FMSaveNodeMetadata>& Node : SaveGame.SaveNodes)
+		{
+			Updated.LastSaved = FMath::Max(Updated.LastSaved, Node.Value.Timestamp);
+		}
+	}
+	else if (const FMSaveNodeMetadata* Head = SaveGame.SaveNodes.Find(SaveGame.MostRecentNodeId))
+	{
+		Updated.LastSaved = FMath::Max(Updated.LastSaved, Head->Timestamp);
+	}
+
+	if (Updated == *Summary) return;
+
+	*Summary = MoveTemp(Updated);
+	OnSaveIndexUpdated.Broadcast(SaveIndex);
+	WriteSaveIndex();
+}
+
+bool UMSaveManager::SetCompression(EMSaveCompression Compression)
+{
+	if (!ActiveSaveGame) return false;
+	if (ActiveSaveGame->Compression == Compression) return true;
+
+	UE_LOG(
+		LogMSaveManager,
+		Log,
+		TEXT("Compressing save data with %s - %s:%d"),
+		*UEnum::GetDisplayValueAsText(Compression).ToString(),
+		*ActiveSaveGame->SlotName,
+		ActiveSaveGame->UserIndex);
+
+	ActiveSaveGame->Compression = Compression;
+	CommitJournal({ FMSaveJournalOp::CompressionChanged(Compression) });
+	return true;
+}
+
+bool UMSaveManager::CompactSaveGraph()
+{
+	if (!ActiveSaveGame || bCompactingSaveGraph) return false;
+
+	// Nodes still being written are in the save graph but not in the journal yet, so they can't be relinked
+	FMSaveStorage& Storage = GetActiveStorage();
+	if (Storage.HasUncommittedNodes()) return false;
+
+	// 1. Select the nodes to remove, never the ones saveables are currently based on
+
+	TSet<FGuid> ProtectedIds = { ActiveSaveGame->MostRecentNodeId, ResolvedSaveId };
+	if (PendingRestore) ProtectedIds.Add(PendingRestore->SaveId);
+
+	TSet<FGuid> RemovedIds =
+		MSaveManager::SelectRemovedNodes(*ActiveSaveGame, ProtectedIds, *GetDefault<UMSaveSettings>());
+	if (RemovedIds.IsEmpty()) return false;
+
+	// 2. Relink the remaining nodes past them
+
+	TArray<FMSaveNodeMetadata> UpdatedNodes;
+	TArray<FGuid>			   RebasedIds;
+	MSaveManager::RelinkRemainingNodes(*ActiveSaveGame, RemovedIds, UpdatedNodes, RebasedIds);
+
+	UE_LOG(
+		LogMSaveManager,
+		Log,
+		TEXT("Compacting save graph - %s:%d (removing %d of %d nodes, rebasing %d)"),
+		*ActiveSaveGame->SlotName,
+		ActiveSaveGame->UserIndex,
+		RemovedIds.Num(),
+		ActiveSaveGame->SaveNodes.Num(),
+		RebasedIds.Num());
+
+	// 3. Rebase the nodes whose delta base is removed on a worker thread, then commit on the game thread
+
+	bCompactingSaveGraph = true;
+	UE::Tasks::TTask<bool> RebaseTask = Storage.LaunchRebaseNodes(RebasedIds, RemovedIds);
+	UE::Tasks::Launch(
+		UE_SOURCE_LOCATION,
+		[RebaseTask,
+		 Manager = TWeakObjectPtr<UMSaveManager>(this),
+		 SaveGame = TWeakObjectPtr<UMSaveGame>(ActiveSaveGame),
+		 RemovedIds = MoveTemp(RemovedIds),
+		 UpdatedNodes = MoveTemp(UpdatedNodes)]() mutable -> void {
+			AsyncTask(
+				ENamedThreads::GameThread,
+				[bRebased = RebaseTask.GetResult(),
+				 Manager,
+				 SaveGame,
+				 RemovedIds = MoveTemp(RemovedIds),
+				 UpdatedNodes = MoveTemp(UpdatedNodes)]() mutable -> void {
+					if (!Manager.IsValid()) return;
+
+					Manager->FinishCompactSaveGraph(
+						SaveGame.Get(), bRebased, MoveTemp(RemovedIds), MoveTemp(UpdatedNodes));
+				});
+		},
+		RebaseTask);
+
+	return true;
+}
+
+void UMSaveManager::FinishCompactSaveGraph(
+	UMSaveGame* SaveGame, bool bRebased, TSet<FGuid> RemovedIds, TArray<FMSaveNodeMetadata> UpdatedNodes)
+{
+	bCompactingSaveGraph = false;
+
+	// Rebased nodes are still valid against their original delta bases, so giving up here leaves the slot intact
+	if (!bRebased || !SaveGame || SaveGame != ActiveSaveGame)
+	{
+		UE_LOG(LogMSaveManager, Warning, TEXT("Skipped compacting save graph"));
+		return;
+	}
+
+	// 1. Make sure nothing saved or loaded in the meantime depends on a removed node
+
+	TMap<FGuid, const FMSaveNodeMetadata*> Updates;
+	for (const FMSaveNodeMetadata& Metadata : UpdatedNodes)
+	{
+		Updates.Add(Metadata.SaveId, &Metadata);
+	}
+
+	bool bStale = RemovedIds.Contains(ActiveSaveGame->MostRecentNodeId) || RemovedIds.Contains(ResolvedSaveId)
+			   || (PendingRestore && RemovedIds.Contains(PendingRestore->SaveId));
+	for (const TTuple<FGuid, FMSaveNodeMetadata>& Node : ActiveSaveGame->SaveNodes)
+	{
+		if (bStale) break;
+		if (RemovedIds.Contains(Node.Key)) continue;
+
+		const FMSaveNodeMetadata* Metadata = Updates.FindRef(Node.Key);
+		if (!Metadata) Metadata = &Node.Value;
+
+		bStale = RemovedIds.Contains(Metadata->BranchParentId) || RemovedIds.Contains(Metadata->SequenceParentId)
+			  || RemovedIds.Contains(Metadata->DeltaBaseId);
+	}
+
+	if (bStale)
+	{
+		UE_LOG(
+			LogMSaveManager,
+			Log,
+			TEXT("Skipped compacting save graph, it changed in the meantime - %s:%d"),
+			*ActiveSaveGame->SlotName,
+			ActiveSaveGame->UserIndex);
+		return;
+	}
+
+	// 2. Commit the removal along with the relinked nodes, in a single journal record. It applies right away, so
+	// nothing saved or loaded while it commits can depend on a removed node. Should the commit fail, the removed nodes
+	// are simply left in the slot, where they are still valid.
+
+	TArray<FMSaveJournalOp> JournalOps;
+	for (const FGuid& NodeId : RemovedIds)
+	{
+		JournalOps.Add(FMSaveJournalOp::NodeRemoved(NodeId));
+	}
+
+	for (const FMSaveNodeMetadata& Metadata : UpdatedNodes)
+	{
+		JournalOps.Add(FMSaveJournalOp::NodeUpdated(Metadata));
+	}
+
+	for (const FMSaveJournalOp& Op : JournalOps)
+	{
+		Op.ApplyTo(*ActiveSaveGame);
+	}
+
+	// 3. Drop cached nodes which were removed or rewritten, then notify
+
+	for (const FGuid& NodeId : RemovedIds)
+	{
+		PrefetchedNodes.Remove(NodeId);
+	}
+
+	for (const FMSaveNodeMetadata& Metadata : UpdatedNodes)
+	{
+		PrefetchedNodes.Remove(Metadata.SaveId);
+	}
+
+	SaveHistory->Initialize(ActiveSaveGame);
+	BroadcastNodesRemoved(RemovedIds.Array());
+
+	// 4. Reclaim their space in the background, once the removal is committed
+
+	TArray<FGuid> RemainingIds;
+	ActiveSaveGame->SaveNodes.GetKeys(RemainingIds);
+
+	TSharedRef<FMSaveStorage> Storage = GetActiveStorage().AsShared();
+	Storage->LaunchCommitJournal(
+		MoveTemp(JournalOps),
+		[Storage,
+		 RemovedIds = MoveTemp(RemovedIds),
+		 RemainingIds = MoveTemp(RemainingIds),
+		 Manager = TWeakObjectPtr<UMSaveManager>(this),
+		 SaveGame = TWeakObjectPtr<UMSaveGame>(SaveGame)](bool bCommitted) mutable -> void {
+			if (!bCommitted)
+			{
+				UE_LOG(LogMSaveManager, Warning, TEXT("Failed to commit save graph compaction"));
+				return;
+			}
+
+			UE::Tasks::TTask<bool> ReclaimTask =
+				Storage->LaunchReclaimNodes(MoveTemp(RemovedIds), MoveTemp(RemainingIds));
+			UE::Tasks::Launch(
+				UE_SOURCE_LOCATION,
+				[ReclaimTask, Manager, SaveGame]() mutable -> void {
+					AsyncTask(
+						ENamedThreads::GameThread,
+						[bSuccess = ReclaimTask.GetResult(), Manager, SaveGame]() -> void {
+							if (!bSuccess)
+								UE_LOG(LogMSaveManager, Warning, TEXT("Failed to reclaim removed save nodes"));
+
+							// The slot's size changed
+							if (Manager.IsValid() && SaveGame.IsValid()) Manager->UpdateSlotSummary(*SaveGame, false);
+						});
+				},
+				ReclaimTask);
+		});
+}
+
+UMSaveManager* UMSaveManager::Get(const UObject* WorldContextObject)
+{
+	if (!WorldContextObject) return nullptr;
+
+	UWorld* World = WorldContextObject->GetWorld();
+	if (!World) return nullptr;
+
+	UGameInstance* GameInstance = World->GetGameInstance();
+	return GameInstance ? GameInstance->GetSubsystem<UMSaveManager>() : nullptr;
+}
+
+void UMSaveManager::RegisterSaveable(UObject* Saveable)
+{
+	if (!Saveable) return;
+	if (!Saveable->Implements<UMSaveable>())
+	{
+		UE_LOG(LogMSaveManager, Warning, TEXT("Cannot register %s, it is not saveable"), *Saveable->GetName());
+		return;
+	}
+
+	if (SaveableObjectToIndex.Contains(Saveable))
+	{
+		RefreshSaveableId(Saveable);
+		return;
+	}
+
+	FString SaveId = IMSaveable::Execute_GetSaveId(Saveable);
+	if (const int32* ExistingIndex = SaveableIdToIndex.Find(SaveId))
+	{
+		// Stale entries are left behind by saveables that were garbage collected without unregistering
+		if (Saveables[*ExistingIndex].Object.IsValid())
+		{
+			UE_LOG(
+				LogMSaveManager,
+				Warning,
+				TEXT("Cannot register %s, save id %s is already used by %s"),
+				*Saveable->GetName(),
+				*SaveId,
+				*Saveables[*ExistingIndex].Object->GetName());
+			return;
+		}
+
+		RemoveSaveableAt(*ExistingIndex);
+	}
+
+	int32 Index = Saveables.Add({ Saveable, SaveId });
+	SaveableIdToIndex.Add(MoveTemp(SaveId), Index);
+	SaveableObjectToIndex.Add(Saveable, Index);
+}
+
+void UMSaveManager::UnregisterSaveable(UObject* Saveable)
+{
+	if (!Saveable) return;
+
+	const int32* Index = SaveableObjectToIndex.Find(Saveable);
+	if (!Index) return;
+
+	RemoveSaveableAt(*Index);
+}
+
+void UMSaveManager::RefreshSaveableId(UObject* Saveable)
+{
+	if (!Saveable) return;
+
+	const int32* Index = SaveableObjectToIndex.Find(Saveable);
+	if (!Index)
+	{
+		RegisterSaveable(Saveable);
+		return;
+	}
+
+	FString SaveId = IMSaveable::Execute_GetSaveId(Saveable);
+	if (Saveables[*Index].SaveId == SaveId) return;
+
+	// Re-register under the new save id, so that id collisions are handled consistently
+	RemoveSaveableAt(*Index);
+	RegisterSaveable(Saveable);
+}
+
+void UMSaveManager::MarkSaveableDirty(UObject* Saveable)
+{
+	const int32* Index = SaveableObjectToIndex.Find(Saveable);
+	if (Index) Saveables[*Index].ContentHash = FIoHash::Zero;
+}
+
+UObject* UMSaveManager::FindSaveable(const FString& SaveId) const
+{
+	const int32* Index = SaveableIdToIndex.Find(SaveId);
+	return Index ? Saveables[*Index].Object.Get() : nullptr;
+}
+
+void UMSaveManager::RemoveSaveableAt(int32 Index)
+{
+	FMRegisteredSaveable& Removed = Saveables[Index];
+	SaveableIdToIndex.Remove(Removed.SaveId);
+	SaveableObjectToIndex.Remove(Removed.Object);
+
+	// Swap the last saveable into the freed index to keep the array dense
+	int32 LastIndex = Saveables.Num() - 1;
+	if (Index != LastIndex)
+	{
+		FMRegisteredSaveable& Moved = Saveables[LastIndex];
+		SaveableIdToIndex.Add(Moved.SaveId, Index);
+		SaveableObjectToIndex.Add(Moved.Object, Index);
+	}
+
+	Saveables.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+}
+
+TSharedRef<const TSet<FString>> UMSaveManager::GetRegisteredSaveableIds() const
+{
+	TSharedRef<TSet<FString>> SaveableIds = MakeShared<TSet<FString>>();
+	SaveableIdToIndex.GetKeys(*SaveableIds);
+	return SaveableIds;
+}
+
+FMSaveStorage& UMSaveManager::GetActiveStorage()
+{
+	checkf(ActiveSaveGame, TEXT("A save slot must be created/loaded before accessing its storage."));
+
+	if (!ActiveStorage || ActiveStorage->GetSlotName() != ActiveSaveGame->SlotName
+		|| ActiveStorage->GetUserIndex() != ActiveSaveGame->UserIndex)
+		ActiveStorage = FMSaveStorage::Open(ActiveSaveGame->SlotName, ActiveSaveGame->UserIndex);
+
+	return *ActiveStorage;
+}
+
+void UMSaveManager::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	FWorldDelegates::LevelAddedToWorld.AddUObject(this, &UMSaveManager::OnLevelAddedToWorld);
+	FWorldDelegates::PreLevelRemovedFromWorld.AddUObject(this, &UMSaveManager::OnPreLevelRemovedFromWorld);
+	FWorldDelegates::OnWorldCleanup.AddUObject(this, &UMSaveManager::OnWorldCleanup);
+
+	if (!UGameplayStatics::DoesSaveGameExist(TEXT("SaveIndex"), 0))
+	{
+		UMSaveIndex* Index = Cast<UMSaveIndex>(UGameplayStatics::CreateSaveGameObject(UMSaveIndex::StaticClass()));
+		FAsyncSaveGameToSlotDelegate Delegate = FAsyncSaveGameToSlotDelegate::CreateLambda(
+			[Index, this](const FString& SlotName, int32 UserIndex, bool bSuccess) -> void {
+				if (bSuccess)
+					SaveIndex = Index;
+				else
+					UE_LOG(LogMSaveManager, Warning, TEXT("Failed to create SaveIndex"));
+			});
+		UGameplayStatics::AsyncSaveGameToSlot(Index, TEXT("SaveIndex"), 0, MoveTemp(Delegate));
+	}
+	else
+	{
+		FAsyncLoadGameFromSlotDelegate Delegate = FAsyncLoadGameFromSlotDelegate::CreateLambda(
+			[this](const FString& SlotName, int32 UserIndex, USaveGame* SaveGame) -> void {
+				UMSaveIndex* Index = Cast<UMSaveIndex>(SaveGame);
 				if (Index)
 				{
 					SaveIndex = Index;
@@ -663,33 +1417,39 @@ void UMSaveManager::Initialize(FSubsystemCollectionBase& Collection)
 void UMSaveManager::Deinitialize()
 {
 	OnSaveSlotUpdated.RemoveAll(this);
+	OnSaveGraphChanged.RemoveAll(this);
+	ReleasePrefetchedNodes();
+	FWorldDelegates::LevelAddedToWorld.RemoveAll(this);
+	FWorldDelegates::PreLevelRemovedFromWorld.RemoveAll(this);
+	FWorldDelegates::OnWorldCleanup.RemoveAll(this);
+	CancelRestore();
+	ActorPool.Reset();
+	DeferredSaveData.Reset();
+
+	Saveables.Reset();
+	SaveableIdToIndex.Reset();
+	SaveableObjectToIndex.Reset();
+
+	// Releasing the storage lets the pack file write its index
+	if (SaveHistory) SaveHistory->Initialize(nullptr);
+	ActiveStorage.Reset();
+	ResolvedSaveData.Reset();
+	ResolvedSaveNode.Reset();
 
 	Super::Deinitialize();
 }
 
-void UMSaveManager::FindSaveables(TArray<UObject*>& OutSaveables) const
+UMSaveNode* UMSaveManager::CreateSaveNode(
+	FGuid													   BranchParentId,
+	FGuid													   SequenceParentId,
+	bool													   bRecall,
+	bool													   bInvisible,
+	UE::Tasks::TTask<bool>&									   OutWriteTask,
+	TUniqueFunction<void(UMSaveNode* SaveNode, bool bSuccess)> OnWritten)
 {
-	UWorld* World = GetWorld();
-	if (!World) return;
-
-	for (TActorIterator<AActor> It(World); It; ++It)
-	{
-		AActor* Actor = *It;
-
-		if (Actor->IsPendingKillPending()) continue;
-
-		if (Actor->Implements<UMSaveable>()) OutSaveables.Add(Actor);
-
-		// Components may also be saveable
-		for (UActorComponent* Component : Actor->GetComponents())
-		{
-			if (Component->Implements<UMSaveable>()) OutSaveables.Add(Component);
-		}
-	}
-}
+	// Capturing a partially restored world would save a state which never existed
+	FinishRestore();
 
-UMSaveNode* UMSaveManager::CreateSaveNode(FGuid BranchParentId, FGuid SequenceParentId, bool bRecall, bool bInvisible)
-{
 	FGuid SaveId = FGuid::NewGuid();
 
 	UMSaveNode* SaveNode = Cast<UMSaveNode>(UGameplayStatics::CreateSaveGameObject(UMSaveNode::StaticClass()));
@@ -702,120 +1462,1120 @@ UMSaveNode* UMSaveManager::CreateSaveNode(FGuid BranchParentId, FGuid SequencePa
 	Metadata.Timestamp = FDateTime::UtcNow();
 	Metadata.bInvisible = bInvisible;
 
-	ActiveSaveGame->SaveNodes.Add(SaveId, Metadata);
+	// Saveables may query the history while saving, so the node must already be part of the graph
+	FMSaveNodeMetadata& NodeMetadata = ActiveSaveGame->AddSaveNode(Metadata);
 	ActiveSaveGame->MostRecentNodeId = SaveId;
 
-	UE_LOG(
-		LogMSaveManager,
-		Log,
-		TEXT("Created save node - %s:%d (%s)"),
-		*ActiveSaveGame->SlotName,
-		ActiveSaveGame->UserIndex,
-		*SaveId.ToString());
+	// 1. Capture the raw state of every saveable. This is the only part of saving which touches the world.
+
+	const UMSaveSettings* Settings = GetDefault<UMSaveSettings>();
+	double				  CaptureStartTime = FPlatformTime::Seconds();
 
-	TArray<UObject*> Saveables;
-	FindSaveables(Saveables);
+	TSharedRef<TMap<FString, FMSaveData>> CapturedSaveData = MakeShared<TMap<FString, FMSaveData>>();
+	CapturedSaveData->Reserve(Saveables.Num());
 
-	for (UObject* Saveable : Saveables)
+	for (const FMRegisteredSaveable& Registered : Saveables)
 	{
+		UObject* Saveable = Registered.Object.Get();
 		if (!Saveable) continue;
 
 		FMSaveData SaveData;
-		SaveData.ClassName = Saveable->GetClass()->GetPathName();
-		SaveData.ActorFName = Saveable->GetFName();
+		CaptureSaveable(Saveable, bRecall, SaveData);
+		CapturedSaveData->Add(Registered.SaveId, MoveTemp(SaveData));
+	}
+	CapturedSaveId = SaveId;
 
-		AActor* Actor = Cast<AActor>(Saveable);
-		if (Actor) SaveData.Transform = Actor->GetActorTransform();
+	// Saveables of partitions which are not streamed in keep their last known state, rather than being dropped
+	for (const TTuple<FName, TMap<FString, FMSaveData>>& Partition : DeferredSaveData)
+	{
+		for (const TTuple<FString, FMSaveData>& Entry : Partition.Value)
+		{
+			if (!CapturedSaveData->Contains(Entry.Key)) CapturedSaveData->Add(Entry);
+		}
+	}
 
-		FMemoryWriter					   Writer(SaveData.Data, true);
-		FObjectAndNameAsStringProxyArchive Archive(Writer, true);
-		Archive.ArIsSaveGame = true; // Serialize all properties marked as SaveGame
-		Archive.ArNoDelta = true;	 // Blueprint properties don't serialize consistently without this
-		Saveable->Serialize(Archive);
+	double CaptureTimeMs = (FPlatformTime::Seconds() - CaptureStartTime) * 1000.0;
+	if (CaptureTimeMs > Settings->CaptureBudgetMs)
+	{
+		UE_LOG(
+			LogMSaveManager,
+			Warning,
+			TEXT("Capturing %d saveables took %.2fms, over the %.2fms budget"),
+			CapturedSaveData->Num(),
+			CaptureTimeMs,
+			Settings->CaptureBudgetMs);
+	}
+
+	// 2. Store only what changed since the sequence parent, unless a keyframe is due. A delta base which is not
+	// resolved yet is resolved on a worker thread like a prefetch, only diffing against it has to wait for it.
+
+	const FMSaveNodeMetadata* DeltaBase = ActiveSaveGame->SaveNodes.Find(NodeMetadata.SequenceParentId);
 
-		IMSaveable* NativeSaveable = Cast<IMSaveable>(Saveable);
-		if (NativeSaveable && NativeSaveable->RequiresCustomSerialization())
-			NativeSaveable->Save(Writer, bRecall, SaveHistory);
+	bool bDelta = Settings->bDeltaNodes && DeltaBase && DeltaBase->DeltaDepth + 1 < Settings->KeyframeInterval;
 
-		SaveNode->SaveData.Add(IMSaveable::Execute_GetSaveId(Saveable), MoveTemp(SaveData));
+	FMSaveStorage::FResolveTask BaseTask;
+	if (bDelta)
+	{
+		if (ResolvedSaveData && ResolvedSaveId == DeltaBase->SaveId)
+			BaseTask = UE::Tasks::MakeCompletedTask<TSharedPtr<const TMap<FString, FMSaveData>>>(ResolvedSaveData);
+		else if (StartPrefetch(DeltaBase->SaveId, /* bWarm = */ true))
+			BaseTask = PrefetchedNodes[DeltaBase->SaveId].Task;
+
+		SaveNode->DeltaBaseId = DeltaBase->SaveId;
+		NodeMetadata.DeltaBaseId = DeltaBase->SaveId;
+		NodeMetadata.DeltaDepth = DeltaBase->DeltaDepth + 1;
 	}
 
-	return SaveNode;
-}
+	// The captured state is the effective state of the new node, so keep it around for the next delta
+	RetireResolvedNode();
+	ResolvedSaveData = CapturedSaveData;
+	ResolvedSaveId = SaveId;
+	ResolvedSaveNode.Reset(SaveNode);
+
+	// 3. Diff, chunk, hash, encode and write the node on worker threads
+
+	FString SlotName = ActiveSaveGame->SlotName;
+	int32	UserIndex = ActiveSaveGame->UserIndex;
+
+	// Adding the node and making it the most recent one commit together, in a single journal record
+	TArray<FMSaveJournalOp> JournalOps;
+	JournalOps.Add(FMSaveJournalOp::NodeAdded(NodeMetadata));
+	JournalOps.Add(FMSaveJournalOp::MostRecentChanged(SaveId));
+
+	OutWriteTask = GetActiveStorage().LaunchSaveNode(
+		SaveNode,
+		ActiveSaveGame->Compression,
+		[CapturedSaveData, BaseTask, SlotName, UserIndex](UMSaveNode& AssembledNode) mutable -> void {
+			// A delta base which could not be resolved (e.g. a legacy node, which is only decoded on the game thread)
+			// leaves nothing to diff against, so the node becomes a keyframe
+			TSharedPtr<const TMap<FString, FMSaveData>> BaseSaveData;
+			if (BaseTask.IsValid()) BaseSaveData = BaseTask.GetResult();
+			if (!BaseSaveData && !AssembledNode.IsKeyframe())
+			{
+				UE_LOG(
+					LogMSaveManager,
+					Log,
+					TEXT("Could not resolve delta base %s, saving %s as a keyframe"),
+					*AssembledNode.DeltaBaseId.ToString(),
+					*AssembledNode.SaveId.ToString());
+				AssembledNode.DeltaBaseId.Invalidate();
+			}
 
-UMSaveNode* UMSaveManager::CloneSaveNode(const UMSaveNode* OriginalSaveNode)
-{
-	if (!OriginalSaveNode) return nullptr;
+			MSaveManager::AssembleSaveNode(AssembledNode, *CapturedSaveData, BaseSaveData.Get());
+			MSaveManager::HashSaveData(*CapturedSaveData, AssembledNode.ContentHashes);
 
-	UMSaveNode* SaveNode = Cast<UMSaveNode>(UGameplayStatics::CreateSaveGameObject(UMSaveNode::StaticClass()));
-	SaveNode->SaveId = OriginalSaveNode->SaveId;
-	SaveNode->SaveData = OriginalSaveNode->SaveData;
+			UE_LOG(
+				LogMSaveManager,
+				Log,
+				TEXT("Created save node - %s:%d (%s, %s with %d/%d entries)"),
+				*SlotName,
+				UserIndex,
+				*AssembledNode.SaveId.ToString(),
+				AssembledNode.IsKeyframe() ? TEXT("keyframe") : TEXT("delta"),
+				AssembledNode.SaveData.Num(),
+				CapturedSaveData->Num());
+		},
+		BaseTask,
+		MoveTemp(JournalOps),
+		MoveTemp(OnWritten));
 
 	return SaveNode;
 }
 
-bool UMSaveManager::LoadSaveNode(UMSaveNode* SaveNode, bool bRecall)
+bool UMSaveManager::FinishSaveNode(UMSaveNode* SaveNode, bool bCommitted)
 {
-	if (!SaveNode) return false;
+	if (!SaveNode || !ActiveSaveGame) return false;
 
-	TArray<UObject*> Saveables;
-	FindSaveables(Saveables);
-
-	for (UObject* Saveable : Saveables)
+	if (bCommitted)
 	{
-		if (!Saveable) continue;
+		const UMSaveSettings* Settings = GetDefault<UMSaveSettings>();
+		FMSaveStorage&		  Storage = GetActiveStorage();
 
-		// TODO: Store a hash map of SaveId -> Saveable to avoid O(n^2) search
-		FMSaveData* SaveData = SaveNode->SaveData.Find(IMSaveable::Execute_GetSaveId(Saveable));
-		// TODO: create runtime-generated objects if they don't exist
-		if (!SaveData) continue;
+		// Recorded after the journal, since the timeline can always be backfilled from the committed nodes
+		Storage.GetTimeline().Append(SaveNode->SaveId, SaveNode->ContentHashes);
 
-		UE_LOG(LogMSaveManager, Log, TEXT("  Loading saveable - %s"), *Saveable->GetName());
+		// The node may have been committed as a keyframe after all, if its delta base could not be resolved
+		const FMSaveNodeMetadata* Metadata = ActiveSaveGame->SaveNodes.Find(SaveNode->SaveId);
+		if (Metadata && SaveNode->IsKeyframe() && Metadata->DeltaBaseId.IsValid())
+		{
+			FMSaveNodeMetadata Keyframe = *Metadata;
+			Keyframe.DeltaBaseId.Invalidate();
+			Keyframe.DeltaDepth = 0;
+			ActiveSaveGame->AddSaveNode(Keyframe);
+		}
 
-		AActor* Actor = Cast<AActor>(Saveable);
-		if (Actor) Actor->SetActorTransform(SaveData->Transform);
+		// Saveables were last captured with these hashes, unless anything was saved or loaded since
+		if (CapturedSaveId == SaveNode->SaveId)
+		{
+			for (const TTuple<FString, FIoHash>& Entry : SaveNode->ContentHashes)
+			{
+				const int32* Index = SaveableIdToIndex.Find(Entry.Key);
+				if (Index) Saveables[*Index].ContentHash = Entry.Value;
+			}
+		}
+		SaveNode->ContentHashes.Empty();
 
-		FMemoryReader					   Reader(SaveData->Data, true);
-		FObjectAndNameAsStringProxyArchive Archive(Reader, true);
-		Archive.ArIsSaveGame = true; // Serialize all properties marked as SaveGame
-		Archive.ArNoDelta = true;	 // Blueprint properties don't serialize consistently without this
-		Saveable->Serialize(Archive);
+		SaveHistory->CacheSaveNode(SaveNode);
+		Storage.CompactJournal(*ActiveSaveGame, Settings->JournalCompactionThreshold);
+		Storage.TrainDictionary(SaveNode->Stats.Compression, Settings->DictionaryTrainingInterval);
 
-		IMSaveable* NativeSaveable = Cast<IMSaveable>(Saveable);
-		if (NativeSaveable && NativeSaveable->RequiresCustomSerialization())
-			NativeSaveable->Load(Reader, bRecall, SaveHistory);
-	}
+		if (Settings->CompactionInterval > 0 && ++NodesSinceCompaction >= Settings->CompactionInterval)
+		{
+			NodesSinceCompaction = 0;
+			CompactSaveGraph();
+		}
 
-	return true;
-}
+		return true;
+	}
 
-void UMSaveManager::DeleteSaveGraph(UMSaveGame* SaveGame)
-{
-	if (!SaveGame) return;
+	// The node never reached the journal, so it must not stay in the save graph either
+	UE_LOG(
+		LogMSaveManager,
+		Warning,
+		TEXT("Failed to commit save node - %s:%d (%s)"),
+		*ActiveSaveGame->SlotName,
+		ActiveSaveGame->UserIndex,
+		*SaveNode->SaveId.ToString());
 
-	for (const TTuple<FGuid, FMSaveNodeMetadata>& SaveNode : SaveGame->SaveNodes)
+	FMSaveNodeMetadata Metadata;
+	if (ActiveSaveGame->RemoveSaveNode(SaveNode->SaveId, &Metadata))
 	{
-		FString SlotName = SaveGame->SlotName + SaveNode.Key.ToString();
-		bool	bSuccess = UGameplayStatics::DeleteGameInSlot(SlotName, SaveGame->UserIndex);
-		if (bSuccess)
+		if (ActiveSaveGame->MostRecentNodeId == SaveNode->SaveId)
+			ActiveSaveGame->MostRecentNodeId = Metadata.SequenceParentId;
+
+		// Nodes saved on top of it are still in flight and fail along with it. Link them past it until then, so rolling
+		// them back lands on a node which is still in the save graph.
+		TArray<FMSaveNodeMetadata> Dependents;
+		for (const TTuple<FGuid, FMSaveNodeMetadata>& Node : ActiveSaveGame->SaveNodes)
 		{
-			UE_LOG(
-				LogMSaveManager,
-				Log,
-				TEXT("  Deleting save node - %s:%d (%s)"),
-				*SaveGame->SlotName,
-				SaveGame->UserIndex,
-				*SaveNode.Key.ToString());
+			if (Node.Value.BranchParentId == Metadata.SaveId || Node.Value.SequenceParentId == Metadata.SaveId)
+				Dependents.Add(Node.Value);
 		}
-		else
+
+		for (FMSaveNodeMetadata& Dependent : Dependents)
 		{
-			UE_LOG(
+			if (Dependent.BranchParentId == Metadata.SaveId) Dependent.BranchParentId = Metadata.BranchParentId;
+			if (Dependent.SequenceParentId == Metadata.SaveId) Dependent.SequenceParentId = Metadata.SequenceParentId;
+			ActiveSaveGame->AddSaveNode(Dependent);
+		}
+	}
+
+	if (ResolvedSaveId == SaveNode->SaveId)
+	{
+		ResolvedSaveData.Reset();
+		ResolvedSaveId.Invalidate();
+		ResolvedSaveNode.Reset();
+	}
+
+	// It may have been kept around as the parent of a node saved on top of it, see RetireResolvedNode
+	PrefetchedNodes.Remove(SaveNode->SaveId);
+
+	return false;
+}
+
+bool UMSaveManager::LoadSaveNode(UMSaveNode* SaveNode, bool bRecall)
+{
+	if (!SaveNode) return false;
+
+	// 1. Resolve the effective save data of the node, reusing the cached save data where possible
+
+	// The cached save data can't be reused if it omitted a saveable which has been registered since
+	TSharedRef<const TSet<FString>> SaveableIds = GetRegisteredSaveableIds();
+	bool bCacheUsable = ResolvedSaveData && !MSaveManager::HasOmittedSaveData(*ResolvedSaveData, *SaveableIds);
+
+	TSharedPtr<const TMap<FString, FMSaveData>> EffectiveSaveData;
+	if (bCacheUsable && SaveNode->SaveId == ResolvedSaveId)
+	{
+		EffectiveSaveData = ResolvedSaveData;
+	}
+	else if (bCacheUsable && !SaveNode->IsKeyframe() && SaveNode->DeltaBaseId == ResolvedSaveId)
+	{
+		// Loading a direct delta child of the cached node only requires applying one delta
+		TSharedRef<TMap<FString, FMSaveData>> AppliedSaveData =
+			MakeShared<TMap<FString, FMSaveData>>(*ResolvedSaveData);
+		SaveNode->ApplyTo(*AppliedSaveData);
+		EffectiveSaveData = AppliedSaveData;
+	}
+	else if (FMPrefetchedNode* Prefetched = FindPrefetchedNode(SaveNode->SaveId, *SaveableIds))
+	{
+		// Prefetched nodes were already resolved on a worker thread
+		EffectiveSaveData = Prefetched->Task.GetResult();
+		PrefetchedNodes.Remove(SaveNode->SaveId);
+	}
+	else
+	{
+		auto GetSaveNode = [this, SaveNode, &SaveableIds](const FGuid& NodeId) -> UMSaveNode* {
+			if (NodeId == SaveNode->SaveId) return SaveNode;
+			return GetActiveStorage().LoadNode(NodeId, &SaveableIds.Get());
+		};
+
+		TSharedRef<TMap<FString, FMSaveData>> ReplayedSaveData = MakeShared<TMap<FString, FMSaveData>>();
+		if (!FMSaveStorage::ResolveSaveData(SaveNode->SaveId, GetSaveNode, *ReplayedSaveData)) return false;
+		EffectiveSaveData = ReplayedSaveData;
+	}
+
+	// 2. Apply the save data to the saveables, right away or spread across frames. Recalls save right after loading,
+	// so they are always applied right away.
+
+	// A restore still in progress is superseded, its saveables which were not applied yet simply keep their state
+	CancelRestore();
+	CapturedSaveId.Invalidate();
+
+	// Every saveable is read again, recording its unresolved references again
+	UnresolvedReferences.Reset();
+
+	const UMSaveSettings* Settings = GetDefault<UMSaveSettings>();
+	bool				  bProgressive = Settings->bProgressiveRestore && !bRecall;
+
+	PendingRestore = MakeShared<FMPendingRestore>();
+	PendingRestore->SaveId = SaveNode->SaveId;
+	PendingRestore->SaveData = EffectiveSaveData;
+	PendingRestore->bRecall = bRecall;
+
+	// Hashing the loaded state is far cheaper than applying it, and lets unchanged saveables be skipped
+	if (Settings->bDiffRestore) MSaveManager::HashSaveData(*EffectiveSaveData, PendingRestore->ContentHashes);
+
+	// Save data of partitions which are not streamed in waits for them instead, see OnLevelAddedToWorld
+	GetResidentPartitions(PendingRestore->ResidentPartitions);
+	DeferredSaveData.Reset();
+	for (const TTuple<FString, FMSaveData>& Entry : *EffectiveSaveData)
+	{
+		if (!Entry.Value.bOmitted && !PendingRestore->IsResident(Entry.Value))
+			DeferredSaveData.FindOrAdd(Entry.Value.Partition).Add(Entry);
+	}
+
+	ReconcileSpawnedActors(*PendingRestore);
+	BuildRestoreOrder(*PendingRestore, bProgressive);
+
+	if (bProgressive)
+	{
+		// The first slice runs right away, so the player is in place before the next frame is rendered
+		if (TickRestore(0.0f))
+		{
+			RestoreTickerHandle =
+				FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &UMSaveManager::TickRestore));
+		}
+	}
+	else
+	{
+		FinishRestore();
+	}
+
+	// Recalls immediately save a new node on top of the current one, so keep the current node cached instead
+	if (!bRecall)
+	{
+		ResolvedSaveData = MoveTemp(EffectiveSaveData);
+		ResolvedSaveId = SaveNode->SaveId;
+		ResolvedSaveNode.Reset(SaveNode);
+	}
+
+	return true;
+}
+
+void UMSaveManager::BuildRestoreOrder(FMPendingRestore& Restore, bool bPrioritize) const
+{
+	Restore.Order.Reserve(Restore.SaveData->Num());
+	for (const TTuple<FString, FMSaveData>& Entry : *Restore.SaveData)
+	{
+		if (!Entry.Value.bOmitted && Restore.IsResident(Entry.Value) && !Restore.SpawnedIds.Contains(Entry.Key))
+			Restore.Order.Add(&Entry);
+	}
+
+	Restore.NumCritical = Restore.Order.Num();
+	if (!bPrioritize) return;
+
+	// 1. Find the player, and where it is about to be
+
+	APlayerController* PlayerController = GetGameInstance()->GetFirstLocalPlayerController();
+	APawn*			   Pawn = PlayerController ? PlayerController->GetPawn() : nullptr;
+	FVector			   Origin = Pawn ? Pawn->GetActorLocation() : FVector::ZeroVector;
+
+	for (const TTuple<FString, FMSaveData>* Entry : Restore.Order)
+	{
+		if (Pawn && FindSaveable(Entry->Key) == Pawn) Origin = Entry->Value.Transform.GetLocation();
+	}
+
+	// 2. Order saveables by tier (player, around the player, further away, not in the world), then by distance
+
+	const double CriticalRadius = GetDefault<UMSaveSettings>()->RestoreCriticalRadius;
+
+	TMap<const TTuple<FString, FMSaveData>*, TTuple<int32, double>> Priorities;
+	Priorities.Reserve(Restore.Order.Num());
+	for (const TTuple<FString, FMSaveData>* Entry : Restore.Order)
+	{
+		UObject* Saveable = FindSaveable(Entry->Key);
+		if (Saveable && (Saveable == Pawn || Saveable == PlayerController))
+		{
+			Priorities.Add(Entry, { 0, 0.0 });
+			continue;
+		}
+
+		// Actors are about to move to their saved transform, components stay with their owner
+		AActor*			 Actor = Cast<AActor>(Saveable);
+		UActorComponent* Component = Cast<UActorComponent>(Saveable);
+		AActor*			 Owner = Component ? Component->GetOwner() : nullptr;
+		if (!Actor && !Owner)
+		{
+			Priorities.Add(Entry, { 3, 0.0 });
+			continue;
+		}
+
+		FVector Location = Actor ? Entry->Value.Transform.GetLocation() : Owner->GetActorLocation();
+		double	Distance = FVector::Dist(Origin, Location);
+		Priorities.Add(Entry, { Pawn && Distance <= CriticalRadius ? 1 : 2, Distance });
+	}
+
+	Algo::SortBy(Restore.Order, [&Priorities](const TTuple<FString, FMSaveData>* Entry) -> TTuple<int32, double> {
+		return Priorities[Entry];
+	});
+
+	// The player and everything around it make up the critical set
+	Restore.NumCritical = 0;
+	while (Restore.NumCritical < Restore.Order.Num() && Priorities[Restore.Order[Restore.NumCritical]].Key <= 1)
+	{
+		++Restore.NumCritical;
+	}
+}
+
+bool UMSaveManager::TickRestore(float DeltaTime)
+{
+	if (!PendingRestore) return false;
+
+	// At least one saveable is restored every frame, so restoring always makes progress
+	double Deadline = FPlatformTime::Seconds() + GetDefault<UMSaveSettings>()->RestoreBudgetMs / 1000.0;
+	do
+	{
+		RestoreNextSaveable();
+	}
+	while (PendingRestore && !PendingRestore->IsDone() && FPlatformTime::Seconds() < Deadline);
+
+	// References read into containers are only patchable in this frame, so they can't wait for the restore to finish
+	ResolveUnresolvedReferences();
+
+	if (PendingRestore && !PendingRestore->IsDone()) return true;
+
+	// Returning false removes the ticker, so it must not be removed again
+	RestoreTickerHandle.Reset();
+	FinishRestore();
+	return false;
+}
+
+void UMSaveManager::RestoreNextSaveable()
+{
+	// Saveables may load another node while being restored, which replaces the pending restore
+	TSharedRef<FMPendingRestore> Restore = PendingRestore.ToSharedRef();
+
+	if (!Restore->IsDone())
+	{
+		const TTuple<FString, FMSaveData>& Entry = *Restore->Order[Restore->NextIndex++];
+		const FIoHash*					   ContentHash = Restore->ContentHashes.Find(Entry.Key);
+
+		if (ApplySaveable(Entry.Key, Entry.Value, ContentHash, Restore->bRecall)) ++Restore->NumApplied;
+		else ++Restore->NumSkipped;
+	}
+
+	if (PendingRestore == Restore && !Restore->bGameplayReady && Restore->NextIndex >= Restore->NumCritical)
+	{
+		Restore->bGameplayReady = true;
+		OnRestoreGameplayReady.Broadcast(Restore->SaveId);
+	}
+}
+
+void UMSaveManager::FinishRestore()
+{
+	while (PendingRestore && !PendingRestore->IsDone())
+	{
+		RestoreNextSaveable();
+	}
+
+	if (!PendingRestore) return;
+
+	// Every saveable of the node is registered by now, including spawned ones
+	ResolveUnresolvedReferences();
+
+	if (PendingRestore->NumSkipped > 0)
+	{
+		UE_LOG(
+			LogMSaveManager,
+			Log,
+			TEXT("  Restored %d saveables, skipped %d unchanged saveables"),
+			PendingRestore->NumApplied,
+			PendingRestore->NumSkipped);
+	}
+
+	if (RestoreTickerHandle.IsValid()) FTSTicker::GetCoreTicker().RemoveTicker(RestoreTickerHandle);
+	RestoreTickerHandle.Reset();
+
+	// Reset before broadcasting, listeners may load another node
+	TSharedPtr<FMPendingRestore> Restore = MoveTemp(PendingRestore);
+	if (!Restore->bGameplayReady) OnRestoreGameplayReady.Broadcast(Restore->SaveId);
+	OnRestoreCompleted.Broadcast(Restore->SaveId);
+}
+
+void UMSaveManager::CancelRestore()
+{
+	if (!PendingRestore) return;
+
+	UE_LOG(
+		LogMSaveManager,
+		Log,
+		TEXT("  Cancelled restoring %d saveables (%s)"),
+		PendingRestore->Order.Num() - PendingRestore->NextIndex,
+		*PendingRestore->SaveId.ToString());
+
+	if (RestoreTickerHandle.IsValid()) FTSTicker::GetCoreTicker().RemoveTicker(RestoreTickerHandle);
+	RestoreTickerHandle.Reset();
+	PendingRestore.Reset();
+}
+
+bool UMSaveManager::ApplySaveable(
+	const FString& SaveId, const FMSaveData& SaveData, const FIoHash* ContentHash, bool bRecall)
+{
+	const int32* Index = SaveableIdToIndex.Find(SaveId);
+	UObject*	 Saveable = Index ? Saveables[*Index].Object.Get() : nullptr;
+	// Missing spawned actors were already spawned by ReconcileSpawnedActors
+	if (!Saveable) return false;
+
+	if (ContentHash && IsSaveableUnchanged(Saveables[*Index], *ContentHash, bRecall)) return false;
+
+	UE_LOG(LogMSaveManager, Log, TEXT("  Loading saveable - %s"), *Saveable->GetName());
+	ReadSaveable(Saveable, SaveData, bRecall);
+
+	// Loading may have registered or unregistered other saveables, so the index can't be reused
+	Index = SaveableIdToIndex.Find(SaveId);
+	if (Index) Saveables[*Index].ContentHash = ContentHash ? *ContentHash : FIoHash::Zero;
+
+	return true;
+}
+
+void UMSaveManager::ReconcileSpawnedActors(FMPendingRestore& Restore)
+{
+	const TMap<FString, FMSaveData>& SaveData = *Restore.SaveData;
+
+	// 1. Retire spawned actors which don't exist in the loaded node. Retiring unregisters them, so collect them first.
+
+	TArray<AActor*> ExtraActors;
+	for (const FMRegisteredSaveable& Registered : Saveables)
+	{
+		AActor* Actor = Cast<AActor>(Registered.Object.Get());
+		if (MSaveManager::IsSpawnedActor(Actor) && !SaveData.Contains(Registered.SaveId)) ExtraActors.Add(Actor);
+	}
+
+	for (AActor* Actor : ExtraActors)
+	{
+		RetireActor(Actor);
+	}
+
+	// 2. Group the spawned actors missing from the world by class
+
+	TMap<FString, TArray<const TTuple<FString, FMSaveData>*>> MissingActors;
+	for (const TTuple<FString, FMSaveData>& Entry : SaveData)
+	{
+		const FMSaveData& Data = Entry.Value;
+		if (Data.bSpawned && !Data.bOmitted && Restore.IsResident(Data) && !FindSaveable(Entry.Key))
+			MissingActors.FindOrAdd(Data.ClassName).Add(&Entry);
+	}
+
+	// 3. Spawn them one class at a time, so each class is only resolved once
+
+	int32 NumSpawned = 0;
+	for (const TTuple<FString, TArray<const TTuple<FString, FMSaveData>*>>& ClassActors : MissingActors)
+	{
+		UClass* Class = FSoftClassPath(ClassActors.Key).TryLoadClass<AActor>();
+		if (!Class)
+		{
+			UE_LOG(
 				LogMSaveManager,
 				Warning,
-				TEXT("  Failed to delete save node - %s:%d (%s)"),
-				*SaveGame->SlotName,
-				SaveGame->UserIndex,
-				*SaveNode.Key.ToString());
+				TEXT("  Cannot spawn %d saveables, class %s was not found"),
+				ClassActors.Value.Num(),
+				*ClassActors.Key);
+			continue;
+		}
+
+		for (const TTuple<FString, FMSaveData>* Entry : ClassActors.Value)
+		{
+			AActor* Actor = SpawnSaveable(Class, Entry->Value, Restore.bRecall);
+			if (!Actor) continue;
+
+			// Saveables register themselves in BeginPlay, which reused actors don't go through again
+			if (FindSaveable(Entry->Key) != Actor) RegisterSaveable(Actor);
+			if (FindSaveable(Entry->Key) != Actor)
+			{
+				UE_LOG(
+					LogMSaveManager,
+					Warning,
+					TEXT("  Spawned %s, but it did not register with save id %s, retiring it"),
+					*Actor->GetName(),
+					*Entry->Key);
+
+				// Left in the world, it would be saved under its own id next to the one it was spawned for
+				RetireActor(Actor);
+				continue;
+			}
+
+			const FIoHash* ContentHash = Restore.ContentHashes.Find(Entry->Key);
+			Saveables[SaveableIdToIndex[Entry->Key]].ContentHash = ContentHash ? *ContentHash : FIoHash::Zero;
+			Restore.SpawnedIds.Add(Entry->Key);
+			++NumSpawned;
+		}
+	}
+
+	if (NumSpawned > 0 || ExtraActors.Num() > 0)
+		UE_LOG(LogMSaveManager, Log, TEXT("  Spawned %d and retired %d saveables"), NumSpawned, ExtraActors.Num());
+
+	// References read into containers are only patchable in this frame, and the restore may only finish frames later
+	ResolveUnresolvedReferences();
+}
+
+AActor* UMSaveManager::SpawnSaveable(UClass* Class, const FMSaveData& SaveData, bool bRecall)
+{
+	// 1. Reuse the retired actor with the same name in the same partition, which is the very same actor. Any other
+	// actor would keep its own name, and so register with a different save id.
+
+	AActor*							Actor = nullptr;
+	TArray<TWeakObjectPtr<AActor>>* Pool = ActorPool.Find(Class);
+	if (Pool)
+	{
+		Pool->RemoveAll([](const TWeakObjectPtr<AActor>& Pooled) -> bool { return !Pooled.IsValid(); });
+
+		int32 Index = Pool->IndexOfByPredicate([&SaveData](const TWeakObjectPtr<AActor>& Pooled) -> bool {
+			return Pooled->GetFName() == SaveData.ActorFName
+				&& MSaveManager::GetLevelPartition(Pooled->GetLevel()) == SaveData.Partition;
+		});
+
+		if (Index != INDEX_NONE)
+		{
+			Actor = (*Pool)[Index].Get();
+			Pool->RemoveAt(Index, 1, EAllowShrinking::No);
+		}
+	}
+
+	if (Actor)
+	{
+		Actor->SetActorHiddenInGame(false);
+		Actor->SetActorEnableCollision(true);
+		Actor->SetActorTickEnabled(true);
+		ReadSaveable(Actor, SaveData, bRecall);
+		return Actor;
+	}
+
+	// 2. Spawn a new actor otherwise, keeping its saved name if it is still free
+
+	UWorld* World = GetGameInstance()->GetWorld();
+	if (!World) return nullptr;
+
+	FActorSpawnParameters SpawnParameters;
+	SpawnParameters.OverrideLevel = FindResidentLevel(SaveData.Partition);
+	SpawnParameters.Name = SaveData.ActorFName;
+	SpawnParameters.NameMode = FActorSpawnParameters::ESpawnActorNameMode::Requested;
+	SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	SpawnParameters.bDeferConstruction = true;
+
+	Actor = World->SpawnActor<AActor>(Class, SaveData.Transform, SpawnParameters);
+	if (!Actor) return nullptr;
+
+	// The saved state is read before BeginPlay, where saveables register themselves and so query their save id
+	ReadSaveable(Actor, SaveData, bRecall);
+	Actor->FinishSpawning(SaveData.Transform);
+
+	return Actor;
+}
+
+void UMSaveManager::RetireActor(AActor* Actor)
+{
+	UnregisterSaveable(Actor);
+
+	TArray<TWeakObjectPtr<AActor>>& Pool = ActorPool.FindOrAdd(Actor->GetClass());
+	Pool.RemoveAll([](const TWeakObjectPtr<AActor>& Pooled) -> bool { return !Pooled.IsValid(); });
+
+	int32 MaxPooledActors = GetDefault<UMSaveSettings>()->MaxPooledActorsPerClass;
+	if (MaxPooledActors <= 0)
+	{
+		Actor->Destroy();
+		return;
+	}
+
+	// Pooled actors are only reused by name, so the longest retired ones are the least likely to come back
+	if (Pool.Num() >= MaxPooledActors)
+	{
+		Pool[0]->Destroy();
+		Pool.RemoveAt(0);
+	}
+
+	Actor->SetActorHiddenInGame(true);
+	Actor->SetActorEnableCollision(false);
+	Actor->SetActorTickEnabled(false);
+	Pool.Add(Actor);
+}
+
+void UMSaveManager::GetResidentPartitions(TSet<FName>& OutPartitions) const
+{
+	UWorld* World = GetGameInstance()->GetWorld();
+	if (!World) return;
+
+	for (const ULevel* Level : World->GetLevels())
+	{
+		if (Level && Level->bIsVisible) OutPartitions.Add(MSaveManager::GetLevelPartition(Level));
+	}
+}
+
+ULevel* UMSaveManager::FindResidentLevel(FName Partition) const
+{
+	UWorld* World = GetGameInstance()->GetWorld();
+	if (!World || Partition.IsNone()) return nullptr;
+
+	for (ULevel* Level : World->GetLevels())
+	{
+		if (Level && Level->bIsVisible && MSaveManager::GetLevelPartition(Level) == Partition) return Level;
+	}
+
+	return nullptr;
+}
+
+void UMSaveManager::OnLevelAddedToWorld(ULevel* Level, UWorld* World)
+{
+	if (!Level || World != GetGameInstance()->GetWorld()) return;
+
+	FName					  Partition = MSaveManager::GetLevelPartition(Level);
+	TMap<FString, FMSaveData> SaveData;
+	if (!Partition.IsNone() && DeferredSaveData.RemoveAndCopyValue(Partition, SaveData))
+	{
+		UE_LOG(
+			LogMSaveManager, Log, TEXT("Restoring %d deferred saveables - %s"), SaveData.Num(), *Partition.ToString());
+
+		// The level's actors went through BeginPlay already, so its saveables are registered
+		for (const TTuple<FString, FMSaveData>& Entry : SaveData)
+		{
+			if (FindSaveable(Entry.Key))
+			{
+				ApplySaveable(Entry.Key, Entry.Value, nullptr, /* bRecall = */ false);
+				continue;
+			}
+
+			if (!Entry.Value.bSpawned) continue;
+
+			UClass* Class = FSoftClassPath(Entry.Value.ClassName).TryLoadClass<AActor>();
+			AActor* Actor = Class ? SpawnSaveable(Class, Entry.Value, /* bRecall = */ false) : nullptr;
+			if (Actor && FindSaveable(Entry.Key) != Actor) RegisterSaveable(Actor);
+			if (Actor && FindSaveable(Entry.Key) != Actor) RetireActor(Actor);
 		}
 	}
+
+	// Saveables elsewhere may reference the ones of this level, which are registered now
+	if (!UnresolvedReferences.IsEmpty()) ResolveUnresolvedReferences();
+}
+
+void UMSaveManager::OnPreLevelRemovedFromWorld(ULevel* Level, UWorld* World)
+{
+	if (!Level || World != GetGameInstance()->GetWorld() || !ActiveSaveGame) return;
+
+	FName Partition = MSaveManager::GetLevelPartition(Level);
+	if (Partition.IsNone()) return;
+
+	// Capturing a partially restored level would park a state which never existed
+	FinishRestore();
+
+	// The level's saveables unregister as it streams out, so park their state until it streams back in
+	TMap<FString, FMSaveData>& SaveData = DeferredSaveData.FindOrAdd(Partition);
+	for (const FMRegisteredSaveable& Registered : Saveables)
+	{
+		UObject* Saveable = Registered.Object.Get();
+		if (!Saveable || Saveable->GetTypedOuter<ULevel>() != Level) continue;
+
+		CaptureSaveable(Saveable, /* bRecall = */ false, SaveData.Add(Registered.SaveId));
+	}
+
+	if (SaveData.IsEmpty()) DeferredSaveData.Remove(Partition);
+}
+
+void UMSaveManager::OnWorldCleanup(UWorld* World, bool bSessionEnded, bool bCleanupResources)
+{
+	// Partitions belong to the world they were saved in
+	if (World != GetGameInstance()->GetWorld()) return;
+
+	DeferredSaveData.Reset();
+	UnresolvedReferences.Reset();
+}
+
+void UMSaveManager::ReadSaveable(UObject* Saveable, const FMSaveData& SaveData, bool bRecall)
+{
+	AActor* Actor = Cast<AActor>(Saveable);
+	if (Actor) Actor->SetActorTransform(SaveData.Transform);
+
+	// Reads the payload in place, it may point straight into the blob store mapping
+	FMSavePayloadReader Reader(SaveData, /* bIsPersistent = */ true);
+	FMSaveTables		Tables;
+	if (Tables.Serialize(Reader))
+	{
+		FMSaveTableArchive Archive(
+			Reader,
+			Tables,
+			FMSaveTableArchive::FFindSaveable([this](const FString& SaveId) -> UObject* {
+				return FindSaveable(SaveId);
+			}),
+			Saveable,
+			&UnresolvedReferences);
+		Archive.ArIsSaveGame = true; // Serialize all properties marked as SaveGame
+		Archive.ArNoDelta = true;	 // Blueprint properties don't serialize consistently without this
+		Saveable->Serialize(Archive);
+	}
+	else if (!Reader.IsError())
+	{
+		// Payloads from before tables hold every name and reference as a string
+		FObjectAndNameAsStringProxyArchive Archive(Reader, true);
+		Archive.ArIsSaveGame = true;
+		Archive.ArNoDelta = true;
+		Saveable->Serialize(Archive);
+	}
+
+	if (Reader.IsError())
+	{
+		UE_LOG(LogMSaveManager, Warning, TEXT("  Failed to read save data of %s"), *Saveable->GetName());
+		return;
+	}
+
+	IMSaveable* NativeSaveable = Cast<IMSaveable>(Saveable);
+	if (NativeSaveable && NativeSaveable->RequiresCustomSerialization())
+		NativeSaveable->Load(Reader, bRecall, SaveHistory);
+}
+
+void UMSaveManager::ResolveUnresolvedReferences()
+{
+	int32 NumResolved = 0;
+	UnresolvedReferences.RemoveAllSwap([this, &NumResolved](const FMUnresolvedReference& Reference) -> bool {
+		if (!Reference.IsPatchable()) return true;
+
+		UObject* Saveable = FindSaveable(Reference.SaveId);
+		if (!Saveable) return false;
+
+		Reference.Patch(Saveable);
+		++NumResolved;
+		return true;
+	});
+
+	if (NumResolved > 0 || !UnresolvedReferences.IsEmpty())
+	{
+		UE_LOG(
+			LogMSaveManager,
+			Log,
+			TEXT("  Resolved %d saveable references, %d still unresolved"),
+			NumResolved,
+			UnresolvedReferences.Num());
+	}
+}
+
+void UMSaveManager::CaptureSaveable(UObject* Saveable, bool bRecall, FMSaveData& OutSaveData)
+{
+	OutSaveData.ClassName = Saveable->GetClass()->GetPathName();
+	OutSaveData.ActorFName = Saveable->GetFName();
+
+	AActor* Actor = Cast<AActor>(Saveable);
+	if (Actor) OutSaveData.Transform = Actor->GetActorTransform();
+	OutSaveData.bSpawned = MSaveManager::IsSpawnedActor(Actor);
+	OutSaveData.Partition = MSaveManager::GetLevelPartition(Saveable->GetTypedOuter<ULevel>());
+
+	// Properties are serialized first, since that fills the tables which are written ahead of them
+	TArray<uint8> Properties;
+	FMemoryWriter PropertyWriter(Properties, true);
+	FMSaveTables  Tables;
+	{
+		FMSaveTableArchive Archive(
+			PropertyWriter, Tables, FMSaveTableArchive::FGetSaveId([this](UObject* Object) -> FString {
+				const int32* Index = SaveableObjectToIndex.Find(Object);
+				return Index ? Saveables[*Index].SaveId : FString();
+			}));
+		Archive.ArIsSaveGame = true; // Serialize all properties marked as SaveGame
+		Archive.ArNoDelta = true;	 // Blueprint properties don't serialize consistently without this
+		Saveable->Serialize(Archive);
+	}
+
+	FMemoryWriter Writer(OutSaveData.Data, true);
+	Tables.Serialize(Writer);
+	Writer.Serialize(Properties.GetData(), Properties.Num());
+
+	IMSaveable* NativeSaveable = Cast<IMSaveable>(Saveable);
+	if (NativeSaveable && NativeSaveable->RequiresCustomSerialization())
+		NativeSaveable->Save(Writer, bRecall, SaveHistory);
+}
+
+bool UMSaveManager::IsSaveableUnchanged(
+	const FMRegisteredSaveable& Registered, const FIoHash& ContentHash, bool bRecall)
+{
+	if (Registered.ContentHash.IsZero() || Registered.ContentHash != ContentHash) return false;
+
+	// The remembered hash only covers changes made by saving and loading, so make sure nothing else changed since
+	if (!GetDefault<UMSaveSettings>()->bVerifySkippedSaveables) return true;
+
+	FMSaveData CurrentSaveData;
+	CaptureSaveable(Registered.Object.Get(), bRecall, CurrentSaveData);
+	return CurrentSaveData.GetContentHash() == ContentHash;
+}
+
+bool UMSaveManager::StartPrefetch(const FGuid& SaveId, bool bWarm)
+{
+	if (FMPrefetchedNode* Prefetched = PrefetchedNodes.Find(SaveId))
+	{
+		// Requested prefetches are kept, even once the node is no longer a neighbour of the most recent one
+		Prefetched->bWarm &= bWarm;
+		return true;
+	}
+
+	if (!ActiveSaveGame || !ActiveSaveGame->SaveNodes.Contains(SaveId)) return false;
+
+	// The delta chain is known from the metadata, so every node of it can be read on the same worker thread
+	TArray<FGuid> DeltaChain;
+	for (const FMSaveNodeMetadata* Metadata = ActiveSaveGame->SaveNodes.Find(SaveId); Metadata;
+		 Metadata = ActiveSaveGame->SaveNodes.Find(Metadata->DeltaBaseId))
+	{
+		DeltaChain.Add(Metadata->SaveId);
+		if (!Metadata->DeltaBaseId.IsValid()) break;
+	}
+
+	UMSaveNode*		  SaveNode = nullptr;
+	FMPrefetchedNode& Prefetched = PrefetchedNodes.Add(SaveId);
+	Prefetched.Task = GetActiveStorage().LaunchResolveNode(DeltaChain, GetRegisteredSaveableIds(), SaveNode);
+	Prefetched.SaveNode.Reset(SaveNode);
+	Prefetched.bWarm = bWarm;
+
+	UE_LOG(LogMSaveManager, Verbose, TEXT("Prefetching save node %s"), *SaveId.ToString());
+	return true;
+}
+
+FMPrefetchedNode* UMSaveManager::FindPrefetchedNode(const FGuid& SaveId, const TSet<FString>& SaveableIds)
+{
+	FMPrefetchedNode* Prefetched = PrefetchedNodes.Find(SaveId);
+	if (!Prefetched || !Prefetched->Task.IsCompleted()) return nullptr;
+
+	const TSharedPtr<const TMap<FString, FMSaveData>>& SaveData = Prefetched->Task.GetResult();
+	if (SaveData && !MSaveManager::HasOmittedSaveData(*SaveData, SaveableIds)) return Prefetched;
+
+	PrefetchedNodes.Remove(SaveId);
+	return nullptr;
+}
+
+UMSaveNode* UMSaveManager::FindCachedNode(const FGuid& SaveId, const TSet<FString>& SaveableIds)
+{
+	if (ResolvedSaveData && ResolvedSaveNode && ResolvedSaveId == SaveId
+		&& !MSaveManager::HasOmittedSaveData(*ResolvedSaveData, SaveableIds))
+	{
+		return ResolvedSaveNode.Get();
+	}
+
+	FMPrefetchedNode* Prefetched = FindPrefetchedNode(SaveId, SaveableIds);
+	return Prefetched ? Prefetched->SaveNode.Get() : nullptr;
+}
+
+void UMSaveManager::WarmNeighbourNodes()
+{
+	const FMSaveNodeMetadata* Active =
+		ActiveSaveGame ? ActiveSaveGame->SaveNodes.Find(ActiveSaveGame->MostRecentNodeId) : nullptr;
+
+	TSet<FGuid> Neighbours;
+	if (Active && GetDefault<UMSaveSettings>()->bWarmNeighbourNodes)
+	{
+		TArray<FGuid> SequenceChildren;
+		ActiveSaveGame->GetChildren(Active->SaveId, EMSaveLineage::Sequence, SequenceChildren);
+
+		Neighbours.Append(SequenceChildren);
+		Neighbours.Add(Active->SequenceParentId);
+		Neighbours.Add(Active->BranchParentId);
+
+		// The most recent node itself is already cached as ResolvedSaveData
+		Neighbours.Remove(Active->SaveId);
+		Neighbours.Remove(FGuid());
+	}
+
+	for (TMap<FGuid, FMPrefetchedNode>::TIterator It = PrefetchedNodes.CreateIterator(); It; ++It)
+	{
+		if (It->Value.bWarm && !Neighbours.Contains(It->Key)) It.RemoveCurrent();
+	}
+
+	for (const FGuid& NodeId : Neighbours)
+	{
+		StartPrefetch(NodeId, /* bWarm = */ true);
+	}
+}
+
+void UMSaveManager::RetireResolvedNode()
+{
+	if (!ResolvedSaveData || !ResolvedSaveNode || PrefetchedNodes.Contains(ResolvedSaveId)) return;
+	if (!GetDefault<UMSaveSettings>()->bWarmNeighbourNodes) return;
+
+	// Saving makes it the sequence parent of the most recent node, which would otherwise be read back from disk
+	FMPrefetchedNode& Prefetched = PrefetchedNodes.Add(ResolvedSaveId);
+	Prefetched.SaveNode.Reset(ResolvedSaveNode.Get());
+	Prefetched.Task = UE::Tasks::MakeCompletedTask<TSharedPtr<const TMap<FString, FMSaveData>>>(ResolvedSaveData);
+	Prefetched.bWarm = true;
+}
+
+void UMSaveManager::ReleasePrefetchedNodes()
+{
+	for (TTuple<FGuid, FMPrefetchedNode>& Prefetched : PrefetchedNodes)
+	{
+		if (Prefetched.Value.Task.IsCompleted()) continue;
+
+		// Nodes still being resolved are handed to a continuation instead, and released on the game thread once done
+		UE::Tasks::Launch(
+			UE_SOURCE_LOCATION,
+			[SaveNode = MoveTemp(Prefetched.Value.SaveNode)]() mutable -> void {
+				AsyncTask(ENamedThreads::GameThread, [SaveNode = MoveTemp(SaveNode)]() -> void {});
+			},
+			UE::Tasks::Prerequisites(Prefetched.Value.Task));
+	}
+
+	PrefetchedNodes.Reset();
+}
+
+TOptional<UE::Tasks::TTask<bool>> UMSaveManager::LaunchCloneSaveSlot(
+	const FString& OriginalSlotName,
+	const int32	   OriginalUserIndex,
+	const FString& NewSlotName,
+	const int32	   NewUserIndex)
+{
+	if (!UGameplayStatics::DoesSaveGameExist(OriginalSlotName, OriginalUserIndex)) return {};
+	if (OriginalSlotName == NewSlotName && OriginalUserIndex == NewUserIndex) return {};
+
+	UE_LOG(
+		LogMSaveManager,
+		Log,
+		TEXT("Cloning save slot - %s:%d -> %s:%d"),
+		*OriginalSlotName,
+		OriginalUserIndex,
+		*NewSlotName,
+		NewUserIndex);
+
+	// The copy waits for the deletion, so the old slot's files never mix with the copied ones
+	if (UGameplayStatics::DoesSaveGameExist(NewSlotName, NewUserIndex)) DeleteSaveGraph(NewSlotName, NewUserIndex);
+
+	return FMSaveStorage::LaunchCopySlot(OriginalSlotName, OriginalUserIndex, NewSlotName, NewUserIndex);
+}
+
+void UMSaveManager::FinishCloneSaveSlot(const FMSlotId& OriginalSlotId, UMSaveGame& NewSaveGame)
+{
+	if (!SaveIndex) return;
+
+	FMSlotSummary& NewSummary = SaveIndex->AddSlot({ NewSaveGame.SlotName, NewSaveGame.UserIndex });
+	if (const FMSlotSummary* OriginalSummary = SaveIndex->FindSlot(OriginalSlotId))
+	{
+		NewSummary = *OriginalSummary;
+		NewSummary.SlotId = { NewSaveGame.SlotName, NewSaveGame.UserIndex };
+	}
+
+	OnSaveIndexUpdated.Broadcast(SaveIndex);
+	WriteSaveIndex();
+
+	// Only writes the index again if the original's summary had fallen behind
+	UpdateSlotSummary(NewSaveGame, /* bFullScan = */ true);
+}
+
+UE::Tasks::TTask<bool> UMSaveManager::DeleteSaveGraph(const FString& SlotName, const int32 UserIndex)
+{
+	UE_LOG(LogMSaveManager, Log, TEXT("Deleting save slot - %s:%d"), *SlotName, UserIndex);
+
+	// 1. Let go of the slot if it is active. Its payloads may still be mapped from its blob store, which some platforms
+	// refuse to delete, and its storage must be reopened (waiting for the deletion) if the slot is ever recreated.
+
+	if (ActiveSaveGame && ActiveSaveGame->SlotName == SlotName && ActiveSaveGame->UserIndex == UserIndex)
+	{
+		ActiveSaveGame = nullptr;
+		ActiveStorage.Reset();
+		SaveHistory->Initialize(nullptr);
+		ResolvedSaveData.Reset();
+		ResolvedSaveId.Invalidate();
+		ResolvedSaveNode.Reset();
+		BroadcastSlotSwitched();
+	}
+
+	// 2. Delete the slot itself first, so a deletion cut short never leaves behind a slot whose nodes are missing
+
+	if (!UGameplayStatics::DeleteGameInSlot(SlotName, UserIndex))
+	{
+		UE_LOG(LogMSaveManager, Warning, TEXT("  Failed to delete save slot - %s:%d"), *SlotName, UserIndex);
+		return UE::Tasks::MakeCompletedTask<bool>(false);
+	}
+
+	if (SaveIndex && SaveIndex->RemoveSlot({ SlotName, UserIndex }))
+	{
+		OnSaveIndexUpdated.Broadcast(SaveIndex);
+		WriteSaveIndex();
+	}
+
+	// 3. Delete the save nodes in bulk in the background, found by file rather than through the slot's metadata
+
+	return FMSaveStorage::LaunchDeleteSlot(SlotName, UserIndex);
+}
+
+void UMSaveManager::BroadcastSlotSwitched()
+{
+	BroadcastNodeId = ActiveSaveGame ? ActiveSaveGame->MostRecentNodeId : FGuid();
+
+	ReleasePrefetchedNodes();
+	WarmNeighbourNodes();
+
+	// Slots are only ever summarized as they change, so a summary may lag behind if the game quit in between
+	if (ActiveSaveGame) UpdateSlotSummary(*ActiveSaveGame, /* bFullScan = */ true);
+
+	FMSaveGraphEvent Event;
+	Event.Type = EMSaveGraphEventType::SlotSwitched;
+	BroadcastGraphEvent(Event);
+
+	OnSaveSlotUpdated.Broadcast(ActiveSaveGame);
+}
+
+void UMSaveManager::BroadcastNodeAdded(const FGuid& SaveId)
+{
+	const FMSaveNodeMetadata* Metadata = ActiveSaveGame ? ActiveSaveGame->SaveNodes.Find(SaveId) : nullptr;
+	if (!Metadata) return;
+
+	FMSaveGraphEvent Event;
+	Event.Type = EMSaveGraphEventType::NodeAdded;
+	Event.Metadata = *Metadata;
+	BroadcastGraphEvent(Event);
+
+	// Nodes are only broadcast once committed, so the summary never runs ahead of the slot
+	UpdateSlotSummary(*ActiveSaveGame, /* bFullScan = */ false);
+
+	BroadcastActiveNodeChanged();
+}
+
+void UMSaveManager::BroadcastActiveNodeChanged()
+{
+	FGuid NewNodeId = ActiveSaveGame ? ActiveSaveGame->MostRecentNodeId : FGuid();
+	if (NewNodeId != BroadcastNodeId)
+	{
+		FMSaveGraphEvent Event;
+		Event.Type = EMSaveGraphEventType::ActiveNodeChanged;
+		Event.OldNodeId = BroadcastNodeId;
+		Event.NewNodeId = NewNodeId;
+		BroadcastNodeId = NewNodeId;
+		BroadcastGraphEvent(Event);
+
+		WarmNeighbourNodes();
+	}
+
+	OnSaveSlotUpdated.Broadcast(ActiveSaveGame);
+}
+
+void UMSaveManager::BroadcastNodesRemoved(TArray<FGuid> NodeIds)
+{
+	if (NodeIds.IsEmpty()) return;
+
+	FMSaveGraphEvent Event;
+	Event.Type = EMSaveGraphEventType::NodesRemoved;
+	Event.RemovedNodeIds = MoveTemp(NodeIds);
+	BroadcastGraphEvent(Event);
+
+	// The latest node may have been removed
+	if (ActiveSaveGame) UpdateSlotSummary(*ActiveSaveGame, /* bFullScan = */ true);
+
+	// Removing the most recent node moves it to one of its ancestors
+	BroadcastActiveNodeChanged();
+}
+
+void UMSaveManager::BroadcastGraphEvent(FMSaveGraphEvent& Event)
+{
+	Event.Revision = ++GraphRevision;
+	Event.SaveGame = ActiveSaveGame;
+	OnSaveGraphChanged.Broadcast(Event);
 }
@@ -0,0 +1,43 @@
+// Copyright © Bedrockbreaker 2025. MIT License
+
+#include "SaveSystem/MSaveNode.h"
+
+void UMSaveNode::ApplyTo(TMap<FString, FMSaveData>& InOutSaveData) const
+{
+	if (IsKeyframe()) InOutSaveData.Reset();
+
+	for (const FString& RemovedSaveId : RemovedSaveIds)
+	{
+		InOutSaveData.Remove(RemovedSaveId);
+	}
+
+	for (const TTuple<FString, FMSaveData>& Entry : SaveData)
+	{
+		InOutSaveData.Add(Entry.Key, Entry.Value);
+	}
+}
+
+void UMSaveNode::FoldDeltaBase(const UMSaveNode& DeltaBase)
+{
+	TSet<FString> Removed(RemovedSaveIds);
+	for (const TTuple<FString, FMSaveData>& Entry : DeltaBase.SaveData)
+	{
+		if (!SaveData.Contains(Entry.Key) && !Removed.Contains(Entry.Key)) SaveData.Add(Entry.Key, Entry.Value);
+	}
+
+	// A keyframe base resets everything, so earlier tombstones have nothing left to remove
+	if (DeltaBase.IsKeyframe())
+	{
+		RemovedSaveIds.Reset();
+	}
+	else
+	{
+		for (const FString& RemovedSaveId : DeltaBase.RemovedSaveIds)
+		{
+			if (!SaveData.Contains(RemovedSaveId) && !Removed.Contains(RemovedSaveId))
+				RemovedSaveIds.Add(RemovedSaveId);
+		}
+	}
+
+	DeltaBaseId = DeltaBase.DeltaBaseId;
+}
@@ -0,0 +1,409 @@
+// Copyright © Bedrockbreaker 2025. MIT License
+
+#include "SaveSystem/MSavePackFile.h"
+
+#include "Algo/Sort.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/Paths.h"
+#include "SaveSystem/MSaveManager.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+namespace MSavePackFile
+{
+	/** Identifies a pack file */
+	constexpr uint32 FileMagic = 0x4B50414D; // "MPAK"
+
+	/** Bumped whenever the file layout changes */
+	constexpr uint32 FileVersion = 1;
+
+	/** Size of the file header (magic + version) */
+	constexpr int64 FileHeaderSize = sizeof(uint32) * 2;
+
+	/** Starts every node record */
+	constexpr uint32 RecordMagic = 0x4345524D; // "MREC"
+
+	/** Size of a node record header (magic + save id + size) */
+	constexpr int64 RecordHeaderSize = sizeof(uint32) + sizeof(FGuid) + sizeof(uint32);
+
+	/** Starts the trailing index */
+	constexpr uint32 IndexMagic = 0x5844494D; // "MIDX"
+
+	/** Size of a trailing index entry (save id + offset + size) */
+	constexpr int64 IndexEntrySize = sizeof(FGuid) + sizeof(int64) + sizeof(uint32);
+
+	/** Ends the file, if it has a trailing index */
+	constexpr uint32 FooterMagic = 0x444E454D; // "MEND"
+
+	/** Size of the footer (index offset + magic) */
+	constexpr int64 FooterSize = sizeof(int64) + sizeof(uint32);
+
+	/** Returns the path a pack is rewritten to before replacing the original */
+	static FString GetTempPath(const FString& FilePath)
+	{
+		return FilePath + TEXT(".tmp");
+	}
+} // namespace MSavePackFile
+
+FMSavePackFile::FMSavePackFile(const FString& InFilePath) : FilePath(InFilePath) {}
+
+FMSavePackFile::~FMSavePackFile()
+{
+	Close();
+}
+
+bool FMSavePackFile::Append(const FGuid& SaveId, TConstArrayView<uint8> Bytes)
+{
+	using namespace MSavePackFile;
+
+	TArray<uint8> Record;
+	Record.Reserve(RecordHeaderSize + Bytes.Num());
+
+	FMemoryWriter Writer(Record);
+	uint32		  Magic = RecordMagic;
+	FGuid		  RecordSaveId = SaveId;
+	uint32		  Size = Bytes.Num();
+	Writer << Magic;
+	Writer << RecordSaveId;
+	Writer << Size;
+	Writer.Serialize(const_cast<uint8*>(Bytes.GetData()), Bytes.Num());
+
+	FScopeLock ScopeLock(&Lock);
+	if (!OpenLocked()) return false;
+
+	// The trailing index is stale as soon as another record is appended
+	if (bHasIndex)
+	{
+		FileHandle->Truncate(EndOffset);
+		bHasIndex = false;
+	}
+
+	if (!FileHandle->Seek(EndOffset) || !FileHandle->Write(Record.GetData(), Record.Num()))
+	{
+		UE_LOG(LogMSaveManager, Warning, TEXT("Failed to append save node %s to %s"), *SaveId.ToString(), *FilePath);
+		return false;
+	}
+
+	Records.Add(SaveId, { EndOffset + RecordHeaderSize, Size });
+	EndOffset += Record.Num();
+	bIndexDirty = true;
+
+	return true;
+}
+
+bool FMSavePackFile::Read(const FGuid& SaveId, TArray<uint8>& OutBytes)
+{
+	OutBytes.Reset();
+
+	FScopeLock ScopeLock(&Lock);
+	if (!OpenLocked()) return false;
+
+	const FRecordLocation* Location = Records.Find(SaveId);
+	if (!Location) return false;
+
+	OutBytes.SetNumUninitialized(Location->Size);
+	if (!FileHandle->Seek(Location->Offset) || !FileHandle->Read(OutBytes.GetData(), Location->Size))
+	{
+		UE_LOG(LogMSaveManager, Warning, TEXT("Failed to read save node %s from %s"), *SaveId.ToString(), *FilePath);
+		OutBytes.Reset();
+		return false;
+	}
+
+	return true;
+}
+
+bool FMSavePackFile::Contains(const FGuid& SaveId)
+{
+	FScopeLock ScopeLock(&Lock);
+	return OpenLocked() && Records.Contains(SaveId);
+}
+
+TArray<FGuid> FMSavePackFile::GetSaveIds()
+{
+	TArray<FGuid> SaveIds;
+
+	FScopeLock ScopeLock(&Lock);
+	if (OpenLocked()) Records.GetKeys(SaveIds);
+
+	return SaveIds;
+}
+
+bool FMSavePackFile::Compact(const TSet<FGuid>& RemovedSaveIds)
+{
+	using namespace MSavePackFile;
+
+	FScopeLock ScopeLock(&Lock);
+	if (!OpenLocked()) return false;
+
+	// 1. Copy every remaining record into a temporary pack, in the order they were appended
+
+	TArray<TPair<FGuid, FRecordLocation>> KeptRecords;
+	for (const TTuple<FGuid, FRecordLocation>& Record : Records)
+	{
+		if (!RemovedSaveIds.Contains(Record.Key)) KeptRecords.Emplace(Record.Key, Record.Value);
+	}
+
+	Algo::SortBy(KeptRecords, [](const TPair<FGuid, FRecordLocation>& Record) { return Record.Value.Offset; });
+
+	FString		  TempPath = GetTempPath(FilePath);
+	IFileManager& FileManager = IFileManager::Get();
+	FileManager.Delete(*TempPath);
+
+	bool bSuccess = true;
+	{
+		FMSavePackFile TempPack(TempPath);
+		TArray<uint8>  Bytes;
+		for (const TPair<FGuid, FRecordLocation>& Record : KeptRecords)
+		{
+			Bytes.SetNumUninitialized(Record.Value.Size);
+			bSuccess = FileHandle->Seek(Record.Value.Offset) && FileHandle->Read(Bytes.GetData(), Bytes.Num())
+					&& TempPack.Append(Record.Key, Bytes);
+			if (!bSuccess) break;
+		}
+
+		// Closing writes the trailing index
+		TempPack.Close();
+	}
+
+	// 2. Swap it in. The pack is reopened on next use, whether or not it was replaced.
+
+	FileHandle.Reset();
+	Records.Reset();
+	EndOffset = 0;
+	bHasIndex = false;
+	bIndexDirty = false;
+
+	if (bSuccess && KeptRecords.IsEmpty()) return FileManager.Delete(*FilePath);
+
+	if (!bSuccess || !FileManager.Move(*FilePath, *TempPath, /* bReplace = */ true))
+	{
+		UE_LOG(LogMSaveManager, Warning, TEXT("Failed to compact pack file %s"), *FilePath);
+		FileManager.Delete(*TempPath);
+		return false;
+	}
+
+	return true;
+}
+
+bool FMSavePackFile::Flush()
+{
+	FScopeLock ScopeLock(&Lock);
+	return !FileHandle || FileHandle->Flush();
+}
+
+void FMSavePackFile::Close()
+{
+	FScopeLock ScopeLock(&Lock);
+	if (FileHandle && bIndexDirty) WriteIndexLocked();
+
+	FileHandle.Reset();
+	Records.Reset();
+	EndOffset = 0;
+	bHasIndex = false;
+	bIndexDirty = false;
+}
+
+bool FMSavePackFile::OpenLocked()
+{
+	using namespace MSavePackFile;
+
+	if (FileHandle) return true;
+
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	PlatformFile.CreateDirectoryTree(*FPaths::GetPath(FilePath));
+
+	FileHandle.Reset(PlatformFile.OpenWrite(*FilePath, /* bAppend = */ true, /* bAllowRead = */ true));
+	if (!FileHandle)
+	{
+		UE_LOG(LogMSaveManager, Warning, TEXT("Failed to open pack file %s"), *FilePath);
+		return false;
+	}
+
+	int64 FileSize = FileHandle->Size();
+
+	// 1. Write the header for new packs, or validate it for existing ones
+
+	if (FileSize < FileHeaderSize)
+	{
+		TArray<uint8> Header;
+		FMemoryWriter Writer(Header);
+		uint32		  Magic = FileMagic;
+		uint32		  Version = FileVersion;
+		Writer << Magic;
+		Writer << Version;
+
+		if (!FileHandle->Seek(0) || !FileHandle->Write(Header.GetData(), Header.Num()))
+		{
+			FileHandle.Reset();
+			return false;
+		}
+
+		EndOffset = FileHeaderSize;
+		return true;
+	}
+
+	uint8 HeaderBytes[FileHeaderSize];
+	FileHandle->Seek(0);
+	FileHandle->Read(HeaderBytes, FileHeaderSize);
+
+	FMemoryReaderView HeaderReader(MakeArrayView(HeaderBytes, FileHeaderSize));
+	uint32			  Magic = 0;
+	uint32			  Version = 0;
+	HeaderReader << Magic;
+	HeaderReader << Version;
+
+	if (Magic != FileMagic || Version != FileVersion)
+	{
+		UE_LOG(LogMSaveManager, Warning, TEXT("Pack file %s has an unknown format"), *FilePath);
+		FileHandle.Reset();
+		return false;
+	}
+
+	// 2. Load the trailing index, falling back to walking the records if the pack was not closed cleanly
+
+	if (!ReadIndexLocked(FileSize))
+	{
+		if (FileSize > FileHeaderSize)
+			UE_LOG(LogMSaveManager, Log, TEXT("Pack file %s has no valid index, recovering it"), *FilePath);
+
+		ScanRecordsLocked(FileSize);
+	}
+
+	return true;
+}
+
+bool FMSavePackFile::ReadIndexLocked(int64 FileSize)
+{
+	using namespace MSavePackFile;
+
+	if (FileSize < FileHeaderSize + sizeof(uint32) + sizeof(int32) + FooterSize) return false;
+
+	uint8 FooterBytes[FooterSize];
+	if (!FileHandle->Seek(FileSize - FooterSize) || !FileHandle->Read(FooterBytes, FooterSize)) return false;
+
+	FMemoryReaderView FooterReader(MakeArrayView(FooterBytes, FooterSize));
+	int64			  IndexOffset = 0;
+	uint32			  Magic = 0;
+	FooterReader << IndexOffset;
+	FooterReader << Magic;
+
+	if (Magic != FooterMagic || IndexOffset < FileHeaderSize || IndexOffset >= FileSize - FooterSize) return false;
+
+	TArray<uint8> IndexBytes;
+	IndexBytes.SetNumUninitialized(static_cast<int32>(FileSize - FooterSize - IndexOffset));
+	if (!FileHandle->Seek(IndexOffset) || !FileHandle->Read(IndexBytes.GetData(), IndexBytes.Num())) return false;
+
+	FMemoryReader IndexReader(IndexBytes);
+	int32		  NumEntries = 0;
+	IndexReader << Magic;
+	IndexReader << NumEntries;
+
+	int64 ExpectedSize = sizeof(uint32) + sizeof(int32) + NumEntries * IndexEntrySize;
+	if (Magic != IndexMagic || NumEntries < 0 || IndexBytes.Num() != ExpectedSize) return false;
+
+	Records.Reset();
+	Records.Reserve(NumEntries);
+	for (int32 Index = 0; Index < NumEntries; ++Index)
+	{
+		FGuid			SaveId;
+		FRecordLocation Location;
+		IndexReader << SaveId;
+		IndexReader << Location.Offset;
+		IndexReader << Location.Size;
+
+		if (Location.Offset < FileHeaderSize || Location.Offset + Location.Size > IndexOffset)
+		{
+			Records.Reset();
+			return false;
+		}
+
+		Records.Add(SaveId, Location);
+	}
+
+	EndOffset = IndexOffset;
+	bHasIndex = true;
+	bIndexDirty = false;
+	return true;
+}
+
+void FMSavePackFile::ScanRecordsLocked(int64 FileSize)
+{
+	using namespace MSavePackFile;
+
+	Records.Reset();
+	EndOffset = FileHeaderSize;
+
+	uint8 RecordHeader[RecordHeaderSize];
+	while (EndOffset + RecordHeaderSize <= FileSize)
+	{
+		FileHandle->Seek(EndOffset);
+		if (!FileHandle->Read(RecordHeader, RecordHeaderSize)) break;
+
+		FMemoryReaderView RecordReader(MakeArrayView(RecordHeader, RecordHeaderSize));
+		uint32			  Magic = 0;
+		FGuid			  SaveId;
+		uint32			  Size = 0;
+		RecordReader << Magic;
+		RecordReader << SaveId;
+		RecordReader << Size;
+
+		int64 RecordEnd = EndOffset + RecordHeaderSize + Size;
+		if (Magic != RecordMagic || RecordEnd > FileSize) break;
+
+		Records.Add(SaveId, { EndOffset + RecordHeaderSize, Size });
+		EndOffset = RecordEnd;
+	}
+
+	// Anything past the last record is either a stale index or a partially written record (e.g. from a crash)
+	if (EndOffset != FileSize)
+	{
+		UE_LOG(
+			LogMSaveManager,
+			Warning,
+			TEXT("Pack file %s has %lld trailing bytes, discarding them"),
+			*FilePath,
+			FileSize - EndOffset);
+		FileHandle->Truncate(EndOffset);
+	}
+
+	bHasIndex = false;
+	bIndexDirty = true;
+}
+
+bool FMSavePackFile::WriteIndexLocked()
+{
+	using namespace MSavePackFile;
+
+	TArray<uint8> IndexBytes;
+	IndexBytes.Reserve(sizeof(uint32) + sizeof(int32) + Records.Num() * IndexEntrySize + FooterSize);
+
+	FMemoryWriter Writer(IndexBytes);
+	uint32		  Magic = IndexMagic;
+	int32		  NumEntries = Records.Num();
+	Writer << Magic;
+	Writer << NumEntries;
+
+	for (TTuple<FGuid, FRecordLocation>& Record : Records)
+	{
+		Writer << Record.Key;
+		Writer << Record.Value.Offset;
+		Writer << Record.Value.Size;
+	}
+
+	int64 IndexOffset = EndOffset;
+	Magic = FooterMagic;
+	Writer << IndexOffset;
+	Writer << Magic;
+
+	if (!FileHandle->Seek(EndOffset) || !FileHandle->Write(IndexBytes.GetData(), IndexBytes.Num()))
+	{
+		UE_LOG(LogMSaveManager, Warning, TEXT("Failed to write the index of pack file %s"), *FilePath);
+		return false;
+	}
+
+	FileHandle->Truncate(EndOffset + IndexBytes.Num());
+	bHasIndex = true;
+	bIndexDirty = false;
+	return FileHandle->Flush();
+}
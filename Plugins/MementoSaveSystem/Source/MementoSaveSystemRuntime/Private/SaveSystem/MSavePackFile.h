@@ -0,0 +1,88 @@
+// Copyright © Bedrockbreaker 2025. MIT License
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+
+class IFileHandle;
+
+/**
+ * Per-slot append-only pack file holding every encoded save node of the slot.
+ *
+ * Node records are appended one after another, followed by a trailing index mapping save ids to records.
+ * The index is only rewritten when the pack is closed. A pack without a valid index (e.g. after a crash) is
+ * recovered by walking its records. Thread-safe.
+ */
+class FMSavePackFile
+{
+public:
+	explicit FMSavePackFile(const FString& InFilePath);
+	~FMSavePackFile();
+
+	/** Appends a node record. A later record for the same save id replaces the earlier one. */
+	bool Append(const FGuid& SaveId, TConstArrayView<uint8> Bytes);
+
+	/** Reads a node record, with a single seek and read */
+	bool Read(const FGuid& SaveId, TArray<uint8>& OutBytes);
+
+	/** Whether the pack holds a record for a save id */
+	bool Contains(const FGuid& SaveId);
+
+	/** Returns the save id of every record in the pack */
+	TArray<FGuid> GetSaveIds();
+
+	/**
+	 * Rewrites the pack without the records of removed save ids, or of any record replaced by a later one.
+	 * The remaining records are copied into a new file which then replaces the pack, so a rewrite cut short leaves the
+	 * pack as it was.
+	 */
+	bool Compact(const TSet<FGuid>& RemovedSaveIds);
+
+	/** Flushes any buffered writes to disk */
+	bool Flush();
+
+	/** Writes the trailing index, then closes the underlying file. The pack reopens it on next use. */
+	void Close();
+
+private:
+	/** Where a node record's bytes live within the pack file */
+	struct FRecordLocation
+	{
+		int64  Offset = 0;
+		uint32 Size = 0;
+	};
+
+	/** The path of the pack file */
+	FString FilePath;
+
+	/** Maps save ids to their record within the pack file */
+	TMap<FGuid, FRecordLocation> Records;
+
+	/** Read/write handle to the pack file, opened lazily */
+	TUniquePtr<IFileHandle> FileHandle;
+
+	/** The offset one past the last valid record, where the trailing index (if any) starts */
+	int64 EndOffset = 0;
+
+	/** Whether the file currently ends with a trailing index, which must be cut off before appending */
+	bool bHasIndex = false;
+
+	/** Whether records were appended since the trailing index was last written */
+	bool bIndexDirty = false;
+
+	/** Guards all file access and the record index */
+	FCriticalSection Lock;
+
+	/** Opens the pack file and loads (or rebuilds) the record index from it, if not already open */
+	bool OpenLocked();
+
+	/** Loads the trailing index. Returns false if the pack has no valid index. */
+	bool ReadIndexLocked(int64 FileSize);
+
+	/** Rebuilds the record index by walking every record, discarding anything past the last valid one */
+	void ScanRecordsLocked(int64 FileSize);
+
+	/** Writes the trailing index after the last record */
+	bool WriteIndexLocked();
+};
@@ -0,0 +1,74 @@
+// Copyright © Bedrockbreaker 2025. MIT License
+
+#include "SaveSystem/MSavePayloadReader.h"
+
+#include "SaveSystem/MSaveData.h"
+#include "SaveSystem/MSaveManager.h"
+
+FMSavePayloadReader::FMSavePayloadReader(const FMSaveData& SaveData, bool bIsPersistent)
+{
+	SetIsLoading(true);
+	SetIsPersistent(bIsPersistent);
+
+	Segments = SaveData.GetPayloadSegments(DataView);
+	Size = SaveData.GetPayloadSize();
+}
+
+void FMSavePayloadReader::Serialize(void* Data, int64 Num)
+{
+	if (Num <= 0 || IsError()) return;
+
+	if (Offset + Num > Size)
+	{
+		UE_LOG(
+			LogMSaveManager,
+			Warning,
+			TEXT("Save data payload is too short, requested %lld bytes with %lld remaining"),
+			Num,
+			Size - Offset);
+		FMemory::Memzero(Data, Num);
+		SetError();
+		return;
+	}
+
+	// Reads may span chunk boundaries, since chunks are cut by content rather than by what was serialized
+	uint8* Destination = static_cast<uint8*>(Data);
+	while (Num > 0)
+	{
+		const FMemoryView& Segment = Segments[SegmentIndex];
+		int64			   SegmentOffset = Offset - SegmentStart;
+		int64			   Count = FMath::Min<int64>(Num, Segment.GetSize() - SegmentOffset);
+
+		FMemory::Memcpy(Destination, static_cast<const uint8*>(Segment.GetData()) + SegmentOffset, Count);
+		Destination += Count;
+		Offset += Count;
+		Num -= Count;
+
+		if (Offset == SegmentStart + static_cast<int64>(Segment.GetSize()) && SegmentIndex + 1 < Segments.Num())
+		{
+			SegmentStart = Offset;
+			++SegmentIndex;
+		}
+	}
+}
+
+void FMSavePayloadReader::Seek(int64 InPos)
+{
+	if (InPos < 0 || InPos > Size)
+	{
+		SetError();
+		return;
+	}
+
+	Offset = InPos;
+	SegmentIndex = 0;
+	SegmentStart = 0;
+	while (SegmentIndex + 1 < Segments.Num())
+	{
+		int64 SegmentEnd = SegmentStart + Segments[SegmentIndex].GetSize();
+		if (SegmentEnd > Offset) break;
+
+		SegmentStart = SegmentEnd;
+		++SegmentIndex;
+	}
+}
@@ -0,0 +1,45 @@
+// Copyright © Bedrockbreaker 2025. MIT License
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Memory/MemoryView.h"
+#include "Serialization/Archive.h"
+
+struct FMSaveData;
+
+/**
+ * Archive reading the payload of save data in place.
+ * Mapped payloads are read straight out of the blob store mapping, chunk after chunk, without assembling them first.
+ * The save data must outlive the reader.
+ */
+class FMSavePayloadReader : public FArchive
+{
+public:
+	explicit FMSavePayloadReader(const FMSaveData& SaveData, bool bIsPersistent = false);
+
+	virtual void	Serialize(void* Data, int64 Num) override;
+	virtual void	Seek(int64 InPos) override;
+	virtual int64	Tell() override { return Offset; }
+	virtual int64	TotalSize() override { return Size; }
+	virtual FString GetArchiveName() const override { return TEXT("FMSavePayloadReader"); }
+
+private:
+	/** The only segment of a payload which is not mapped */
+	FMemoryView DataView;
+
+	/** The contiguous segments making up the payload */
+	TConstArrayView<FMemoryView> Segments;
+
+	/** The total size of the payload */
+	int64 Size = 0;
+
+	/** The current position within the payload */
+	int64 Offset = 0;
+
+	/** The segment containing the current position */
+	int32 SegmentIndex = 0;
+
+	/** The position the current segment starts at */
+	int64 SegmentStart = 0;
+};
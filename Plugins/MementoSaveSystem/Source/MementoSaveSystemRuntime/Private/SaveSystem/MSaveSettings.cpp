@@ -0,0 +1,9 @@
+// Copyright © Bedrockbreaker 2025. MIT License
+
+#include "SaveSystem/MSaveSettings.h"
+
+UMSaveSettings::UMSaveSettings()
+{
+	CategoryName = TEXT("Plugins");
+	SectionName = TEXT("MementoSaveSystem");
+}
@@ -0,0 +1,1174 @@
+// Copyright © Bedrockbreaker 2025. MIT License
+
+#include "SaveSystem/MSaveStorage.h"
+
+#include "Algo/Count.h"
+#include "Async/Async.h"
+#include "Async/ParallelFor.h"
+#include "HAL/FileManager.h"
+#include "Kismet/GameplayStatics.h"
+#include "Misc/Paths.h"
+#include "PlatformFeatures.h"
+#include "SaveGameSystem.h"
+#include "SaveSystem/MSaveCodec.h"
+#include "SaveSystem/MSaveData.h"
+#include "SaveSystem/MSaveGame.h"
+#include "SaveSystem/MSaveNode.h"
+#include "SaveSystem/MSaveManager.h"
+#include "SaveSystem/MSlotId.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+#include <atomic>
+
+namespace MSaveStorage
+{
+	/** File extension of the blob store */
+	const TCHAR* BlobStoreExtension = TEXT("mblobs");
+
+	/** File extension of a compacted blob store, used in place of the blob store until it can replace it */
+	const TCHAR* CompactedBlobStoreExtension = TEXT("mblobs.compacted");
+
+	/** File extension of the pack file */
+	const TCHAR* PackFileExtension = TEXT("mpack");
+
+	/** File extension of the metadata journal */
+	const TCHAR* JournalExtension = TEXT("mjournal");
+
+	/** File extension of the saveable timeline */
+	const TCHAR* TimelineExtension = TEXT("mtimeline");
+
+	/** Extensions of every file holding a slot's nodes, other than any legacy node files */
+	const TCHAR* SlotFileExtensions[] = {
+		BlobStoreExtension, CompactedBlobStoreExtension, PackFileExtension, TimelineExtension
+	};
+
+	/** Identifies an encoded save node */
+	constexpr uint32 NodeMagic = 0x444F4E4D; // "MNOD"
+
+	/** Bumped whenever the node encoding changes */
+	constexpr uint32 NodeVersion = 1;
+
+	/** Directory entry flag, set for saveables which were spawned at runtime (see FMSaveData::bSpawned) */
+	constexpr uint8 EntryFlagSpawned = 1 << 0;
+
+	/** Directory entry flag, set for saveables outside of the persistent level. The partition follows the flags. */
+	constexpr uint8 EntryFlagPartitioned = 1 << 1;
+
+	/** Storage instances which are currently open, keyed by slot */
+	static TMap<FMSlotId, TWeakPtr<FMSaveStorage>> OpenStorages;
+
+	/** Slot copies and deletions which may still be in flight, keyed by every slot they touch. Game thread only. */
+	static TMap<FMSlotId, UE::Tasks::TTask<bool>> PendingFileTasks;
+
+	/** Deletes every file belonging to a save slot, including its journal. Their stores must be closed already. */
+	static bool DeleteStorageFiles(const FString& SlotName, const int32 UserIndex)
+	{
+		TArray<const TCHAR*, TInlineAllocator<5>> Extensions(SlotFileExtensions);
+		Extensions.Add(JournalExtension);
+
+		bool bSuccess = true;
+		for (const TCHAR* Extension : Extensions)
+		{
+			FString Path = FMSaveStorage::GetSlotFilePath(SlotName, UserIndex, Extension);
+			bSuccess &= !IFileManager::Get().FileExists(*Path) || IFileManager::Get().Delete(*Path);
+		}
+
+		return bSuccess;
+	}
+
+	/** Returns the names of a slot's legacy save nodes, stored as <SlotName><SaveId> (see GetNodeSlotName) */
+	static TArray<FString> FindLegacyNodeSlotNames(
+		ISaveGameSystem& SaveSystem, const FString& SlotName, const int32 UserIndex)
+	{
+		TArray<FString> SaveNames;
+		SaveSystem.GetSaveGameNames(SaveNames, UserIndex);
+
+		return SaveNames.FilterByPredicate([&SlotName](const FString& SaveName) -> bool {
+			FGuid SaveId;
+			return SaveName.StartsWith(SlotName, ESearchCase::CaseSensitive)
+				&& FGuid::ParseExact(SaveName.RightChop(SlotName.Len()), EGuidFormats::Digits, SaveId);
+		});
+	}
+
+	/** Serializes the persistent fields of a single save data entry, in either direction */
+	static void SerializeSaveData(FArchive& Ar, FMSaveData& SaveData)
+	{
+		// Names are written as strings, since name indices are meaningless outside of this process
+		FString ActorName = Ar.IsLoading() ? FString() : SaveData.ActorFName.ToString();
+
+		Ar << SaveData.ClassName;
+		Ar << ActorName;
+		Ar << SaveData.Transform;
+		Ar << SaveData.Chunks;
+
+		if (Ar.IsLoading()) SaveData.ActorFName = FName(*ActorName);
+	}
+
+	/** Whether the bytes of a save node were written by FMSaveStorage::EncodeNode */
+	static bool IsEncodedNode(TConstArrayView<uint8> Bytes)
+	{
+		uint32 Magic = 0;
+		if (Bytes.Num() < sizeof(Magic)) return false;
+
+		FMemory::Memcpy(&Magic, Bytes.GetData(), sizeof(Magic));
+		return INTEL_ORDER32(Magic) == NodeMagic;
+	}
+} // namespace MSaveStorage
+
+FMSaveStorage::FMSaveStorage(const FString& InSlotName, const int32 InUserIndex)
+	: SlotName(InSlotName), UserIndex(InUserIndex),
+	  BlobStore(GetSlotFilePath(InSlotName, InUserIndex, MSaveStorage::BlobStoreExtension)),
+	  PackFile(GetSlotFilePath(InSlotName, InUserIndex, MSaveStorage::PackFileExtension)),
+	  Journal(GetSlotFilePath(InSlotName, InUserIndex, MSaveStorage::JournalExtension)),
+	  Timeline(GetSlotFilePath(InSlotName, InUserIndex, MSaveStorage::TimelineExtension)),
+	  SaveGameSystem(IPlatformFeaturesModule::Get().GetSaveGameSystem())
+{
+}
+
+TSharedRef<FMSaveStorage> FMSaveStorage::Open(const FString& SlotName, const int32 UserIndex)
+{
+	check(IsInGameThread());
+
+	// A slot being copied or deleted must not be reopened until its files are settled
+	WaitForFileTasks(SlotName, UserIndex);
+
+	TWeakPtr<FMSaveStorage>& WeakStorage = MSaveStorage::OpenStorages.FindOrAdd({ SlotName, UserIndex });
+
+	TSharedPtr<FMSaveStorage> Storage = WeakStorage.Pin();
+	if (!Storage)
+	{
+		Storage = MakeShared<FMSaveStorage>(SlotName, UserIndex);
+		WeakStorage = Storage;
+	}
+
+	return Storage.ToSharedRef();
+}
+
+FString FMSaveStorage::GetSlotFilePath(const FString& SlotName, const int32 UserIndex, const TCHAR* Extension)
+{
+	// Matches where the generic save game system stores <SlotName>.sav. Unlike it, slots of different users never
+	// share files. The user index always precedes the extension, so no slot name can produce another slot's path.
+	return FPaths::ProjectSavedDir() / TEXT("SaveGames")
+		/ FString::Printf(TEXT("%s.%d.%s"), *SlotName, UserIndex, Extension);
+}
+
+FString FMSaveStorage::GetNodeSlotName(const FString& SlotName, const FGuid& SaveId)
+{
+	return SlotName + SaveId.ToString();
+}
+
+bool FMSaveStorage::IsFileStorageSupported(const FString& SlotName)
+{
+	// Where the generic save game system stores <SlotName>.sav, whichever user it belongs to
+	FString Path = FPaths::ProjectSavedDir() / TEXT("SaveGames") / (SlotName + TEXT(".sav"));
+	if (IFileManager::Get().FileExists(*Path)) return true;
+
+	UE_LOG(
+		LogMSaveManager,
+		Error,
+		TEXT("Save slot %s was not saved to %s. Platforms with a dedicated save system are not supported."),
+		*SlotName,
+		*Path);
+	return false;
+}
+
+bool FMSaveStorage::DeleteSlotFiles(const FString& SlotName, const int32 UserIndex)
+{
+	check(IsInGameThread());
+
+	WaitForPendingWrites(SlotName, UserIndex);
+	WaitForFileTasks(SlotName, UserIndex);
+
+	// Open stores must let go of their files first
+	TSharedPtr<FMSaveStorage> Storage = MSaveStorage::OpenStorages.FindRef({ SlotName, UserIndex }).Pin();
+	if (Storage)
+	{
+		Storage->BlobStore.Close();
+		Storage->PackFile.Close();
+		Storage->Journal.Close();
+		Storage->Timeline.Close();
+	}
+
+	return MSaveStorage::DeleteStorageFiles(SlotName, UserIndex);
+}
+
+int64 FMSaveStorage::GetSlotFilesSize(const FString& SlotName, const int32 UserIndex)
+{
+	TArray<const TCHAR*, TInlineAllocator<5>> Extensions(MSaveStorage::SlotFileExtensions);
+	Extensions.Add(MSaveStorage::JournalExtension);
+
+	int64 Size = 0;
+	for (const TCHAR* Extension : Extensions)
+	{
+		Size += FMath::Max<int64>(IFileManager::Get().FileSize(*GetSlotFilePath(SlotName, UserIndex, Extension)), 0);
+	}
+
+	return Size;
+}
+
+int64 FMSaveStorage::FindSlotFilesSize(const FString& SlotName, const int32 UserIndex)
+{
+	check(IsInGameThread());
+
+	TSharedPtr<FMSaveStorage> Storage = MSaveStorage::OpenStorages.FindRef({ SlotName, UserIndex }).Pin();
+	return Storage ? Storage->FilesSize.load() : INDEX_NONE;
+}
+
+int64 FMSaveStorage::MeasureFiles()
+{
+	int64 Size = GetSlotFilesSize(SlotName, UserIndex);
+	FilesSize = Size;
+	return Size;
+}
+
+void FMSaveStorage::AddSlotPrerequisites(
+	const FString& SlotName, const int32 UserIndex, TArray<UE::Tasks::TTask<bool>>& OutPrerequisites)
+{
+	check(IsInGameThread());
+
+	if (TSharedPtr<FMSaveStorage> Storage = MSaveStorage::OpenStorages.FindRef({ SlotName, UserIndex }).Pin())
+	{
+		for (TTuple<FGuid, FPendingWrite>& PendingWrite : Storage->PendingWrites)
+		{
+			OutPrerequisites.Add(PendingWrite.Value.Task);
+		}
+
+		if (Storage->PendingCommit.IsValid()) OutPrerequisites.Add(Storage->PendingCommit);
+	}
+
+	if (UE::Tasks::TTask<bool>* FileTask = MSaveStorage::PendingFileTasks.Find({ SlotName, UserIndex }))
+		OutPrerequisites.Add(*FileTask);
+}
+
+bool FMSaveStorage::DeleteLegacyNode(const FString& SlotName, const int32 UserIndex, const FGuid& SaveId)
+{
+	ISaveGameSystem* SaveSystem = IPlatformFeaturesModule::Get().GetSaveGameSystem();
+
+	FString NodeSlotName = GetNodeSlotName(SlotName, SaveId);
+	if (!SaveSystem->DoesSaveGameExist(*NodeSlotName, UserIndex)) return true;
+
+	return SaveSystem->DeleteGame(false, *NodeSlotName, UserIndex);
+}
+
+void FMSaveStorage::WaitForPendingWrites(const FString& SlotName, const int32 UserIndex)
+{
+	check(IsInGameThread());
+
+	TSharedPtr<FMSaveStorage> Storage = MSaveStorage::OpenStorages.FindRef({ SlotName, UserIndex }).Pin();
+	if (!Storage) return;
+
+	for (TTuple<FGuid, FPendingWrite>& PendingWrite : Storage->PendingWrites)
+	{
+		PendingWrite.Value.Task.Wait();
+	}
+
+	Storage->PendingCommit.Wait();
+}
+
+UE::Tasks::TTask<bool> FMSaveStorage::LaunchDeleteSlot(const FString& SlotName, const int32 UserIndex)
+{
+	check(IsInGameThread());
+
+	// Anything still writing to the slot would otherwise recreate its files after they are deleted
+	TArray<UE::Tasks::TTask<bool>> Prerequisites;
+	TSharedPtr<FMSaveStorage>	   Storage = MSaveStorage::OpenStorages.FindRef({ SlotName, UserIndex }).Pin();
+	AddSlotPrerequisites(SlotName, UserIndex, Prerequisites);
+
+	UE::Tasks::TTask<bool> Task = UE::Tasks::Launch(
+		UE_SOURCE_LOCATION,
+		[Storage, SlotName, UserIndex]() -> bool {
+			// Open stores must let go of their files first
+			if (Storage)
+			{
+				Storage->BlobStore.Close();
+				Storage->PackFile.Close();
+				Storage->Journal.Close();
+				Storage->Timeline.Close();
+			}
+
+			bool bSuccess = MSaveStorage::DeleteStorageFiles(SlotName, UserIndex);
+
+			ISaveGameSystem* SaveSystem = IPlatformFeaturesModule::Get().GetSaveGameSystem();
+			for (const FString& NodeSlotName : MSaveStorage::FindLegacyNodeSlotNames(*SaveSystem, SlotName, UserIndex))
+			{
+				bSuccess &= SaveSystem->DeleteGame(false, *NodeSlotName, UserIndex);
+			}
+
+			return bSuccess;
+		},
+		Prerequisites);
+
+	MSaveStorage::PendingFileTasks.Add({ SlotName, UserIndex }, Task);
+	return Task;
+}
+
+UE::Tasks::TTask<bool> FMSaveStorage::LaunchCopySlot(
+	const FString& OriginalSlotName,
+	const int32	   OriginalUserIndex,
+	const FString& NewSlotName,
+	const int32	   NewUserIndex)
+{
+	check(IsInGameThread());
+
+	TArray<UE::Tasks::TTask<bool>> Prerequisites;
+	AddSlotPrerequisites(OriginalSlotName, OriginalUserIndex, Prerequisites);
+	AddSlotPrerequisites(NewSlotName, NewUserIndex, Prerequisites);
+
+	TSharedPtr<FMSaveStorage> OriginalStorage =
+		MSaveStorage::OpenStorages.FindRef({ OriginalSlotName, OriginalUserIndex }).Pin();
+	TSharedPtr<FMSaveStorage> NewStorage = MSaveStorage::OpenStorages.FindRef({ NewSlotName, NewUserIndex }).Pin();
+
+	UE::Tasks::TTask<bool> Task = UE::Tasks::Launch(
+		UE_SOURCE_LOCATION,
+		[OriginalStorage, NewStorage, OriginalSlotName, OriginalUserIndex, NewSlotName, NewUserIndex]() -> bool {
+			// 1. Closing the original pack writes its index, so the copy does not need to recover it
+
+			if (OriginalStorage)
+			{
+				OriginalStorage->BlobStore.Flush();
+				OriginalStorage->PackFile.Close();
+				OriginalStorage->Timeline.Close();
+			}
+
+			if (NewStorage)
+			{
+				NewStorage->BlobStore.Close();
+				NewStorage->PackFile.Close();
+				NewStorage->Journal.Close();
+				NewStorage->Timeline.Close();
+			}
+
+			// 2. Replace the new slot's node storage. The journal goes before the slot: a checkpoint written in
+			// between truncates the journal only after the slot, so the pair copied is never missing records.
+
+			bool bSuccess = MSaveStorage::DeleteStorageFiles(NewSlotName, NewUserIndex);
+
+			TArray<const TCHAR*, TInlineAllocator<5>> Extensions(MSaveStorage::SlotFileExtensions);
+			Extensions.Add(MSaveStorage::JournalExtension);
+			for (const TCHAR* Extension : Extensions)
+			{
+				FString OriginalPath = GetSlotFilePath(OriginalSlotName, OriginalUserIndex, Extension);
+				FString NewPath = GetSlotFilePath(NewSlotName, NewUserIndex, Extension);
+				if (!IFileManager::Get().FileExists(*OriginalPath)) continue;
+
+				bSuccess = bSuccess && IFileManager::Get().Copy(*NewPath, *OriginalPath) == COPY_OK;
+			}
+
+			if (NewStorage) NewStorage->MeasureFiles();
+
+			// 3. Copy legacy nodes, then the slot itself
+
+			ISaveGameSystem* SaveSystem = IPlatformFeaturesModule::Get().GetSaveGameSystem();
+			TArray<uint8>	 Bytes;
+			for (const FString& NodeSlotName :
+				 MSaveStorage::FindLegacyNodeSlotNames(*SaveSystem, OriginalSlotName, OriginalUserIndex))
+			{
+				FString NewNodeSlotName = NewSlotName + NodeSlotName.RightChop(OriginalSlotName.Len());
+				bSuccess = bSuccess && SaveSystem->LoadGame(false, *NodeSlotName, OriginalUserIndex, Bytes);
+				bSuccess = bSuccess && SaveSystem->SaveGame(false, *NewNodeSlotName, NewUserIndex, Bytes);
+			}
+
+			bSuccess = bSuccess && SaveSystem->LoadGame(false, *OriginalSlotName, OriginalUserIndex, Bytes);
+			bSuccess = bSuccess && SaveSystem->SaveGame(false, *NewSlotName, NewUserIndex, Bytes);
+
+			return bSuccess;
+		},
+		Prerequisites);
+
+	// Neither slot may be written or reopened until the copy completes
+	MSaveStorage::PendingFileTasks.Add({ OriginalSlotName, OriginalUserIndex }, Task);
+	MSaveStorage::PendingFileTasks.Add({ NewSlotName, NewUserIndex }, Task);
+	return Task;
+}
+
+void FMSaveStorage::WaitForFileTasks(const FString& SlotName, const int32 UserIndex)
+{
+	check(IsInGameThread());
+
+	UE::Tasks::TTask<bool> FileTask;
+	if (!MSaveStorage::PendingFileTasks.RemoveAndCopyValue({ SlotName, UserIndex }, FileTask)) return;
+
+	FileTask.Wait();
+}
+
+void FMSaveStorage::EncodeNode(const UMSaveNode& SaveNode, TArray<uint8>& OutBytes)
+{
+	using namespace MSaveStorage;
+
+	OutBytes.Reset();
+
+	// Saving never modifies the node, the archive API just isn't const
+	UMSaveNode& Node = const_cast<UMSaveNode&>(SaveNode);
+
+	FMemoryWriter Writer(OutBytes);
+	uint32		  Magic = NodeMagic;
+	uint32		  Version = NodeVersion;
+	Writer << Magic;
+	Writer << Version;
+	Writer << Node.SaveId;
+	Writer << Node.DeltaBaseId;
+	Writer << Node.RemovedSaveIds;
+
+	// The entries are encoded on their own first, so the directory ahead of them can record the size of each
+	TArray<uint8> EntryBytes;
+	FMemoryWriter EntryWriter(EntryBytes);
+
+	int32 NumEntries = Node.SaveData.Num();
+	Writer << NumEntries;
+
+	for (TTuple<FString, FMSaveData>& Entry : Node.SaveData)
+	{
+		int64 EntryStart = EntryBytes.Num();
+		SerializeSaveData(EntryWriter, Entry.Value);
+
+		uint32 EntrySize = static_cast<uint32>(EntryBytes.Num() - EntryStart);
+		uint8  EntryFlags = (Entry.Value.bSpawned ? EntryFlagSpawned : 0)
+						 | (Entry.Value.Partition.IsNone() ? 0 : EntryFlagPartitioned);
+		Writer << Entry.Key;
+		Writer << EntrySize;
+		Writer << EntryFlags;
+
+		if (EntryFlags & EntryFlagPartitioned)
+		{
+			FString Partition = Entry.Value.Partition.ToString();
+			Writer << Partition;
+		}
+	}
+
+	Writer.Serialize(EntryBytes.GetData(), EntryBytes.Num());
+}
+
+bool FMSaveStorage::DecodeNode(
+	TConstArrayView<uint8> Bytes, UMSaveNode& OutSaveNode, const TSet<FString>* SaveableFilter)
+{
+	using namespace MSaveStorage;
+
+	FMemoryReaderView Reader(Bytes);
+	uint32			  Magic = 0;
+	uint32			  Version = 0;
+	Reader << Magic;
+	Reader << Version;
+
+	if (Magic != NodeMagic || Version != NodeVersion) return false;
+
+	Reader << OutSaveNode.SaveId;
+	Reader << OutSaveNode.DeltaBaseId;
+	Reader << OutSaveNode.RemovedSaveIds;
+
+	// 1. Read the directory, holding the key, encoded size, flags and partition of every entry
+
+	int32 NumEntries = 0;
+	Reader << NumEntries;
+	if (Reader.IsError() || NumEntries < 0) return false;
+
+	struct FDirectoryEntry
+	{
+		FString Key;
+		uint32	Size = 0;
+		uint8	Flags = 0;
+		FString Partition;
+	};
+
+	TArray<FDirectoryEntry> Directory;
+	Directory.SetNum(NumEntries);
+	for (FDirectoryEntry& DirectoryEntry : Directory)
+	{
+		Reader << DirectoryEntry.Key;
+		Reader << DirectoryEntry.Size;
+		Reader << DirectoryEntry.Flags;
+		if (DirectoryEntry.Flags & EntryFlagPartitioned) Reader << DirectoryEntry.Partition;
+	}
+
+	if (Reader.IsError()) return false;
+
+	// 2. Decode the entries which pass the filter, and jump straight past every other one.
+	// Spawned saveables are never registered until they are spawned again, and saveables of partitions which are not
+	// streamed in are not registered either but must be carried forward, so both always pass.
+
+	int64 EntryOffset = Reader.Tell();
+	OutSaveNode.SaveData.Empty(NumEntries);
+	for (FDirectoryEntry& DirectoryEntry : Directory)
+	{
+		int64 EntryEnd = EntryOffset + DirectoryEntry.Size;
+		if (EntryEnd > Bytes.Num()) return false;
+
+		bool bSpawned = (DirectoryEntry.Flags & EntryFlagSpawned) != 0;
+		bool bPartitioned = !DirectoryEntry.Partition.IsEmpty();
+		bool bOmitted =
+			SaveableFilter && !bSpawned && !bPartitioned && !SaveableFilter->Contains(DirectoryEntry.Key);
+
+		FMSaveData& SaveData = OutSaveNode.SaveData.Add(MoveTemp(DirectoryEntry.Key));
+		SaveData.bSpawned = bSpawned;
+		if (bPartitioned) SaveData.Partition = FName(*DirectoryEntry.Partition);
+		SaveData.bOmitted = bOmitted;
+
+		if (!bOmitted)
+		{
+			Reader.Seek(EntryOffset);
+			SerializeSaveData(Reader, SaveData);
+			if (Reader.IsError() || Reader.Tell() != EntryEnd) return false;
+		}
+
+		EntryOffset = EntryEnd;
+	}
+
+	return true;
+}
+
+UMSaveNode* FMSaveStorage::LoadNode(const FGuid& SaveId, const TSet<FString>* SaveableFilter)
+{
+	check(IsInGameThread());
+
+	if (!SaveId.IsValid()) return nullptr;
+
+	// Waiting would also wait for every write before it, so a node still being written is left to its callers
+	const FPendingWrite* PendingWrite = PendingWrites.Find(SaveId);
+	if (PendingWrite && !PendingWrite->Task.IsCompleted())
+	{
+		UE_LOG(LogMSaveManager, Log, TEXT("Save node %s is still being written"), *SaveId.ToString());
+		return nullptr;
+	}
+
+	TArray<uint8> Bytes;
+	if (!ReadNode(SaveId, Bytes)) return nullptr;
+
+	if (!MSaveStorage::IsEncodedNode(Bytes)) return DecodeLegacyNode(Bytes);
+
+	UMSaveNode* SaveNode = Cast<UMSaveNode>(UGameplayStatics::CreateSaveGameObject(UMSaveNode::StaticClass()));
+	if (!DecodeNode(Bytes, *SaveNode, SaveableFilter) || !LoadPayloads(SaveNode)) return nullptr;
+
+	return SaveNode;
+}
+
+void FMSaveStorage::AsyncLoadNode(
+	const FGuid& SaveId, FOnNodeLoaded OnLoaded, TSharedPtr<const TSet<FString>> SaveableFilter)
+{
+	check(IsInGameThread());
+
+	if (!SaveId.IsValid())
+	{
+		OnLoaded(nullptr);
+		return;
+	}
+
+	UMSaveNode* SaveNode = Cast<UMSaveNode>(UGameplayStatics::CreateSaveGameObject(UMSaveNode::StaticClass()));
+	PendingLoads.Emplace(SaveNode);
+
+	// A node which is still being written can only be read once the write completes
+	TArray<UE::Tasks::TTask<bool>> Prerequisites;
+	if (FPendingWrite* PendingWrite = PendingWrites.Find(SaveId)) Prerequisites.Add(PendingWrite->Task);
+
+	UE::Tasks::Launch(
+		UE_SOURCE_LOCATION,
+		[Storage = AsShared(), SaveId, SaveNode, OnLoaded = MoveTemp(OnLoaded), SaveableFilter]() mutable -> void {
+			TArray<uint8> Bytes;
+			bool		  bRead = Storage->ReadNode(SaveId, Bytes);
+			bool		  bLegacy = bRead && !MSaveStorage::IsEncodedNode(Bytes);
+			bool		  bSuccess = bRead && !bLegacy && DecodeNode(Bytes, *SaveNode, SaveableFilter.Get());
+			bSuccess = bSuccess && Storage->LoadPayloads(SaveNode);
+
+			AsyncTask(
+				ENamedThreads::GameThread,
+				[Storage, SaveNode, bLegacy, bSuccess, Bytes = MoveTemp(Bytes), OnLoaded = MoveTemp(OnLoaded)]()
+				-> void {
+					Storage->PendingLoads.RemoveAllSwap([SaveNode](const TStrongObjectPtr<UMSaveNode>& PendingLoad) {
+						return PendingLoad.Get() == SaveNode;
+					});
+
+					if (bLegacy)
+						OnLoaded(Storage->DecodeLegacyNode(Bytes));
+					else
+						OnLoaded(bSuccess ? SaveNode : nullptr);
+				});
+		},
+		Prerequisites);
+}
+
+FMSaveStorage::FResolveTask FMSaveStorage::LaunchResolveNode(
+	TConstArrayView<FGuid> DeltaChain, TSharedPtr<const TSet<FString>> SaveableFilter, UMSaveNode*& OutSaveNode)
+{
+	check(IsInGameThread());
+
+	// 1. Create every node of the chain up front, since save nodes can't be created on worker threads
+
+	TArray<UMSaveNode*>			   Chain;
+	TArray<UE::Tasks::TTask<bool>> Prerequisites;
+	for (const FGuid& NodeId : DeltaChain)
+	{
+		UMSaveNode* SaveNode = Cast<UMSaveNode>(UGameplayStatics::CreateSaveGameObject(UMSaveNode::StaticClass()));
+		PendingLoads.Emplace(SaveNode);
+		Chain.Add(SaveNode);
+
+		if (FPendingWrite* PendingWrite = PendingWrites.Find(NodeId)) Prerequisites.Add(PendingWrite->Task);
+	}
+
+	OutSaveNode = Chain.IsEmpty() ? nullptr : Chain[0];
+
+	// 2. Read, decode and replay the chain on a worker thread
+
+	return UE::Tasks::Launch(
+		UE_SOURCE_LOCATION,
+		[Storage = AsShared(), NodeIds = TArray<FGuid>(DeltaChain), Chain, SaveableFilter]()
+			-> TSharedPtr<const TMap<FString, FMSaveData>> {
+			bool bSuccess = !Chain.IsEmpty();
+			for (int32 Index = 0; Index < Chain.Num() && bSuccess; ++Index)
+			{
+				TArray<uint8> Bytes;
+				bSuccess = Storage->ReadNode(NodeIds[Index], Bytes) && MSaveStorage::IsEncodedNode(Bytes)
+						&& DecodeNode(Bytes, *Chain[Index], SaveableFilter.Get())
+						&& Storage->LoadPayloads(Chain[Index]);
+			}
+
+			TSharedPtr<TMap<FString, FMSaveData>> SaveData;
+			if (bSuccess)
+			{
+				auto GetSaveNode = [&NodeIds, &Chain](const FGuid& NodeId) -> UMSaveNode* {
+					int32 Index = NodeIds.IndexOfByKey(NodeId);
+					return Index != INDEX_NONE ? Chain[Index] : nullptr;
+				};
+
+				SaveData = MakeShared<TMap<FString, FMSaveData>>();
+				if (!ResolveSaveData(NodeIds[0], GetSaveNode, *SaveData)) SaveData.Reset();
+			}
+
+			AsyncTask(ENamedThreads::GameThread, [Storage, Chain]() -> void {
+				Storage->PendingLoads.RemoveAllSwap([&Chain](const TStrongObjectPtr<UMSaveNode>& PendingLoad) {
+					return Chain.Contains(PendingLoad.Get());
+				});
+			});
+
+			return SaveData;
+		},
+		Prerequisites);
+}
+
+bool FMSaveStorage::StorePayloads(UMSaveNode* SaveNode, EMSaveCompression Compression)
+{
+	if (!SaveNode) return false;
+
+	TArray<FMSaveData*> Entries;
+	Entries.Reserve(SaveNode->SaveData.Num());
+	for (TTuple<FString, FMSaveData>& Entry : SaveNode->SaveData)
+	{
+		Entries.Add(&Entry.Value);
+	}
+
+	// Chunking, hashing and compressing dominate, and the blob store only locks around its lookups and appends
+	TArray<FMSaveBlobStats> EntryStats;
+	EntryStats.SetNum(Entries.Num());
+
+	std::atomic<bool> bSuccess = true;
+	ParallelFor(Entries.Num(), [this, &Entries, &EntryStats, Compression, &bSuccess](int32 Index) -> void {
+		// A mapped payload was read from the store in the first place, so its chunks are already there
+		if (Entries[Index]->IsPayloadMapped()) return;
+		if (!BlobStore.Store(Entries[Index]->Data, Entries[Index]->Chunks, Compression, &EntryStats[Index]))
+			bSuccess = false;
+	});
+
+	FMSaveNodeStats& Stats = SaveNode->Stats;
+	Stats.Compression = Compression;
+	Stats.PayloadSize = 0;
+	Stats.NewChunkSize = 0;
+	Stats.StoredSize = 0;
+	Stats.EncodeTimeMs = 0.0f;
+	for (const FMSaveBlobStats& Entry : EntryStats)
+	{
+		Stats.PayloadSize += Entry.PayloadSize;
+		Stats.NewChunkSize += Entry.NewChunkSize;
+		Stats.StoredSize += Entry.StoredSize;
+		Stats.EncodeTimeMs += Entry.CodecTime * 1000.0;
+	}
+
+	return bSuccess && BlobStore.Flush();
+}
+
+bool FMSaveStorage::LoadPayloads(UMSaveNode* SaveNode)
+{
+	if (!SaveNode) return false;
+
+	FMSaveBlobStats Stats;
+	for (TTuple<FString, FMSaveData>& Entry : SaveNode->SaveData)
+	{
+		FMSaveData& SaveData = Entry.Value;
+		if (SaveData.Chunks.IsEmpty()) continue;
+
+		// Mapping avoids allocating and copying every payload, which dominates loading large nodes
+		SaveData.MappedRegion = BlobStore.Map(SaveData.Chunks, SaveData.MappedChunks);
+		if (SaveData.MappedRegion) continue;
+
+		// Compressed payloads (or platforms without mapped files) need a copy of their own
+		SaveData.MappedChunks.Reset();
+		if (!BlobStore.Load(SaveData.Chunks, SaveData.Data, &Stats)) return false;
+	}
+
+	SaveNode->Stats.DecodeTimeMs = Stats.CodecTime * 1000.0;
+	return true;
+}
+
+bool FMSaveStorage::SaveNode(UMSaveNode* SaveNode, EMSaveCompression Compression)
+{
+	if (!StorePayloads(SaveNode, Compression)) return false;
+
+	const FMSaveNodeStats& Stats = SaveNode->Stats;
+	UE_LOG(
+		LogMSaveManager,
+		Verbose,
+		TEXT("Stored save node %s - %lld bytes of save data, %lld new, %lld on disk (%s, %.2fx, %.2fms)"),
+		*SaveNode->SaveId.ToString(),
+		Stats.PayloadSize,
+		Stats.NewChunkSize,
+		Stats.StoredSize,
+		*UEnum::GetDisplayValueAsText(Compression).ToString(),
+		Stats.GetCompressionRatio(),
+		Stats.EncodeTimeMs);
+
+	TArray<uint8> Bytes;
+	EncodeNode(*SaveNode, Bytes);
+
+	return PackFile.Append(SaveNode->SaveId, Bytes) && PackFile.Flush();
+}
+
+UE::Tasks::TTask<bool> FMSaveStorage::LaunchSaveNode(
+	UMSaveNode*									SaveNode,
+	EMSaveCompression							Compression,
+	TUniqueFunction<void(UMSaveNode& SaveNode)> AssembleNode,
+	UE::Tasks::FTask							AssemblePrerequisite,
+	TArray<FMSaveJournalOp>						JournalOps,
+	FOnNodeSaved								OnSaved)
+{
+	check(IsInGameThread());
+
+	// A slot being copied must not change until the copy completes
+	TArray<UE::Tasks::FTask> Prerequisites;
+	if (UE::Tasks::TTask<bool>* FileTask = MSaveStorage::PendingFileTasks.Find({ SlotName, UserIndex }))
+		Prerequisites.Add(*FileTask);
+
+	if (AssemblePrerequisite.IsValid()) Prerequisites.Add(AssemblePrerequisite);
+	if (PendingCommit.IsValid()) Prerequisites.Add(PendingCommit);
+
+	// Writes commit in the order the game thread made them, so the journal replays them in that order too
+	TArray<UE::Tasks::TTask<bool>> PreviousWrites;
+	for (TTuple<FGuid, FPendingWrite>& Previous : PendingWrites)
+	{
+		PreviousWrites.Add(Previous.Value.Task);
+	}
+	Prerequisites.Append(PreviousWrites);
+
+	FPendingWrite& PendingWrite = PendingWrites.Add(SaveNode->SaveId);
+	PendingWrite.SaveNode.Reset(SaveNode);
+	PendingWrite.Task = UE::Tasks::Launch(
+		UE_SOURCE_LOCATION,
+		[Storage = AsShared(),
+		 SaveNode,
+		 Compression,
+		 AssembleNode = MoveTemp(AssembleNode),
+		 JournalOps = MoveTemp(JournalOps),
+		 OnSaved = MoveTemp(OnSaved),
+		 PreviousWrites = MoveTemp(PreviousWrites)]() mutable -> bool {
+			// The node may be a delta against (or a child of) any node still in flight before it, so it must not
+			// commit once one of those failed
+			bool bSuccess = true;
+			for (UE::Tasks::TTask<bool>& Previous : PreviousWrites)
+			{
+				bSuccess &= Previous.GetResult();
+			}
+
+			if (!bSuccess)
+			{
+				UE_LOG(
+					LogMSaveManager,
+					Warning,
+					TEXT("Skipped writing save node %s, a save node before it failed"),
+					*SaveNode->SaveId.ToString());
+			}
+
+			if (bSuccess && AssembleNode) AssembleNode(*SaveNode);
+
+			// The metadata was recorded before assembling, when the node may still have been meant to be a delta
+			for (FMSaveJournalOp& Op : JournalOps)
+			{
+				if (Op.Type == EMSaveJournalOp::NodeAdded && Op.Metadata.SaveId == SaveNode->SaveId
+					&& SaveNode->IsKeyframe())
+				{
+					Op.Metadata.DeltaBaseId.Invalidate();
+					Op.Metadata.DeltaDepth = 0;
+				}
+			}
+
+			// The journal record is the commit point, a node without one is never part of the slot
+			bSuccess = bSuccess && Storage->SaveNode(SaveNode, Compression);
+			bSuccess = bSuccess && Storage->Journal.Append(JournalOps);
+
+			// Measured here, so the game thread never has to query the disk to summarize the slot
+			if (bSuccess) Storage->MeasureFiles();
+
+			AsyncTask(
+				ENamedThreads::GameThread,
+				[Storage, SaveNode, bSuccess, OnSaved = MoveTemp(OnSaved)]() -> void {
+					// The pending write holds the last strong reference, so notify before releasing it
+					if (OnSaved) OnSaved(SaveNode, bSuccess);
+					Storage->PendingWrites.Remove(SaveNode->SaveId);
+				});
+
+			return bSuccess;
+		},
+		Prerequisites);
+
+	return PendingWrite.Task;
+}
+
+UE::Tasks::TTask<bool> FMSaveStorage::LaunchCommitJournal(
+	TArray<FMSaveJournalOp> JournalOps, FOnJournalCommitted OnCommitted)
+{
+	check(IsInGameThread());
+
+	// Keeps the journal in the same order as the game thread made the changes
+	TArray<UE::Tasks::TTask<bool>> Prerequisites;
+	AddSlotPrerequisites(SlotName, UserIndex, Prerequisites);
+
+	PendingCommit = UE::Tasks::Launch(
+		UE_SOURCE_LOCATION,
+		[Storage = AsShared(), JournalOps = MoveTemp(JournalOps), OnCommitted = MoveTemp(OnCommitted)]() mutable
+		-> bool {
+			bool bSuccess = Storage->Journal.Append(JournalOps);
+			if (bSuccess)
+				Storage->MeasureFiles();
+			else
+				UE_LOG(LogMSaveManager, Warning, TEXT("Failed to commit journal - %s"), *Storage->SlotName);
+
+			AsyncTask(ENamedThreads::GameThread, [bSuccess, OnCommitted = MoveTemp(OnCommitted)]() -> void {
+				if (OnCommitted) OnCommitted(bSuccess);
+			});
+
+			return bSuccess;
+		},
+		Prerequisites);
+
+	return PendingCommit;
+}
+
+bool FMSaveStorage::ReplayJournal(UMSaveGame& SaveGame)
+{
+	return Journal.Replay(SaveGame);
+}
+
+void FMSaveStorage::CompactJournal(UMSaveGame& SaveGame, int32 Threshold)
+{
+	check(IsInGameThread());
+
+	if (bCompactingJournal || Journal.GetNumRecords() < Threshold) return;
+
+	// The slot is being copied, compacting can wait for the next save
+	const UE::Tasks::TTask<bool>* FileTask = MSaveStorage::PendingFileTasks.Find({ SlotName, UserIndex });
+	if (FileTask && !FileTask->IsCompleted()) return;
+
+	// Writes in flight (or failed ones not rolled back yet) have nodes in the slot which are not in the journal, and
+	// commits in flight have changes which are not in it yet either
+	if (HasUncommittedNodes() || !PendingCommit.IsCompleted()) return;
+
+	int64 Sequence = Journal.GetLastSequence();
+	int64 PreviousSequence = SaveGame.JournalSequence;
+
+	// Serializing has to happen on the game thread, but only writing it out is proportional to the disk
+	SaveGame.JournalSequence = Sequence;
+	TArray<uint8> Bytes;
+	bool		  bSerialized = UGameplayStatics::SaveGameToMemory(&SaveGame, Bytes);
+	SaveGame.JournalSequence = PreviousSequence;
+	if (!bSerialized) return;
+
+	bCompactingJournal = true;
+	UE::Tasks::Launch(
+		UE_SOURCE_LOCATION,
+		[Storage = AsShared(), SaveGame = TWeakObjectPtr<UMSaveGame>(&SaveGame), Sequence, Bytes = MoveTemp(Bytes)]()
+		-> void {
+			bool bSuccess = Storage->SaveGameSystem->SaveGame(false, *Storage->SlotName, Storage->UserIndex, Bytes);
+			bSuccess = bSuccess && Storage->Journal.Truncate(Sequence);
+			if (bSuccess) Storage->MeasureFiles();
+
+			AsyncTask(ENamedThreads::GameThread, [Storage, SaveGame, Sequence, bSuccess]() -> void {
+				Storage->bCompactingJournal = false;
+				if (!bSuccess)
+				{
+					UE_LOG(LogMSaveManager, Warning, TEXT("Failed to compact journal - %s"), *Storage->SlotName);
+					return;
+				}
+
+				if (SaveGame.IsValid()) SaveGame->JournalSequence = FMath::Max(SaveGame->JournalSequence, Sequence);
+			});
+		});
+}
+
+bool FMSaveStorage::HasUncommittedNodes()
+{
+	check(IsInGameThread());
+
+	for (TTuple<FGuid, FPendingWrite>& PendingWrite : PendingWrites)
+	{
+		if (!PendingWrite.Value.Task.IsCompleted() || !PendingWrite.Value.Task.GetResult()) return true;
+	}
+
+	return false;
+}
+
+UE::Tasks::TTask<bool> FMSaveStorage::LaunchRebaseNodes(TArray<FGuid> NodeIds, TSet<FGuid> RemovedNodeIds)
+{
+	check(IsInGameThread());
+
+	TArray<UE::Tasks::TTask<bool>> Prerequisites;
+	AddSlotPrerequisites(SlotName, UserIndex, Prerequisites);
+
+	// Save nodes can't be created on worker threads, so the same two are reused for every node
+	UMSaveNode* SaveNode = Cast<UMSaveNode>(UGameplayStatics::CreateSaveGameObject(UMSaveNode::StaticClass()));
+	UMSaveNode* DeltaBase = Cast<UMSaveNode>(UGameplayStatics::CreateSaveGameObject(UMSaveNode::StaticClass()));
+	PendingLoads.Emplace(SaveNode);
+	PendingLoads.Emplace(DeltaBase);
+
+	return UE::Tasks::Launch(
+		UE_SOURCE_LOCATION,
+		[Storage = AsShared(),
+		 NodeIds = MoveTemp(NodeIds),
+		 RemovedNodeIds = MoveTemp(RemovedNodeIds),
+		 SaveNode,
+		 DeltaBase]() -> bool {
+			auto DecodeEncodedNode = [&Storage](const FGuid& NodeId, UMSaveNode& OutSaveNode) -> bool {
+				TArray<uint8> Bytes;
+				bool		  bSuccess = Storage->ReadNode(NodeId, Bytes) && MSaveStorage::IsEncodedNode(Bytes)
+						  && DecodeNode(Bytes, OutSaveNode);
+				if (!bSuccess)
+					UE_LOG(LogMSaveManager, Warning, TEXT("  Failed to rebase save node %s"), *NodeId.ToString());
+				return bSuccess;
+			};
+
+			bool bSuccess = true;
+			for (int32 Index = 0; Index < NodeIds.Num() && bSuccess; ++Index)
+			{
+				bSuccess = DecodeEncodedNode(NodeIds[Index], *SaveNode);
+				while (bSuccess && RemovedNodeIds.Contains(SaveNode->DeltaBaseId))
+				{
+					bSuccess = DecodeEncodedNode(SaveNode->DeltaBaseId, *DeltaBase);
+					if (bSuccess) SaveNode->FoldDeltaBase(*DeltaBase);
+				}
+
+				if (!bSuccess) break;
+
+				TArray<uint8> Bytes;
+				EncodeNode(*SaveNode, Bytes);
+				bSuccess = Storage->PackFile.Append(NodeIds[Index], Bytes);
+			}
+
+			bSuccess = bSuccess && Storage->PackFile.Flush();
+
+			AsyncTask(ENamedThreads::GameThread, [Storage, SaveNode, DeltaBase]() -> void {
+				Storage->PendingLoads.RemoveAllSwap(
+					[SaveNode, DeltaBase](const TStrongObjectPtr<UMSaveNode>& PendingLoad) {
+						return PendingLoad.Get() == SaveNode || PendingLoad.Get() == DeltaBase;
+					});
+			});
+
+			return bSuccess;
+		},
+		Prerequisites);
+}
+
+UE::Tasks::TTask<bool> FMSaveStorage::LaunchReclaimNodes(TSet<FGuid> RemovedNodeIds, TArray<FGuid> RemainingNodeIds)
+{
+	check(IsInGameThread());
+
+	TArray<UE::Tasks::TTask<bool>> Prerequisites;
+	AddSlotPrerequisites(SlotName, UserIndex, Prerequisites);
+
+	UMSaveNode* SaveNode = Cast<UMSaveNode>(UGameplayStatics::CreateSaveGameObject(UMSaveNode::StaticClass()));
+	PendingLoads.Emplace(SaveNode);
+
+	UE::Tasks::TTask<bool> Task = UE::Tasks::Launch(
+		UE_SOURCE_LOCATION,
+		[Storage = AsShared(),
+		 RemovedNodeIds = MoveTemp(RemovedNodeIds),
+		 RemainingNodeIds = MoveTemp(RemainingNodeIds),
+		 SaveNode]() -> bool {
+			int64 SizeBefore = GetSlotFilesSize(Storage->SlotName, Storage->UserIndex);
+
+			// 1. Drop the removed nodes themselves
+
+			bool bSuccess = true;
+			for (const FGuid& NodeId : RemovedNodeIds)
+			{
+				if (!Storage->PackFile.Contains(NodeId))
+					bSuccess &= DeleteLegacyNode(Storage->SlotName, Storage->UserIndex, NodeId);
+			}
+
+			bSuccess &= Storage->PackFile.Compact(RemovedNodeIds);
+
+			// 2. Drop every chunk no remaining node references. Legacy nodes can't be decoded here, so slots which
+			// still have any keep every chunk.
+
+			bool bHasLegacyNodes = RemainingNodeIds.ContainsByPredicate([&Storage](const FGuid& NodeId) {
+				return !Storage->PackFile.Contains(NodeId);
+			});
+
+			if (bHasLegacyNodes)
+			{
+				UE_LOG(
+					LogMSaveManager, Log, TEXT("Kept every chunk of %s, it has legacy save nodes"), *Storage->SlotName);
+			}
+			else
+			{
+				TSet<FIoHash> LiveChunks;
+				bool		  bDecoded = true;
+				for (const FGuid& NodeId : Storage->PackFile.GetSaveIds())
+				{
+					TArray<uint8> Bytes;
+					bDecoded = Storage->PackFile.Read(NodeId, Bytes) && DecodeNode(Bytes, *SaveNode);
+					if (!bDecoded) break;
+
+					for (const TTuple<FString, FMSaveData>& Entry : SaveNode->SaveData)
+					{
+						for (const FMSaveChunkRef& Chunk : Entry.Value.Chunks)
+						{
+							LiveChunks.Add(Chunk.Hash);
+						}
+					}
+				}
+
+				// A chunk referenced by a node which can't be decoded would be lost for good, so nothing is dropped
+				bSuccess &= bDecoded && Storage->BlobStore.Compact(LiveChunks);
+			}
+
+			// 3. Drop their states from the timeline
+
+			bSuccess &= Storage->Timeline.Compact(RemovedNodeIds);
+
+			UE_LOG(
+				LogMSaveManager,
+				Log,
+				TEXT("Reclaimed %lld bytes from %d removed save nodes - %s"),
+				SizeBefore - Storage->MeasureFiles(),
+				RemovedNodeIds.Num(),
+				*Storage->SlotName);
+
+			AsyncTask(ENamedThreads::GameThread, [Storage, SaveNode]() -> void {
+				Storage->PendingLoads.RemoveAllSwap([SaveNode](const TStrongObjectPtr<UMSaveNode>& PendingLoad) {
+					return PendingLoad.Get() == SaveNode;
+				});
+			});
+
+			return bSuccess;
+		},
+		Prerequisites);
+
+	MSaveStorage::PendingFileTasks.Add({ SlotName, UserIndex }, Task);
+	return Task;
+}
+
+void FMSaveStorage::TrainDictionary(EMSaveCompression Compression, int32 Interval)
+{
+	check(IsInGameThread());
+
+	if (!FMSaveCodec::UsesDictionary(Compression) || Interval <= 0) return;
+	if (bTrainingDictionary || ++NodesSinceDictionaryTraining < Interval) return;
+
+	NodesSinceDictionaryTraining = 0;
+	bTrainingDictionary = true;
+
+	// Chunks stored while training still use the previous dictionary, which stays readable
+	UE::Tasks::Launch(UE_SOURCE_LOCATION, [Storage = AsShared()]() -> void {
+		bool bSuccess = Storage->BlobStore.TrainDictionary() && Storage->BlobStore.Flush();
+
+		AsyncTask(ENamedThreads::GameThread, [Storage, bSuccess]() -> void {
+			Storage->bTrainingDictionary = false;
+			if (!bSuccess) UE_LOG(LogMSaveManager, Log, TEXT("Skipped training dictionary - %s"), *Storage->SlotName);
+		});
+	});
+}
+
+bool FMSaveStorage::ReadNode(const FGuid& SaveId, TArray<uint8>& OutBytes)
+{
+	if (PackFile.Read(SaveId, OutBytes)) return true;
+
+	// Nodes written before the pack file existed each live in their own save game file
+	return SaveGameSystem->LoadGame(false, *GetNodeSlotName(SlotName, SaveId), UserIndex, OutBytes);
+}
+
+UMSaveNode* FMSaveStorage::DecodeLegacyNode(const TArray<uint8>& Bytes)
+{
+	check(IsInGameThread());
+
+	// Legacy nodes hold their payloads in Data itself, which is transient now that the blob store holds them. It is
+	// only serialized with tagged properties here, so it is briefly made persistent again for them to be read back.
+	FProperty* DataProperty =
+		FindFProperty<FProperty>(FMSaveData::StaticStruct(), GET_MEMBER_NAME_CHECKED(FMSaveData, Data));
+	DataProperty->ClearPropertyFlags(CPF_Transient);
+	UMSaveNode* SaveNode = Cast<UMSaveNode>(UGameplayStatics::LoadGameFromMemory(Bytes));
+	DataProperty->SetPropertyFlags(CPF_Transient);
+
+	if (!SaveNode || !LoadPayloads(SaveNode)) return nullptr;
+
+	// Every legacy entry carries a payload, so a missing one means it was not read back
+	int32 NumMissing = Algo::CountIf(SaveNode->SaveData, [](const TTuple<FString, FMSaveData>& Entry) {
+		return Entry.Value.Data.IsEmpty() && Entry.Value.Chunks.IsEmpty();
+	});
+
+	if (NumMissing > 0)
+	{
+		UE_LOG(
+			LogMSaveManager,
+			Warning,
+			TEXT("Legacy save node %s is missing the payload of %d saveables"),
+			*SaveNode->SaveId.ToString(),
+			NumMissing);
+	}
+
+	return SaveNode;
+}
+
+bool FMSaveStorage::ResolveSaveData(
+	const FGuid& SaveId, FGetSaveNode GetSaveNode, TMap<FString, FMSaveData>& OutSaveData)
+{
+	OutSaveData.Reset();
+
+	// 1. Walk back to the keyframe, collecting every delta along the way
+	TArray<UMSaveNode*, TInlineAllocator<16>> Chain;
+	for (FGuid NodeId = SaveId; NodeId.IsValid();)
+	{
+		UMSaveNode* SaveNode = GetSaveNode(NodeId);
+		if (!SaveNode)
+		{
+			UE_LOG(
+				LogMSaveManager,
+				Warning,
+				TEXT("Failed to resolve save node %s, missing delta base %s"),
+				*SaveId.ToString(),
+				*NodeId.ToString());
+			return false;
+		}
+
+		Chain.Add(SaveNode);
+		NodeId = SaveNode->DeltaBaseId;
+	}
+
+	// 2. Replay the chain forwards, starting from the keyframe
+	for (int32 Index = Chain.Num() - 1; Index >= 0; --Index)
+	{
+		Chain[Index]->ApplyTo(OutSaveData);
+	}
+
+	return true;
+}
+
+const FMSaveData* FMSaveStorage::FindSaveData(const FGuid& SaveId, const FString& SaveableId, FGetSaveNode GetSaveNode)
+{
+	for (FGuid NodeId = SaveId; NodeId.IsValid();)
+	{
+		UMSaveNode* SaveNode = GetSaveNode(NodeId);
+		if (!SaveNode) return nullptr;
+
+		const FMSaveData* SaveData = SaveNode->SaveData.Find(SaveableId);
+		if (SaveData) return SaveData;
+		if (SaveNode->RemovedSaveIds.Contains(SaveableId)) return nullptr;
+
+		NodeId = SaveNode->DeltaBaseId;
+	}
+
+	return nullptr;
+}
@@ -0,0 +1,309 @@
+// Copyright © Bedrockbreaker 2025. MIT License
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SaveSystem/MSaveBlobStore.h"
+#include "SaveSystem/MSaveJournal.h"
+#include "SaveSystem/MSavePackFile.h"
+#include "SaveSystem/MSaveTimeline.h"
+#include "Tasks/Task.h"
+#include "UObject/StrongObjectPtr.h"
+
+#include <atomic>
+
+class ISaveGameSystem;
+class UMSaveGame;
+class UMSaveNode;
+struct FMSaveData;
+
+/**
+ * Disk storage for the save nodes of a single save slot.
+ * Node payloads live in the slot's content-addressed blob store, the nodes themselves only hold chunk references.
+ * Instances are shared between everything which accesses the same slot, see FMSaveStorage::Open.
+ *
+ * Nodes are encoded with a plain binary encoding rather than as USaveGames, so that encoding and decoding can run on
+ * worker threads, and are appended to the slot's pack file. Nodes written before either of those (as one save game
+ * file per node) are still readable on the game thread.
+ *
+ * The slot's metadata is stored as a checkpoint (the UMSaveGame itself) plus a journal of changes since then.
+ * A node and its metadata are committed together: the node is appended to the pack file first, and only becomes part
+ * of the slot once the journal record referencing it has been written.
+ *
+ * The slot's own files are accessed directly through the file manager rather than through ISaveGameSystem, which only
+ * reads and writes whole files. This assumes a platform whose save games are plain files below the project's Saved
+ * directory (as with the generic save game system). Platforms with a dedicated save system are not supported, and
+ * creating a slot on one fails, see IsFileStorageSupported.
+ */
+class FMSaveStorage : public TSharedFromThis<FMSaveStorage>
+{
+public:
+	/** Returns a save node, or null if it could not be found */
+	using FGetSaveNode = TFunctionRef<UMSaveNode*(const FGuid& SaveId)>;
+
+	/** Called on the game thread once a save node has been written */
+	using FOnNodeSaved = TUniqueFunction<void(UMSaveNode* SaveNode, bool bSuccess)>;
+
+	/** Called on the game thread once a save node has been loaded (null on failure) */
+	using FOnNodeLoaded = TUniqueFunction<void(UMSaveNode* SaveNode)>;
+
+	/** Called on the game thread once metadata changes have been committed to the journal */
+	using FOnJournalCommitted = TUniqueFunction<void(bool bSuccess)>;
+
+	/** Completes with the effective save data of a node (null on failure) */
+	using FResolveTask = UE::Tasks::TTask<TSharedPtr<const TMap<FString, FMSaveData>>>;
+
+	FMSaveStorage(const FString& InSlotName, const int32 InUserIndex);
+
+	/** Returns the storage for a save slot, reusing the existing instance if the slot is already open */
+	static TSharedRef<FMSaveStorage> Open(const FString& SlotName, const int32 UserIndex);
+
+	/** Returns the path of a file belonging to a save slot, alongside the slot's .sav file, see FMSaveStorage */
+	static FString GetSlotFilePath(const FString& SlotName, const int32 UserIndex, const TCHAR* Extension);
+
+	/** Returns the slot name a legacy save node is stored under, from before nodes were stored in pack files */
+	static FString GetNodeSlotName(const FString& SlotName, const FGuid& SaveId);
+
+	/**
+	 * Whether the platform stores save games as plain files alongside where the slot's own files go, checked through
+	 * the .sav file of a slot which has just been saved. Logs an error if not.
+	 */
+	static bool IsFileStorageSupported(const FString& SlotName);
+
+	/** Deletes every file belonging to a save slot, including its journal, other than legacy save nodes and the slot */
+	static bool DeleteSlotFiles(const FString& SlotName, const int32 UserIndex);
+
+	/**
+	 * Returns the total size of every file belonging to a save slot, other than legacy save nodes and the slot.
+	 * Queries the disk, so it should not be called on the game thread.
+	 */
+	static int64 GetSlotFilesSize(const FString& SlotName, const int32 UserIndex);
+
+	/**
+	 * Returns the size of an open slot's files as of its last write, without touching the disk, see GetSlotFilesSize.
+	 * Returns INDEX_NONE if the slot is not open or has not been written since it was opened. Game thread only.
+	 */
+	static int64 FindSlotFilesSize(const FString& SlotName, const int32 UserIndex);
+
+	/** Deletes a single legacy save node, if it exists */
+	static bool DeleteLegacyNode(const FString& SlotName, const int32 UserIndex, const FGuid& SaveId);
+
+	/** Blocks until every save node write and journal commit in flight for a save slot has completed */
+	static void WaitForPendingWrites(const FString& SlotName, const int32 UserIndex);
+
+	/**
+	 * Deletes the files holding a save slot's nodes on a worker thread, after any writes, commits, copies or deletions
+	 * in flight for the slot. Legacy save nodes are found by name, so the slot never has to be loaded. The slot itself
+	 * is left alone.
+	 */
+	static UE::Tasks::TTask<bool> LaunchDeleteSlot(const FString& SlotName, const int32 UserIndex);
+
+	/**
+	 * Copies a save slot on a worker thread, after any writes, commits, copies or deletions in flight for either slot.
+	 * Every file is copied byte for byte (the slot itself, its journal, its node storage and any legacy save nodes), so
+	 * no node is ever decoded. The slot is copied last, so the copy only exists once everything it references does.
+	 * The copy still carries the original's slot name, see UMSaveManager::LoadSaveSlot.
+	 */
+	static UE::Tasks::TTask<bool> LaunchCopySlot(
+		const FString& OriginalSlotName,
+		const int32	   OriginalUserIndex,
+		const FString& NewSlotName,
+		const int32	   NewUserIndex);
+
+	/** Blocks until a copy or deletion in flight for a save slot (if any) has completed */
+	static void WaitForFileTasks(const FString& SlotName, const int32 UserIndex);
+
+	/** Encodes the persistent fields of a save node (everything but its payloads). Thread-safe. */
+	static void EncodeNode(const UMSaveNode& SaveNode, TArray<uint8>& OutBytes);
+
+	/**
+	 * Decodes a save node written by EncodeNode. Thread-safe.
+	 * Entries for saveables outside of SaveableFilter (if any) are skipped over, and only their keys are decoded.
+	 */
+	static bool DecodeNode(
+		TConstArrayView<uint8> Bytes, UMSaveNode& OutSaveNode, const TSet<FString>* SaveableFilter = nullptr);
+
+	/**
+	 * Loads a single save node (which may be a delta), including its payloads.
+	 * Given a filter, entries for any other saveable are only loaded as placeholders (see FMSaveData::bOmitted), and
+	 * their payloads are never touched.
+	 * A node which is still being written can't be read yet, and is never waited for. AsyncLoadNode waits for the write
+	 * on a worker thread instead.
+	 */
+	UMSaveNode* LoadNode(const FGuid& SaveId, const TSet<FString>* SaveableFilter = nullptr);
+
+	/** Loads a single save node on a worker thread, see LoadNode */
+	void AsyncLoadNode(
+		const FGuid& SaveId, FOnNodeLoaded OnLoaded, TSharedPtr<const TSet<FString>> SaveableFilter = nullptr);
+
+	/**
+	 * Loads a save node along with its delta chain, and resolves its effective save data, all on a worker thread.
+	 * DeltaChain lists the node followed by every delta base down to its keyframe, as recorded in the slot's metadata.
+	 * OutSaveNode is the node itself, kept alive until the task completes. Chains holding legacy nodes fail, since
+	 * those can only be decoded on the game thread.
+	 */
+	FResolveTask LaunchResolveNode(
+		TConstArrayView<FGuid>			 DeltaChain,
+		TSharedPtr<const TSet<FString>> SaveableFilter,
+		UMSaveNode*&					 OutSaveNode);
+
+	/**
+	 * Moves the payloads of a save node into the blob store, leaving only chunk references to be encoded.
+	 * New chunks are compressed with Compression, and the node's stats are updated.
+	 */
+	bool StorePayloads(UMSaveNode* SaveNode, EMSaveCompression Compression = EMSaveCompression::None);
+
+	/**
+	 * Makes the payloads of a save node readable. Payloads are mapped in place from the blob store where possible,
+	 * and only read into memory where mapping is not supported.
+	 */
+	bool LoadPayloads(UMSaveNode* SaveNode);
+
+	/** Stores a save node's payloads, then writes the node itself. Thread-safe. */
+	bool SaveNode(UMSaveNode* SaveNode, EMSaveCompression Compression = EMSaveCompression::None);
+
+	/**
+	 * Assembles a save node on a worker thread once AssemblePrerequisite completes, then stores its payloads, writes
+	 * it, and commits JournalOps. A node which was assembled as a keyframe after all is committed as one.
+	 * The node is kept alive until the write completes, and must not be touched by the game thread until then.
+	 * Loading the node waits for the write. Writes to the same slot run one after the other, and a write fails without
+	 * touching the disk if any write launched before it failed.
+	 */
+	UE::Tasks::TTask<bool> LaunchSaveNode(
+		UMSaveNode*									SaveNode,
+		EMSaveCompression							Compression,
+		TUniqueFunction<void(UMSaveNode& SaveNode)>	AssembleNode,
+		UE::Tasks::FTask							AssemblePrerequisite,
+		TArray<FMSaveJournalOp>						JournalOps,
+		FOnNodeSaved								OnSaved = nullptr);
+
+	/**
+	 * Commits metadata changes which don't add a node on a worker thread, after any node writes and commits in flight,
+	 * so the journal keeps the order the game thread made the changes in.
+	 */
+	UE::Tasks::TTask<bool> LaunchCommitJournal(
+		TArray<FMSaveJournalOp> JournalOps, FOnJournalCommitted OnCommitted = nullptr);
+
+	/** Applies every journal record newer than a slot's checkpoint to it */
+	bool ReplayJournal(UMSaveGame& SaveGame);
+
+	/**
+	 * Folds the journal into a new checkpoint once it has grown past the compaction threshold.
+	 * The checkpoint is serialized on the game thread, written and the journal truncated on a worker thread.
+	 */
+	void CompactJournal(UMSaveGame& SaveGame, int32 Threshold);
+
+	/** Whether any node write is still in flight, or failed without being rolled back yet. Game thread only. */
+	bool HasUncommittedNodes();
+
+	/**
+	 * Rewrites save nodes whose delta base is about to be removed on a worker thread, after any writes in flight.
+	 * Every removed delta base is folded into the node, which is then appended to the pack file again under the same
+	 * id, so it no longer depends on any removed node. Its effective save data is unchanged, so the slot stays valid
+	 * whether or not the removal is ever committed. Fails for legacy nodes, which can't be decoded off the game thread.
+	 */
+	UE::Tasks::TTask<bool> LaunchRebaseNodes(TArray<FGuid> NodeIds, TSet<FGuid> RemovedNodeIds);
+
+	/**
+	 * Reclaims the space of removed save nodes on a worker thread, once their removal has been committed.
+	 * The pack file and timeline are rewritten without them, and the blob store without any chunk no remaining node
+	 * references. Saves wait for the reclaim, like for slot copies and deletions.
+	 */
+	UE::Tasks::TTask<bool> LaunchReclaimNodes(TSet<FGuid> RemovedNodeIds, TArray<FGuid> RemainingNodeIds);
+
+	/**
+	 * Retrains the blob store's compression dictionary on a worker thread, once Interval nodes have been saved since it
+	 * was last trained. Does nothing for codecs without dictionaries.
+	 */
+	void TrainDictionary(EMSaveCompression Compression, int32 Interval);
+
+	/** The name of the save slot */
+	const FString& GetSlotName() const { return SlotName; }
+
+	/** The user index of the save slot */
+	int32 GetUserIndex() const { return UserIndex; }
+
+	/** The content-addressed store holding every payload in this slot */
+	FMSaveBlobStore& GetBlobStore() { return BlobStore; }
+
+	/** The index of how every saveable's state changed across this slot */
+	FMSaveTimeline& GetTimeline() { return Timeline; }
+
+	/**
+	 * Reconstructs the full save data of a node, by applying its chain of deltas on top of its keyframe.
+	 * Returns false if any node in the chain is missing.
+	 */
+	static bool ResolveSaveData(const FGuid& SaveId, FGetSaveNode GetSaveNode, TMap<FString, FMSaveData>& OutSaveData);
+
+	/**
+	 * Finds the effective save data of a single saveable within a node, without reconstructing the entire node.
+	 * Returns null if the saveable has no save data in the node.
+	 */
+	static const FMSaveData* FindSaveData(const FGuid& SaveId, const FString& SaveableId, FGetSaveNode GetSaveNode);
+
+private:
+	/** The name of the save slot */
+	FString SlotName;
+
+	/** The user index of the save slot */
+	int32 UserIndex = 0;
+
+	/** Holds the payloads of every node in the slot */
+	FMSaveBlobStore BlobStore;
+
+	/** Holds every encoded node in the slot */
+	FMSavePackFile PackFile;
+
+	/** Records metadata changes since the slot's checkpoint */
+	FMSaveJournal Journal;
+
+	/** Indexes saveable state changes across the slot */
+	FMSaveTimeline Timeline;
+
+	/** Whether a checkpoint is being written. Game thread only. */
+	bool bCompactingJournal = false;
+
+	/** The number of nodes saved since the compression dictionary was last trained. Game thread only. */
+	int32 NodesSinceDictionaryTraining = 0;
+
+	/** Whether a compression dictionary is being trained. Game thread only. */
+	bool bTrainingDictionary = false;
+
+	/** The size of the slot's files, measured by the worker threads writing them. INDEX_NONE until first measured. */
+	std::atomic<int64> FilesSize = INDEX_NONE;
+
+	/** The platform save system legacy nodes are read through */
+	ISaveGameSystem* SaveGameSystem = nullptr;
+
+	/** A save node write which has not completed yet */
+	struct FPendingWrite
+	{
+		UE::Tasks::TTask<bool>	     Task;
+		TStrongObjectPtr<UMSaveNode> SaveNode;
+	};
+
+	/** Save node writes in flight, keyed by save id. Game thread only. */
+	TMap<FGuid, FPendingWrite> PendingWrites;
+
+	/** Save nodes being loaded on worker threads. Game thread only. */
+	TArray<TStrongObjectPtr<UMSaveNode>> PendingLoads;
+
+	/** The latest journal commit, which every later write and commit waits for. Game thread only. */
+	UE::Tasks::TTask<bool> PendingCommit;
+
+	/**
+	 * Adds every write, journal commit, copy or deletion in flight for a save slot to a list of prerequisites.
+	 * Game thread only.
+	 */
+	static void AddSlotPrerequisites(
+		const FString& SlotName, const int32 UserIndex, TArray<UE::Tasks::TTask<bool>>& OutPrerequisites);
+
+	/** Measures the size of the slot's files into FilesSize, and returns it. Worker threads only. */
+	int64 MeasureFiles();
+
+	/** Reads the encoded bytes of a save node. Thread-safe. */
+	bool ReadNode(const FGuid& SaveId, TArray<uint8>& OutBytes);
+
+	/** Decodes a save node written before nodes were encoded by EncodeNode. Game thread only. */
+	UMSaveNode* DecodeLegacyNode(const TArray<uint8>& Bytes);
+};
@@ -0,0 +1,263 @@
+// Copyright © Bedrockbreaker 2025. MIT License
+
+#include "SaveSystem/MSaveTableArchive.h"
+
+#include "CoreGlobals.h"
+#include "SaveSystem/MSaveManager.h"
+#include "Serialization/ArchiveUObject.h"
+#include "UObject/SoftObjectPtr.h"
+
+namespace MSaveTableArchive
+{
+	/** Starts every payload with tables. Payloads from before tables start with a property tag instead. */
+	constexpr uint32 TablesMagic = 0x4C42544D; // "MTBL"
+} // namespace MSaveTableArchive
+
+bool FMSaveTables::Serialize(FArchive& Ar)
+{
+	using namespace MSaveTableArchive;
+
+	uint32 Magic = TablesMagic;
+	if (Ar.IsLoading())
+	{
+		if (Ar.TotalSize() - Ar.Tell() < static_cast<int64>(sizeof(Magic))) return false;
+
+		int64 Start = Ar.Tell();
+		Ar << Magic;
+		if (Magic != TablesMagic)
+		{
+			Ar.Seek(Start);
+			return false;
+		}
+	}
+	else
+	{
+		Ar << Magic;
+	}
+
+	// Names are written as strings, since name indices are meaningless outside of this process
+	int32 NumNames = Names.Num();
+	Ar << NumNames;
+	if (NumNames < 0) Ar.SetError();
+	if (Ar.IsError()) return false;
+
+	if (Ar.IsLoading()) Names.SetNum(NumNames);
+
+	for (FName& Name : Names)
+	{
+		FString NameString = Ar.IsLoading() ? FString() : Name.ToString();
+		Ar << NameString;
+		if (Ar.IsLoading()) Name = FName(*NameString);
+	}
+
+	int32 NumReferences = References.Num();
+	Ar << NumReferences;
+	if (NumReferences < 0) Ar.SetError();
+	if (Ar.IsError()) return false;
+
+	if (Ar.IsLoading()) References.SetNum(NumReferences);
+
+	for (FReference& Reference : References)
+	{
+		Ar << Reference.bSaveable;
+		Ar << Reference.Path;
+	}
+
+	return !Ar.IsError();
+}
+
+FMSaveTableArchive::FMSaveTableArchive(FArchive& InInnerArchive, FMSaveTables& InTables, FGetSaveId InGetSaveId)
+	: FArchiveProxy(InInnerArchive), Tables(InTables), GetSaveId(MoveTemp(InGetSaveId))
+{
+}
+
+FMSaveTableArchive::FMSaveTableArchive(
+	FArchive&						InInnerArchive,
+	FMSaveTables&					InTables,
+	FFindSaveable					InFindSaveable,
+	UObject*						InOwner,
+	TArray<FMUnresolvedReference>*	OutUnresolved)
+	: FArchiveProxy(InInnerArchive),
+	  Tables(InTables),
+	  FindSaveable(MoveTemp(InFindSaveable)),
+	  Owner(InOwner),
+	  Unresolved(OutUnresolved)
+{
+	ResolvedReferences.SetNumZeroed(Tables.References.Num());
+	bResolved.Init(false, Tables.References.Num());
+}
+
+FArchive& FMSaveTableArchive::operator<<(FName& Value)
+{
+	uint32 Index = 0;
+	if (IsLoading())
+	{
+		InnerArchive.SerializeIntPacked(Index);
+		if (!Tables.Names.IsValidIndex(Index))
+		{
+			SetError();
+			Value = NAME_None;
+			return *this;
+		}
+
+		Value = Tables.Names[Index];
+		return *this;
+	}
+
+	if (const int32* ExistingIndex = NameIndices.Find(Value))
+	{
+		Index = *ExistingIndex;
+	}
+	else
+	{
+		Index = Tables.Names.Add(Value);
+		NameIndices.Add(Value, Index);
+	}
+
+	InnerArchive.SerializeIntPacked(Index);
+	return *this;
+}
+
+FArchive& FMSaveTableArchive::operator<<(UObject*& Value)
+{
+	if (IsLoading())
+	{
+		FMUnresolvedReference Reference;
+		Value = ReadReference(Reference);
+		if (!Reference.SaveId.IsEmpty())
+		{
+			Reference.ObjectSlot = &Value;
+			AddUnresolved(MoveTemp(Reference), &Value);
+		}
+
+		return *this;
+	}
+
+	// Indices are offset by one, so zero stands for null
+	uint32 Index = 0;
+
+	if (!Value)
+	{
+		InnerArchive.SerializeIntPacked(Index);
+		return *this;
+	}
+
+	if (const int32* ExistingIndex = ReferenceIndices.Find(Value))
+	{
+		Index = *ExistingIndex + 1;
+	}
+	else
+	{
+		FMSaveTables::FReference Reference;
+		Reference.Path = GetSaveId ? GetSaveId(Value) : FString();
+		Reference.bSaveable = !Reference.Path.IsEmpty();
+		if (!Reference.bSaveable) Reference.Path = Value->GetPathName();
+
+		int32 NewIndex = Tables.References.Add(MoveTemp(Reference));
+		ReferenceIndices.Add(Value, NewIndex);
+		Index = NewIndex + 1;
+	}
+
+	InnerArchive.SerializeIntPacked(Index);
+	return *this;
+}
+
+FArchive& FMSaveTableArchive::operator<<(FObjectPtr& Value)
+{
+	if (!IsLoading()) return FArchiveUObject::SerializeObjectPtr(*this, Value);
+
+	// Read in place rather than through a temporary, so an unresolved reference can be patched later
+	FMUnresolvedReference Reference;
+	Value = FObjectPtr(ReadReference(Reference));
+	if (!Reference.SaveId.IsEmpty())
+	{
+		Reference.ObjectPtrSlot = &Value;
+		AddUnresolved(MoveTemp(Reference), &Value);
+	}
+
+	return *this;
+}
+
+FArchive& FMSaveTableArchive::operator<<(FWeakObjectPtr& Value)
+{
+	if (!IsLoading()) return FArchiveUObject::SerializeWeakObjectPtr(*this, Value);
+
+	FMUnresolvedReference Reference;
+	Value = ReadReference(Reference);
+	if (!Reference.SaveId.IsEmpty())
+	{
+		Reference.WeakSlot = &Value;
+		AddUnresolved(MoveTemp(Reference), &Value);
+	}
+
+	return *this;
+}
+
+FArchive& FMSaveTableArchive::operator<<(FSoftObjectPtr& Value)
+{
+	return FArchiveUObject::SerializeSoftObjectPtr(*this, Value);
+}
+
+FArchive& FMSaveTableArchive::operator<<(FSoftObjectPath& Value)
+{
+	// Soft paths are made of names, so they go through the name table
+	Value.SerializePath(*this);
+	return *this;
+}
+
+UObject* FMSaveTableArchive::ResolveReference(int32 Index)
+{
+	if (bResolved[Index]) return ResolvedReferences[Index];
+
+	const FMSaveTables::FReference& Reference = Tables.References[Index];
+
+	UObject* Object = nullptr;
+	if (Reference.bSaveable)
+	{
+		Object = FindSaveable ? FindSaveable(Reference.Path) : nullptr;
+		if (!Object)
+			UE_LOG(LogMSaveManager, Verbose, TEXT("  Referenced saveable %s is not registered yet"), *Reference.Path);
+	}
+	else
+	{
+		Object = StaticFindObject(UObject::StaticClass(), nullptr, *Reference.Path);
+		if (!Object) Object = LoadObject<UObject>(nullptr, *Reference.Path);
+	}
+
+	ResolvedReferences[Index] = Object;
+	bResolved[Index] = true;
+	return Object;
+}
+
+UObject* FMSaveTableArchive::ReadReference(FMUnresolvedReference& OutUnresolved)
+{
+	// Indices are offset by one, so zero stands for null
+	uint32 Index = 0;
+	InnerArchive.SerializeIntPacked(Index);
+	if (Index > static_cast<uint32>(Tables.References.Num()))
+	{
+		SetError();
+		return nullptr;
+	}
+
+	if (Index == 0) return nullptr;
+
+	UObject*						Object = ResolveReference(Index - 1);
+	const FMSaveTables::FReference& Reference = Tables.References[Index - 1];
+	if (!Object && Reference.bSaveable && Unresolved) OutUnresolved.SaveId = Reference.Path;
+
+	return Object;
+}
+
+void FMSaveTableArchive::AddUnresolved(FMUnresolvedReference&& Reference, const void* Slot)
+{
+	// Properties of the owner itself stay put, unlike elements of its containers
+	const uint8* OwnerStart = reinterpret_cast<const uint8*>(Owner);
+	const uint8* SlotAddress = static_cast<const uint8*>(Slot);
+	Reference.bInline = Owner && SlotAddress >= OwnerStart
+					 && SlotAddress < OwnerStart + Owner->GetClass()->GetPropertiesSize();
+
+	Reference.Owner = Owner;
+	Reference.Frame = GFrameCounter;
+	Unresolved->Add(MoveTemp(Reference));
+}
@@ -0,0 +1,111 @@
+// Copyright © Bedrockbreaker 2025. MIT License
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Serialization/ArchiveProxy.h"
+
+struct FMUnresolvedReference;
+
+/**
+ * The names and object references of a single payload, written once ahead of the serialized properties.
+ * Kept per payload rather than per node, so identical states still encode to identical payloads, which the blob store
+ * deduplicates and delta nodes diff against.
+ */
+struct FMSaveTables
+{
+	/** An object referenced by a payload */
+	struct FReference
+	{
+		/** Whether Path holds the save id of a saveable, rather than the path of any other object */
+		bool bSaveable = false;
+
+		/** The save id or object path */
+		FString Path;
+	};
+
+	/** Every name serialized by the payload */
+	TArray<FName> Names;
+
+	/** Every object referenced by the payload */
+	TArray<FReference> References;
+
+	/**
+	 * Writes the tables, or reads them back. Returns false if the payload has no tables (leaving it untouched), or if
+	 * they are corrupt (flagging the archive with an error).
+	 */
+	bool Serialize(FArchive& Ar);
+};
+
+/**
+ * Proxy archive serializing names and object references as indices into a payload's tables, rather than as strings.
+ *
+ * References to registered saveables are stored as their save id, and resolved through the saveable registry rather
+ * than by path. Every other reference is stored by path, and resolved once per payload however often it appears.
+ * References to saveables which are not registered yet are read as null, and recorded so they can be patched later.
+ */
+class FMSaveTableArchive : public FArchiveProxy
+{
+public:
+	/** Returns the save id of a registered saveable (empty if the object is not one) */
+	using FGetSaveId = TFunction<FString(UObject* Object)>;
+
+	/** Returns the registered saveable with a save id (null if none) */
+	using FFindSaveable = TFunction<UObject*(const FString& SaveId)>;
+
+	/** Writes through the archive, filling the tables */
+	FMSaveTableArchive(FArchive& InInnerArchive, FMSaveTables& InTables, FGetSaveId InGetSaveId);
+
+	/**
+	 * Reads through the archive into Owner, with tables which were read back already.
+	 * References to saveables FindSaveable can't find yet are added to OutUnresolved, if given.
+	 */
+	FMSaveTableArchive(
+		FArchive&						InInnerArchive,
+		FMSaveTables&					InTables,
+		FFindSaveable					InFindSaveable,
+		UObject*						InOwner = nullptr,
+		TArray<FMUnresolvedReference>*	OutUnresolved = nullptr);
+
+	virtual FArchive& operator<<(FName& Value) override;
+	virtual FArchive& operator<<(UObject*& Value) override;
+	virtual FArchive& operator<<(FObjectPtr& Value) override;
+	virtual FArchive& operator<<(FWeakObjectPtr& Value) override;
+	virtual FArchive& operator<<(FSoftObjectPtr& Value) override;
+	virtual FArchive& operator<<(FSoftObjectPath& Value) override;
+
+private:
+	/** The tables of the payload */
+	FMSaveTables& Tables;
+
+	/** Maps names to indices into Tables.Names, while writing */
+	TMap<FName, int32> NameIndices;
+
+	/** Maps objects to indices into Tables.References, while writing */
+	TMap<const UObject*, int32> ReferenceIndices;
+
+	/** The objects of Tables.References, as they get resolved while reading */
+	TArray<UObject*> ResolvedReferences;
+
+	/** Whether each entry of ResolvedReferences was resolved already */
+	TBitArray<> bResolved;
+
+	FGetSaveId	  GetSaveId;
+	FFindSaveable FindSaveable;
+
+	/** The object being read into, and where references to saveables which are not registered yet go */
+	UObject*					   Owner = nullptr;
+	TArray<FMUnresolvedReference>* Unresolved = nullptr;
+
+	/** Resolves a reference, the first time it is read */
+	UObject* ResolveReference(int32 Index);
+
+	/**
+	 * Reads a reference. Fills OutUnresolved's save id if it is a saveable which is not registered yet, so the caller
+	 * can record where it was read into.
+	 */
+	UObject* ReadReference(FMUnresolvedReference& OutUnresolved);
+
+	/** Records a reference to a saveable which is not registered yet */
+	void AddUnresolved(FMUnresolvedReference&& Reference, const void* Slot);
+};
@@ -0,0 +1,371 @@
+// Copyright © Bedrockbreaker 2025. MIT License
+
+#include "SaveSystem/MSaveTimeline.h"
+
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/Crc.h"
+#include "Misc/Paths.h"
+#include "SaveSystem/MSaveManager.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+namespace MSaveTimeline
+{
+	/** Identifies a timeline file */
+	constexpr uint32 FileMagic = 0x4E4C544D; // "MTLN"
+
+	/** Bumped whenever the file layout changes */
+	constexpr uint32 FileVersion = 1;
+
+	/** Size of the file header (magic + version) */
+	constexpr int64 FileHeaderSize = sizeof(uint32) * 2;
+
+	/** Starts every record */
+	constexpr uint32 RecordMagic = 0x4352544D; // "MTRC"
+
+	/** Size of a record header (magic + payload size + payload crc) */
+	constexpr int64 RecordHeaderSize = sizeof(uint32) * 3;
+
+	/** Returns the path a timeline is rewritten to before replacing the original */
+	static FString GetTempPath(const FString& FilePath)
+	{
+		return FilePath + TEXT(".tmp");
+	}
+
+	/** Returns the encoded file header */
+	static TArray<uint8> MakeHeader()
+	{
+		TArray<uint8> Header;
+		FMemoryWriter Writer(Header);
+		uint32		  Magic = FileMagic;
+		uint32		  Version = FileVersion;
+		Writer << Magic;
+		Writer << Version;
+		return Header;
+	}
+} // namespace MSaveTimeline
+
+FMSaveTimeline::FMSaveTimeline(const FString& InFilePath) : FilePath(InFilePath) {}
+
+FMSaveTimeline::~FMSaveTimeline()
+{
+	Close();
+}
+
+bool FMSaveTimeline::Append(const FGuid& NodeId, const TMap<FString, FIoHash>& ContentHashes)
+{
+	using namespace MSaveTimeline;
+
+	FScopeLock ScopeLock(&Lock);
+	if (!OpenLocked()) return false;
+	if (RecordedNodeIds.Contains(NodeId)) return true;
+
+	// 1. Only keep what changed since each saveable's previous entry
+
+	TArray<TPair<FString, FIoHash>> Changes;
+	for (const TTuple<FString, FIoHash>& ContentHash : ContentHashes)
+	{
+		const FSaveableTimeline* Timeline = Timelines.Find(ContentHash.Key);
+		if (!Timeline || Timeline->Entries.Last().ContentHash != ContentHash.Value) Changes.Emplace(ContentHash);
+	}
+
+	for (const TTuple<FString, FSaveableTimeline>& Timeline : Timelines)
+	{
+		if (!Timeline.Value.Entries.Last().IsRemoval() && !ContentHashes.Contains(Timeline.Key))
+			Changes.Emplace(Timeline.Key, FIoHash::Zero);
+	}
+
+	// 2. Append them as a single record. A node without changes is still recorded, so it is not backfilled again.
+
+	TArray<uint8> Record;
+	EncodeRecord(NodeId, Changes, Record);
+
+	if (!FileHandle->Seek(EndOffset) || !FileHandle->Write(Record.GetData(), Record.Num()))
+	{
+		UE_LOG(LogMSaveManager, Warning, TEXT("Failed to append to timeline %s"), *FilePath);
+		return false;
+	}
+
+	EndOffset += Record.Num();
+	ApplyLocked(NodeId, Changes);
+	return true;
+}
+
+bool FMSaveTimeline::Contains(const FGuid& NodeId)
+{
+	FScopeLock ScopeLock(&Lock);
+	return OpenLocked() && RecordedNodeIds.Contains(NodeId);
+}
+
+TArray<FMSaveTimelineEntry> FMSaveTimeline::GetEntries(const FString& SaveableId)
+{
+	FScopeLock ScopeLock(&Lock);
+	if (!OpenLocked()) return {};
+
+	const FSaveableTimeline* Timeline = Timelines.Find(SaveableId);
+	return Timeline ? Timeline->Entries : TArray<FMSaveTimelineEntry>();
+}
+
+int32 FMSaveTimeline::GetDistinctStateCount(const FString& SaveableId)
+{
+	FScopeLock ScopeLock(&Lock);
+	if (!OpenLocked()) return 0;
+
+	const FSaveableTimeline* Timeline = Timelines.Find(SaveableId);
+	return Timeline ? Timeline->DistinctHashes.Num() : 0;
+}
+
+bool FMSaveTimeline::Compact(const TSet<FGuid>& RemovedNodeIds)
+{
+	using namespace MSaveTimeline;
+
+	FScopeLock ScopeLock(&Lock);
+	if (!OpenLocked()) return false;
+
+	TArray<uint8> Bytes;
+	Bytes.SetNumUninitialized(static_cast<int32>(EndOffset));
+	if (!FileHandle->Seek(0) || !FileHandle->Read(Bytes.GetData(), EndOffset)) return false;
+
+	TArray<FRecord> Records;
+	ReadRecords(Bytes, Records);
+
+	// 1. Fold the changes of removed nodes into the next remaining record. Changes undone before then cancel out.
+
+	TArray<uint8>		   NewBytes = MakeHeader();
+	TMap<FString, FIoHash> PendingChanges;
+	TMap<FString, FIoHash> LastHashes;
+	for (const FRecord& Record : Records)
+	{
+		for (const TPair<FString, FIoHash>& Change : Record.Changes)
+		{
+			PendingChanges.Add(Change.Key, Change.Value);
+		}
+
+		if (RemovedNodeIds.Contains(Record.NodeId)) continue;
+
+		TArray<TPair<FString, FIoHash>> Changes;
+		for (const TTuple<FString, FIoHash>& Change : PendingChanges)
+		{
+			const FIoHash* LastHash = LastHashes.Find(Change.Key);
+			if (LastHash ? *LastHash == Change.Value : Change.Value.IsZero()) continue;
+
+			LastHashes.Add(Change.Key, Change.Value);
+			Changes.Emplace(Change.Key, Change.Value);
+		}
+
+		PendingChanges.Reset();
+		EncodeRecord(Record.NodeId, Changes, NewBytes);
+	}
+
+	// 2. Write it to a temporary file and swap it in. The timeline is reopened on next use.
+
+	FString		  TempPath = GetTempPath(FilePath);
+	IFileManager& FileManager = IFileManager::Get();
+
+	TUniquePtr<FArchive> TempWriter(FileManager.CreateFileWriter(*TempPath));
+	if (!TempWriter) return false;
+
+	TempWriter->Serialize(NewBytes.GetData(), NewBytes.Num());
+	if (!TempWriter->Close()) return false;
+	TempWriter.Reset();
+
+	FileHandle.Reset();
+	EndOffset = 0;
+	Timelines.Reset();
+	RecordedNodeIds.Reset();
+
+	if (!FileManager.Move(*FilePath, *TempPath, /* bReplace = */ true))
+	{
+		UE_LOG(LogMSaveManager, Warning, TEXT("Failed to compact timeline %s"), *FilePath);
+		FileManager.Delete(*TempPath);
+		return false;
+	}
+
+	return true;
+}
+
+void FMSaveTimeline::Close()
+{
+	FScopeLock ScopeLock(&Lock);
+	if (FileHandle) FileHandle->Flush();
+
+	FileHandle.Reset();
+	EndOffset = 0;
+	Timelines.Reset();
+	RecordedNodeIds.Reset();
+}
+
+bool FMSaveTimeline::OpenLocked()
+{
+	using namespace MSaveTimeline;
+
+	if (FileHandle) return true;
+
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	PlatformFile.CreateDirectoryTree(*FPaths::GetPath(FilePath));
+
+	FileHandle.Reset(PlatformFile.OpenWrite(*FilePath, /* bAppend = */ true, /* bAllowRead = */ true));
+	if (!FileHandle)
+	{
+		UE_LOG(LogMSaveManager, Warning, TEXT("Failed to open timeline %s"), *FilePath);
+		return false;
+	}
+
+	Timelines.Reset();
+	RecordedNodeIds.Reset();
+
+	// 1. Write the header for new timelines, or validate it for existing ones
+
+	int64 FileSize = FileHandle->Size();
+	if (FileSize < FileHeaderSize)
+	{
+		TArray<uint8> Header = MakeHeader();
+		if (!FileHandle->Seek(0) || !FileHandle->Write(Header.GetData(), Header.Num()))
+		{
+			FileHandle.Reset();
+			return false;
+		}
+
+		EndOffset = FileHeaderSize;
+		return true;
+	}
+
+	TArray<uint8> Bytes;
+	Bytes.SetNumUninitialized(static_cast<int32>(FileSize));
+	if (!FileHandle->Seek(0) || !FileHandle->Read(Bytes.GetData(), FileSize))
+	{
+		FileHandle.Reset();
+		return false;
+	}
+
+	FMemoryReader Reader(Bytes);
+	uint32		  Magic = 0;
+	uint32		  Version = 0;
+	Reader << Magic;
+	Reader << Version;
+
+	// The timeline can always be rebuilt, so one in an unknown format is simply started over
+	if (Magic != FileMagic || Version != FileVersion)
+	{
+		UE_LOG(LogMSaveManager, Warning, TEXT("Timeline %s has an unknown format, rebuilding it"), *FilePath);
+		FileHandle.Reset();
+		PlatformFile.DeleteFile(*FilePath);
+		return OpenLocked();
+	}
+
+	// 2. Read every valid record into the index
+
+	TArray<FRecord> Records;
+	EndOffset = ReadRecords(Bytes, Records);
+	for (const FRecord& Record : Records)
+	{
+		ApplyLocked(Record.NodeId, Record.Changes);
+	}
+
+	// A torn record (e.g. from a crash) is discarded, its node is backfilled on next use
+	if (EndOffset != FileSize)
+	{
+		UE_LOG(
+			LogMSaveManager,
+			Warning,
+			TEXT("Timeline %s has %lld trailing bytes, discarding them"),
+			*FilePath,
+			FileSize - EndOffset);
+		FileHandle->Truncate(EndOffset);
+	}
+
+	return true;
+}
+
+void FMSaveTimeline::ApplyLocked(const FGuid& NodeId, TConstArrayView<TPair<FString, FIoHash>> Changes)
+{
+	RecordedNodeIds.Add(NodeId);
+
+	for (const TPair<FString, FIoHash>& Change : Changes)
+	{
+		FSaveableTimeline& Timeline = Timelines.FindOrAdd(Change.Key);
+		Timeline.Entries.Add({ NodeId, Change.Value });
+		if (!Change.Value.IsZero()) Timeline.DistinctHashes.Add(Change.Value);
+	}
+}
+
+int64 FMSaveTimeline::ReadRecords(TConstArrayView<uint8> Bytes, TArray<FRecord>& OutRecords)
+{
+	using namespace MSaveTimeline;
+
+	OutRecords.Reset();
+
+	FMemoryReaderView Reader(Bytes);
+	int64			  EndOffset = FileHeaderSize;
+	while (EndOffset + RecordHeaderSize <= Bytes.Num())
+	{
+		Reader.Seek(EndOffset);
+
+		uint32 Magic = 0;
+		uint32 PayloadSize = 0;
+		uint32 PayloadCrc = 0;
+		Reader << Magic;
+		Reader << PayloadSize;
+		Reader << PayloadCrc;
+
+		int64 RecordEnd = EndOffset + RecordHeaderSize + PayloadSize;
+		if (Magic != RecordMagic || RecordEnd > Bytes.Num()) break;
+
+		const uint8* Payload = Bytes.GetData() + EndOffset + RecordHeaderSize;
+		if (FCrc::MemCrc32(Payload, PayloadSize) != PayloadCrc) break;
+
+		FMemoryReaderView PayloadReader(MakeArrayView(Payload, PayloadSize));
+		FRecord			  Record;
+		int32			  NumChanges = 0;
+		PayloadReader << Record.NodeId;
+		PayloadReader << NumChanges;
+
+		if (NumChanges < 0) break;
+		Record.Changes.SetNum(NumChanges);
+		for (TPair<FString, FIoHash>& Change : Record.Changes)
+		{
+			PayloadReader << Change.Key;
+			PayloadReader << Change.Value;
+		}
+
+		if (PayloadReader.IsError()) break;
+
+		OutRecords.Add(MoveTemp(Record));
+		EndOffset = RecordEnd;
+	}
+
+	return EndOffset;
+}
+
+void FMSaveTimeline::EncodeRecord(
+	const FGuid& NodeId, TConstArrayView<TPair<FString, FIoHash>> Changes, TArray<uint8>& OutBytes)
+{
+	using namespace MSaveTimeline;
+
+	TArray<uint8> Payload;
+	FMemoryWriter PayloadWriter(Payload);
+	FGuid		  RecordNodeId = NodeId;
+	int32		  NumChanges = Changes.Num();
+	PayloadWriter << RecordNodeId;
+	PayloadWriter << NumChanges;
+	for (const TPair<FString, FIoHash>& Change : Changes)
+	{
+		FString Key = Change.Key;
+		FIoHash Value = Change.Value;
+		PayloadWriter << Key;
+		PayloadWriter << Value;
+	}
+
+	// Appends to whatever OutBytes already holds
+	FMemoryWriter Writer(OutBytes);
+	Writer.Seek(OutBytes.Num());
+
+	uint32 Magic = RecordMagic;
+	uint32 PayloadSize = Payload.Num();
+	uint32 PayloadCrc = FCrc::MemCrc32(Payload.GetData(), Payload.Num());
+	Writer << Magic;
+	Writer << PayloadSize;
+	Writer << PayloadCrc;
+	Writer.Serialize(Payload.GetData(), Payload.Num());
+}
@@ -0,0 +1,104 @@
+// Copyright © Bedrockbreaker 2025. MIT License
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include "IO/IoHash.h"
+
+class IFileHandle;
+
+/** A change to a single saveable's state, within a save slot's timeline */
+struct FMSaveTimelineEntry
+{
+	/** The save node the change was captured in */
+	FGuid NodeId;
+
+	/** The content hash of the saveable's new state (see FMSaveData::GetContentHash). Zero if it was removed. */
+	FIoHash ContentHash = FIoHash::Zero;
+
+	/** Whether the saveable was no longer captured as of this node */
+	bool IsRemoval() const { return ContentHash.IsZero(); }
+};
+
+/**
+ * Per-slot index of how every saveable's state changed across the save graph, in the order nodes were committed.
+ *
+ * Each committed node appends one record, holding only the saveables whose content hash changed since their previous
+ * entry (or which were no longer captured), so history queries never have to decode nodes to find a saveable's
+ * states. The timeline is derived data: records are not flushed individually, and nodes missing from it (e.g. after a
+ * crash, or in slots from before it existed) are backfilled from the nodes themselves. Thread-safe.
+ */
+class FMSaveTimeline
+{
+public:
+	explicit FMSaveTimeline(const FString& InFilePath);
+	~FMSaveTimeline();
+
+	/** Records the content hash of every saveable captured in a node. Nodes already in the timeline are skipped. */
+	bool Append(const FGuid& NodeId, const TMap<FString, FIoHash>& ContentHashes);
+
+	/** Whether a node has been recorded */
+	bool Contains(const FGuid& NodeId);
+
+	/** Returns every change to a saveable's state, oldest first */
+	TArray<FMSaveTimelineEntry> GetEntries(const FString& SaveableId);
+
+	/** Returns the number of distinct states a saveable has had, not counting removals */
+	int32 GetDistinctStateCount(const FString& SaveableId);
+
+	/**
+	 * Rewrites the timeline without the records of removed nodes. Their changes are folded into the next remaining
+	 * record, so every remaining node keeps the states it was recorded with.
+	 */
+	bool Compact(const TSet<FGuid>& RemovedNodeIds);
+
+	/** Closes the underlying file, so it can be moved or deleted. The timeline reopens it on next use. */
+	void Close();
+
+private:
+	/** A record read back from the timeline file */
+	struct FRecord
+	{
+		FGuid							NodeId;
+		TArray<TPair<FString, FIoHash>> Changes;
+	};
+
+	/** The recorded changes of a single saveable */
+	struct FSaveableTimeline
+	{
+		TArray<FMSaveTimelineEntry> Entries;
+		TSet<FIoHash>				DistinctHashes;
+	};
+
+	/** The path of the timeline file */
+	FString FilePath;
+
+	/** Read/write handle to the timeline file, opened lazily */
+	TUniquePtr<IFileHandle> FileHandle;
+
+	/** The offset one past the last valid record */
+	int64 EndOffset = 0;
+
+	/** Maps saveable ids to their recorded changes */
+	TMap<FString, FSaveableTimeline> Timelines;
+
+	/** Every node which has been recorded */
+	TSet<FGuid> RecordedNodeIds;
+
+	/** Guards all file access and the index */
+	FCriticalSection Lock;
+
+	/** Opens the timeline file and reads its records into the index, if not already open */
+	bool OpenLocked();
+
+	/** Adds a record's changes to the index */
+	void ApplyLocked(const FGuid& NodeId, TConstArrayView<TPair<FString, FIoHash>> Changes);
+
+	/** Reads every valid record following the file header. Returns the offset one past the last valid record. */
+	static int64 ReadRecords(TConstArrayView<uint8> Bytes, TArray<FRecord>& OutRecords);
+
+	/** Encodes a record, including its header, and appends it to OutBytes */
+	static void EncodeRecord(
+		const FGuid& NodeId, TConstArrayView<TPair<FString, FIoHash>> Changes, TArray<uint8>& OutBytes);
+};
@@ -15,13 +15,20 @@ class UMSaveable : public UInterface
 	GENERATED_BODY()
 };
 
-/** Interface for saveable actors */
+/**
+ * Interface for saveable actors.
+ * Saveables must register themselves with UMSaveManager::RegisterSaveable in BeginPlay,
+ * and unregister themselves with UMSaveManager::UnregisterSaveable in EndPlay.
+ */
 class MEMENTOSAVESYSTEMRUNTIME_API IMSaveable
 {
 	GENERATED_BODY()
 
 public:
-	/** The stable save id for this actor */
+	/**
+	 * The stable save id for this actor.
+	 * If this changes while registered, UMSaveManager::RefreshSaveableId must be called.
+	 */
 	UFUNCTION(BlueprintCallable, BlueprintNativeEvent, Category = "MSave System")
 	FString GetSaveId() const;
 
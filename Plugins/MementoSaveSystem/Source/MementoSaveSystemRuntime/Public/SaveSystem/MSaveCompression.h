@@ -0,0 +1,24 @@
+// Copyright © Bedrockbreaker 2025. MIT License
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "MSaveCompression.generated.h"
+
+/** Codecs save data payloads can be compressed with */
+UENUM(BlueprintType)
+enum class EMSaveCompression : uint8
+{
+	/** Stored as is. Only uncompressed payloads can be read in place from the memory-mapped blob store. */
+	None = 0,
+
+	/** Fastest to compress and decompress, suited to frequent autosaves */
+	LZ4 = 1,
+
+	/** Slower, but primed with the slot's trained dictionary, which suits long histories of similar nodes */
+	Zlib = 2,
+
+	/** Best ratio for its speed, suited to archival nodes */
+	Oodle = 3,
+};
@@ -2,8 +2,55 @@
 
 #pragma once
 
+#include "IO/IoHash.h"
+#include "Memory/MemoryView.h"
+
 #include "MSaveData.generated.h"
 
+struct FMSaveMappedRegion;
+
+/** A reference to a chunk of save data, stored once within its slot's content-addressed blob store */
+USTRUCT()
+struct MEMENTOSAVESYSTEMRUNTIME_API FMSaveChunkRef
+{
+	GENERATED_BODY()
+
+public:
+	/** The content hash of the chunk */
+	FIoHash Hash;
+
+	/** The size of the chunk in bytes */
+	uint32 Size = 0;
+
+	/** Custom serializer, since FIoHash is not a reflected type */
+	bool Serialize(FArchive& Ar)
+	{
+		Ar << Hash;
+		Ar << Size;
+		return true;
+	}
+
+	/** Equality operator */
+	bool operator==(const FMSaveChunkRef& Other) const { return Hash == Other.Hash && Size == Other.Size; }
+
+	/** Archive operator, for serializing chunk references outside of the property system */
+	friend FArchive& operator<<(FArchive& Ar, FMSaveChunkRef& Chunk)
+	{
+		Chunk.Serialize(Ar);
+		return Ar;
+	}
+};
+
+template <>
+struct TStructOpsTypeTraits<FMSaveChunkRef> : public TStructOpsTypeTraitsBase2<FMSaveChunkRef>
+{
+	enum
+	{
+		WithSerializer = true,
+		WithIdenticalViaEquality = true,
+	};
+};
+
 /** Simple container for binary save data */
 USTRUCT(BlueprintType)
 struct MEMENTOSAVESYSTEMRUNTIME_API FMSaveData
@@ -29,7 +76,65 @@ public:
 	UPROPERTY(BlueprintReadWrite)
 	FTransform Transform;
 
-	/** Raw binary blob */
-	UPROPERTY(BlueprintReadWrite)
+	/**
+	 * The streaming level or World Partition cell the saveable belongs to (none for the persistent level).
+	 * Save data of a partition which is not streamed in is only applied once it streams in.
+	 */
+	UPROPERTY(BlueprintReadOnly)
+	FName Partition;
+
+	/**
+	 * Raw binary blob.
+	 * Not serialized with the save node itself, the blob store holds it as Chunks instead. Save nodes from before the
+	 * blob store still hold it themselves, see FMSaveStorage::DecodeLegacyNode.
+	 * Empty if the payload is mapped from the blob store instead, see MappedChunks.
+	 */
+	UPROPERTY(BlueprintReadWrite, Transient)
 	TArray<uint8> Data;
+
+	/** References to the content-defined chunks which make up Data, within the slot's blob store */
+	UPROPERTY()
+	TArray<FMSaveChunkRef> Chunks;
+
+	/** Views of every chunk in place within the memory-mapped blob store, if the payload was mapped rather than read */
+	TArray<FMemoryView> MappedChunks;
+
+	/** Keeps the mapping MappedChunks point into alive */
+	TSharedPtr<const FMSaveMappedRegion> MappedRegion;
+
+	/**
+	 * Whether the actor was spawned at runtime, rather than placed in a level.
+	 * Spawned actors missing when loading are spawned again from ClassName and ActorFName.
+	 */
+	bool bSpawned = false;
+
+	/**
+	 * Whether only the key of this entry was loaded, because its saveable was not present at the time.
+	 * Everything else, including the payload, is left on disk. See FMSaveStorage::LoadNode.
+	 */
+	bool bOmitted = false;
+
+	/** Whether the payload is mapped from the blob store, rather than held in Data */
+	bool IsPayloadMapped() const { return !MappedChunks.IsEmpty(); }
+
+	/** The size of the payload in bytes, whether it is mapped or not */
+	int64 GetPayloadSize() const;
+
+	/**
+	 * Returns the payload as contiguous segments, without copying it.
+	 * OutDataView holds the only segment of a payload which is not mapped, so it must outlive the result.
+	 */
+	TConstArrayView<FMemoryView> GetPayloadSegments(FMemoryView& OutDataView) const;
+
+	/** Copies a mapped payload into Data, for callers which need to own it */
+	void LoadMappedPayload();
+
+	/** Whether this save data is byte-for-byte identical to another. Omitted entries are never identical. */
+	bool IsIdentical(const FMSaveData& Other) const;
+
+	/**
+	 * Hashes everything IsIdentical compares, so identical save data always has the same hash.
+	 * Omitted entries have no content to hash, and return zero.
+	 */
+	FIoHash GetContentHash() const;
 };
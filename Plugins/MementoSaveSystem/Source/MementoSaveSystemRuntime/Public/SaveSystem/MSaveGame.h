@@ -3,6 +3,8 @@
 #pragma once
 
 #include "GameFramework/SaveGame.h"
+#include "SaveSystem/MSaveCompression.h"
+#include "SaveSystem/MSaveGraphIndex.h"
 #include "SaveSystem/MSaveNodeMetadata.h"
 
 #include "MSaveGame.generated.h"
@@ -22,11 +24,81 @@ public:
 	UPROPERTY(BlueprintReadOnly)
 	int32 UserIndex = 0;
 
-	/** A DAG of metadata for each save node, to avoid unncessary deserialization during graph traversal */
+	/**
+	 * A DAG of metadata for each save node, to avoid unncessary deserialization during graph traversal.
+	 * Add and remove nodes through AddSaveNode and RemoveSaveNode, so the child adjacency stays up to date.
+	 */
 	UPROPERTY()
 	TMap<FGuid, FMSaveNodeMetadata> SaveNodes;
 
 	/** The id of the most recent save node added to the save graph */
 	UPROPERTY(BlueprintReadOnly)
 	FGuid MostRecentNodeId;
+
+	/** The codec new save data is compressed with. Data already in the slot keeps the codec it was stored with. */
+	UPROPERTY(BlueprintReadOnly)
+	EMSaveCompression Compression = EMSaveCompression::None;
+
+	/** The sequence of the last journal record included in this checkpoint. Newer records are replayed on load. */
+	UPROPERTY()
+	int64 JournalSequence = 0;
+
+	/** Adds a node to the save graph, linking it to its parents' children in O(1) */
+	FMSaveNodeMetadata& AddSaveNode(const FMSaveNodeMetadata& Metadata);
+
+	/** Removes a node from the save graph. The child adjacency is rebuilt on next use. */
+	bool RemoveSaveNode(const FGuid& SaveId, FMSaveNodeMetadata* OutMetadata = nullptr);
+
+	/**
+	 * Returns the children of a node along a lineage, in the order they were added.
+	 * Pass an invalid id to get the roots, i.e. the nodes without a parent along the lineage.
+	 */
+	void GetChildren(const FGuid& SaveId, EMSaveLineage Lineage, TArray<FGuid>& OutChildren) const;
+
+	/** Returns the number of children of a node along a lineage */
+	int32 GetNumChildren(const FGuid& SaveId, EMSaveLineage Lineage) const;
+
+	/** Rebuilds the child adjacency from SaveNodes. Called once after loading the slot. */
+	void RebuildAdjacency() const;
+
+private:
+	/**
+	 * Child adjacency of the save graph, as intrusive lists over dense node indices.
+	 * Not saved, it is rebuilt once from SaveNodes after loading (or whenever SaveNodes was modified directly).
+	 */
+	struct FAdjacency
+	{
+		/** Maps node ids to their dense index. Index 0 is a virtual root, parenting every node without a parent. */
+		TMap<FGuid, int32> NodeIndices;
+
+		/** The id of every indexed node */
+		TArray<FGuid> NodeIds;
+
+		/** Per lineage and node, the first and last child, the next sibling, and the number of children */
+		TArray<int32> FirstChild[2];
+		TArray<int32> LastChild[2];
+		TArray<int32> NextSibling[2];
+		TArray<int32> NumChildren[2];
+
+		/** Whether the adjacency is out of date, e.g. because nodes were removed since it was built */
+		bool bDirty = true;
+	};
+
+	/** Mutable, since it is rebuilt lazily by const queries */
+	mutable FAdjacency Adjacency;
+
+	/** Rebuilds the child adjacency if it is out of date with SaveNodes */
+	void UpdateAdjacency() const;
+
+	/** Indexes a node, and appends it to its parents' children (or to the virtual root's, if it has no parent) */
+	void LinkSaveNode(const FMSaveNodeMetadata& Metadata) const;
+
+	/** Indexes a node without any children */
+	int32 AddNodeIndex(const FGuid& SaveId) const;
+
+	/** Appends a node to the end of its parent's children along a lineage */
+	void AppendChild(int32 Lineage, int32 ParentIndex, int32 ChildIndex) const;
+
+	/** Returns the dense index of a node, 0 (the virtual root) for an invalid id, or INDEX_NONE if not indexed */
+	int32 FindNodeIndex(const FGuid& SaveId) const;
 };
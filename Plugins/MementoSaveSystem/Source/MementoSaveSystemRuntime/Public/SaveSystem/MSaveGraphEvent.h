@@ -0,0 +1,52 @@
+// Copyright © Bedrockbreaker 2025. MIT License
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SaveSystem/MSaveNodeMetadata.h"
+
+class UMSaveGame;
+
+/** The kinds of change to the active save graph */
+enum class EMSaveGraphEventType : uint8
+{
+	/** Another save slot became active (or none did). Listeners should rebuild whatever they derived from the graph. */
+	SlotSwitched = 0,
+
+	/** A save node was committed to the active save graph */
+	NodeAdded = 1,
+
+	/** The most recent save node of the active save graph changed */
+	ActiveNodeChanged = 2,
+
+	/**
+	 * Save nodes were removed from the active save graph. Remaining nodes may have been reparented past them, so
+	 * anything derived from their parents should be rebuilt.
+	 */
+	NodesRemoved = 3,
+};
+
+/** A single change to the active save graph, as broadcast by UMSaveManager::OnSaveGraphChanged */
+struct FMSaveGraphEvent
+{
+	EMSaveGraphEventType Type = EMSaveGraphEventType::SlotSwitched;
+
+	/**
+	 * Increases by one with every event the save manager broadcasts. A listener which saw every revision up to this one
+	 * can apply the event on top of its state, otherwise (or on SlotSwitched) it should rebuild it from SaveGame.
+	 */
+	int64 Revision = 0;
+
+	/** The active save slot after the change (null if none) */
+	UMSaveGame* SaveGame = nullptr;
+
+	/** The added node's metadata, for NodeAdded */
+	FMSaveNodeMetadata Metadata;
+
+	/** The previous and new most recent node, for ActiveNodeChanged */
+	FGuid OldNodeId;
+	FGuid NewNodeId;
+
+	/** The ids of the removed nodes, for NodesRemoved */
+	TArray<FGuid> RemovedNodeIds;
+};
@@ -0,0 +1,90 @@
+// Copyright © Bedrockbreaker 2025. MIT License
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SaveSystem/MSaveNodeMetadata.h"
+
+#include "MSaveGraphIndex.generated.h"
+
+/** The parent relations of the save graph */
+UENUM(BlueprintType)
+enum class EMSaveLineage : uint8
+{
+	/** Follows BranchParentId, the chronological parent */
+	Branch = 0,
+
+	/** Follows SequenceParentId, the logical parent */
+	Sequence = 1,
+};
+
+/**
+ * Skip-pointer index over both parent relations of a save graph, answering ancestor queries in O(log N) hops.
+ *
+ * Every node stores its parent, its depth, and a single jump pointer laid out like skew-binary numbers (Myers' jump
+ * pointers), so the index takes constant space per node and a node is indexed in constant time once its parents are.
+ * Nodes are indexed lazily, along with any ancestors not indexed yet, so the index can be built incrementally as nodes
+ * are appended to the graph. Nodes removed from the graph are never unindexed, reset the index instead.
+ */
+class MEMENTOSAVESYSTEMRUNTIME_API FMSaveGraphIndex
+{
+public:
+	/** Drops every indexed node */
+	void Reset();
+
+	/** Indexes a node, and any of its ancestors not indexed yet. Returns false if the node is not in the graph. */
+	bool AddNode(const FGuid& SaveNodeId, const TMap<FGuid, FMSaveNodeMetadata>& SaveNodes);
+
+	/** Returns the ancestor N hops up a lineage (the node itself for 0), or an invalid id if the lineage is shorter */
+	FGuid GetNthAncestor(
+		const FGuid& SaveNodeId, int32 N, EMSaveLineage Lineage, const TMap<FGuid, FMSaveNodeMetadata>& SaveNodes);
+
+	/** Whether a node is a proper ancestor of another along a lineage */
+	bool IsAncestor(
+		const FGuid&							AncestorId,
+		const FGuid&							SaveNodeId,
+		EMSaveLineage							Lineage,
+		const TMap<FGuid, FMSaveNodeMetadata>& SaveNodes);
+
+	/** Returns the deepest node which both nodes descend from (or are) along a lineage, invalid if there is none */
+	FGuid FindCommonAncestor(
+		const FGuid&							A,
+		const FGuid&							B,
+		EMSaveLineage							Lineage,
+		const TMap<FGuid, FMSaveNodeMetadata>& SaveNodes);
+
+	/** Returns the number of hops from a node to the root of its lineage, or -1 if it is not in the graph */
+	int32 GetDepth(const FGuid& SaveNodeId, EMSaveLineage Lineage, const TMap<FGuid, FMSaveNodeMetadata>& SaveNodes);
+
+private:
+	/** The skip pointers of every node along a single lineage, indexed like NodeIds */
+	struct FLineage
+	{
+		/** The parent of each node, INDEX_NONE for roots */
+		TArray<int32> Parents;
+
+		/** The jump pointer of each node, always an ancestor (or the node itself, for roots) */
+		TArray<int32> Jumps;
+
+		/** The number of hops from each node to its root */
+		TArray<int32> Depths;
+	};
+
+	/** Maps node ids to their dense index */
+	TMap<FGuid, int32> NodeIndices;
+
+	/** The id of every indexed node */
+	TArray<FGuid> NodeIds;
+
+	/** The skip pointers of each lineage */
+	FLineage Lineages[2];
+
+	/** Returns the dense index of a node, indexing it first if needed (INDEX_NONE if it is not in the graph) */
+	int32 FindOrAddNode(const FGuid& SaveNodeId, const TMap<FGuid, FMSaveNodeMetadata>& SaveNodes);
+
+	/** Appends a node whose parents are already indexed, or not in the graph */
+	void AppendNode(const FMSaveNodeMetadata& Metadata);
+
+	/** Returns the ancestor of a node at a given depth, which must not be deeper than the node itself */
+	static int32 GetAncestorAtDepth(const FLineage& Lineage, int32 Index, int32 Depth);
+};
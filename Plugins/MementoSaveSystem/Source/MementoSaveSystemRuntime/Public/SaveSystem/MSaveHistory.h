@@ -2,15 +2,33 @@
 
 #pragma once
 
+#include "Containers/List.h"
 #include "SaveSystem/MSaveData.h"
+#include "SaveSystem/MSaveGraphIndex.h"
 
 #include "MSaveHistory.generated.h"
 
+class FMSaveStorage;
 class UMSaveGame;
 class UMSaveNode;
 // struct FMSaveData;
 
-/** Query-handling object for inspecting historical save data across a UMSaveGame */
+/** Delegate called as the save history warms its cache in the background. Passes in the loaded and total nodes. */
+DECLARE_MULTICAST_DELEGATE_TwoParams(FMOnHistoryProgressDelegate, int32, int32);
+
+/**
+ * Query-handling object for inspecting historical save data across a UMSaveGame.
+ *
+ * Save nodes are loaded on demand and kept in a cache bounded by a memory budget (see UMSaveSettings), evicting the
+ * least recently used nodes first. The most recent node and its nearest sequence ancestors are pinned, since that is
+ * what saveables query most, and are never evicted.
+ *
+ * AsyncInitialize warms the pinned nodes on worker threads. Queries never wait for warming, they answer from whatever
+ * is already cached and load anything else on the spot.
+ *
+ * Nodes missing from the slot's timeline (e.g. from before it existed, or after a crash) are backfilled one at a time
+ * on worker threads. Until that finishes, timeline queries answer without the states of the nodes still missing.
+ */
 UCLASS(BlueprintType)
 class MEMENTOSAVESYSTEMRUNTIME_API UMSaveHistory : public UObject
 {
@@ -24,6 +42,27 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Save System|History")
 	virtual void Initialize(UMSaveGame* InSaveGame);
 
+	/**
+	 * Initializes the history like Initialize, then warms the cache with the nodes queries are most likely to need on
+	 * worker threads. The history can be queried straight away. Progress is reported through OnProgress.
+	 */
+	virtual void AsyncInitialize(UMSaveGame* InSaveGame);
+
+	/** Whether the cache has finished warming (always true after Initialize) */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Save System|History")
+	bool IsWarmed() const { return NumWarmed >= NumToWarm; }
+
+	/** How far the cache has warmed, between 0 and 1 */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Save System|History")
+	float GetWarmingProgress() const { return NumToWarm > 0 ? static_cast<float>(NumWarmed) / NumToWarm : 1.0f; }
+
+	/** Called on the game thread whenever a node finishes warming, including the last one */
+	FMOnHistoryProgressDelegate OnProgress;
+
+	/** Whether every node of the save game has been recorded in the slot's timeline, see GetAllSaveStates */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Save System|History")
+	bool IsTimelineBackfilled() const { return bTimelineBackfilled; }
+
 	/** Returns the previous save node's data for this saveable. (i.e. from the current save node's sequence parent). */
 	UFUNCTION(BlueprintCallable, Category = "Save System|History")
 	virtual bool GetLastSaveState(const FString& SaveableId, FMSaveData& OutSaveData) const;
@@ -33,30 +72,125 @@ public:
 	virtual bool GetNthLastSaveState(const FString& SaveableId, int32 N, FMSaveData& OutSaveData) const;
 
 	// TODO: Promote FMSaveData to a UObject to allow it be stored in a TArray without ownership
-	/** Returns all save states for this saveable across all save nodes. */
+	/**
+	 * Returns all save states for this saveable across all save nodes, oldest first.
+	 * Only states which differ from the one before are returned, found through the slot's timeline. States of nodes the
+	 * timeline is still being backfilled with are missing until IsTimelineBackfilled.
+	 */
 	UFUNCTION(BlueprintCallable, Category = "Save System|History")
 	virtual bool GetAllSaveStates(const FString& SaveableId, TArray<FMSaveData>& OutSaveData) const;
 
-	/** Returns the number of distinct states for this saveable across all save nodes. */
+	/**
+	 * Returns the number of distinct states for this saveable across all save nodes.
+	 * Answered from the slot's timeline without loading any node, so it is cheap enough to call every frame. States of
+	 * nodes the timeline is still being backfilled with are not counted until IsTimelineBackfilled.
+	 */
 	UFUNCTION(BlueprintCallable, Category = "Save System|History")
 	virtual int32 GetDistinctStateCount(const FString& SaveableId) const;
 
+	/** Returns the ancestor N hops up a lineage from this save node (itself for 0), or an invalid id if none. */
+	UFUNCTION(BlueprintCallable, Category = "Save System|History")
+	virtual FGuid GetNthAncestor(const FGuid& SaveNodeId, int32 N, EMSaveLineage Lineage) const;
+
+	/** Returns whether a save node is a proper ancestor of another along a lineage. */
+	UFUNCTION(BlueprintCallable, Category = "Save System|History")
+	virtual bool IsAncestor(const FGuid& AncestorId, const FGuid& SaveNodeId, EMSaveLineage Lineage) const;
+
+	/**
+	 * Returns the deepest save node both save nodes descend from (or are) along a lineage, i.e. where they diverged.
+	 * Returns an invalid id if they share no ancestor.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Save System|History")
+	virtual FGuid FindCommonAncestor(const FGuid& A, const FGuid& B, EMSaveLineage Lineage) const;
+
 	/** Returns the number of branch children for this save node. */
 	UFUNCTION(BlueprintCallable, Category = "Save System|History")
 	virtual int32 GetBranchChildrenCount(const FGuid& SaveNodeId) const;
 
+	/** Adds a newly created save node to the cache, so it can be queried without reloading it. */
+	virtual void CacheSaveNode(UMSaveNode* SaveNode);
+
+	/** Returns the approximate memory held by cached save nodes, in bytes. */
+	int64 GetCacheSize() const { return CacheSize; }
+
+	/** Keeps cached save nodes alive, since the cache is not visible to the property system. */
+	static void AddReferencedObjects(UObject* InThis, FReferenceCollector& Collector);
+
 protected:
+	/** A save node held by the cache */
+	struct FCachedNode
+	{
+		TObjectPtr<UMSaveNode>							 SaveNode;
+		int64											 Size = 0;
+		TDoubleLinkedList<FGuid>::TDoubleLinkedListNode* LruNode = nullptr;
+	};
+
 	/** The save game to query against. */
 	UPROPERTY()
 	TObjectPtr<UMSaveGame> SaveGame;
 
-	// TODO: A production-ready system would not store every save node in memory.
-	/** Cache of save nodes in memory. */
-	UPROPERTY()
-	TMap<FGuid, TObjectPtr<UMSaveNode>> SaveNodes;
+	/** Cache of save nodes in memory. Mutable, since queries load missing nodes on demand. */
+	mutable TMap<FGuid, FCachedNode> SaveNodes;
+
+	/** Cached save node ids, from most to least recently used. */
+	mutable TDoubleLinkedList<FGuid> LruList;
+
+	/** The approximate memory held by cached save nodes, in bytes. */
+	mutable int64 CacheSize = 0;
+
+	/** Save nodes which are never evicted: the most recent node and its nearest sequence ancestors. */
+	mutable TSet<FGuid> PinnedNodeIds;
+
+	/** The most recent node PinnedNodeIds was gathered for. */
+	mutable FGuid PinnedForNodeId;
+
+	/** Disk storage for the save game's save nodes. */
+	TSharedPtr<FMSaveStorage> Storage;
+
+	/** Skip pointers over the save graph. Mutable, since queries index nodes appended since the last query. */
+	mutable FMSaveGraphIndex GraphIndex;
+
+	/** The number of nodes being warmed. */
+	int32 NumToWarm = 0;
+
+	/** The number of nodes which finished warming, whether they loaded or not. */
+	int32 NumWarmed = 0;
+
+	/** Bumped whenever the history is reinitialized, so warming loads for a previous save game are discarded. */
+	uint32 Generation = 0;
+
+	/** Whether nodes missing from the slot's timeline have been gathered to be backfilled. */
+	mutable bool bBackfillStarted = false;
+
+	/** Whether every node of the save game has been recorded in the slot's timeline. */
+	mutable bool bTimelineBackfilled = false;
+
+	/** Nodes still to be backfilled into the slot's timeline, newest first. */
+	mutable TArray<FGuid> NodesToBackfill;
+
+	/** Returns a save node from the cache, loading it on a miss. Returns null if the node could not be loaded. */
+	virtual UMSaveNode* GetSaveNode(const FGuid& SaveNodeId) const;
+
+	/** Adds a save node to the cache as the most recently used one, then evicts nodes past the memory budget. */
+	void AddToCache(UMSaveNode* SaveNode) const;
+
+	/** Evicts the least recently used save nodes which are not pinned, until the cache fits its memory budget. */
+	void EvictNodes() const;
+
+	/** Empties the cache. */
+	void ResetCache();
+
+	/** Pins the most recent node and its nearest sequence ancestors, if the most recent node changed. */
+	void UpdatePinnedNodes() const;
+
+	/**
+	 * Starts recording nodes missing from the slot's timeline (e.g. from before it existed) by resolving them, oldest
+	 * first. Checked once per save game. Nodes are resolved on worker threads, one at a time, so the game never waits.
+	 */
+	void BackfillTimeline() const;
 
-	/** Helper function to load all save nodes and cache them in memory. */
-	virtual void LoadAllNodes();
+	/** Resolves the next node to backfill on a worker thread and records it, or finishes the backfill. */
+	void BackfillNextNode() const;
 
 private:
 	FMSaveData DebugSaveData;
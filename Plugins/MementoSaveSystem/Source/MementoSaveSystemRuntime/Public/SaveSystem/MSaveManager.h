@@ -3,17 +3,26 @@
 #pragma once
 
 #include "ConsoleSettings.h"
+#include "Containers/Ticker.h"
+#include "SaveSystem/MSaveCompression.h"
+#include "SaveSystem/MSaveData.h"
+#include "SaveSystem/MSaveGraphEvent.h"
 #include "Subsystems/GameInstanceSubsystem.h"
+#include "Tasks/Task.h"
+#include "UObject/StrongObjectPtr.h"
 
 #include "MSaveManager.generated.h"
 
+class FMSaveStorage;
 class IMSaveable;
 class UMSaveGame;
 class UMSaveHistory;
 class UMSaveIndex;
 class UMSaveNode;
 struct FKeyEvent;
+struct FMSaveJournalOp;
 struct FMSlotId;
+struct FMSlotSummary;
 
 DECLARE_LOG_CATEGORY_EXTERN(LogMSaveManager, Log, All);
 
@@ -22,6 +31,12 @@ DECLARE_LOG_CATEGORY_EXTERN(LogMSaveManager, Log, All);
 /** Delegate called when a save slot is updated (new node, slot changed, etc.). Passes in the UMSaveGame. */
 DECLARE_MULTICAST_DELEGATE_OneParam(FMOnSaveSlotUpdatedDelegate, UMSaveGame*);
 
+/** Delegate called for every change to the active save graph. Passes in the change. */
+DECLARE_MULTICAST_DELEGATE_OneParam(FMOnSaveGraphChangedDelegate, const FMSaveGraphEvent&);
+
+/** Delegate called as a loaded save node is restored onto the world. Passes in the id of the save node. */
+DECLARE_MULTICAST_DELEGATE_OneParam(FMOnRestoreDelegate, const FGuid&);
+
 /** Delegate called when the save index is updated. Passes in the global UMSaveIndex. */
 DECLARE_MULTICAST_DELEGATE_OneParam(FMOnSaveIndexUpdatedDelegate, UMSaveIndex*);
 
@@ -126,6 +141,112 @@ DECLARE_DYNAMIC_DELEGATE_ThreeParams(
 
 #pragma region UMSavemanager
 
+/** A saveable registered with the UMSaveManager, along with the save id it was registered under */
+struct FMRegisteredSaveable
+{
+	/** The saveable object (an actor or component implementing IMSaveable) */
+	TWeakObjectPtr<UObject> Object;
+
+	/** The cached result of IMSaveable::GetSaveId */
+	FString SaveId;
+
+	/** The content hash of the state the saveable was last saved or loaded with (zero if unknown) */
+	FIoHash ContentHash = FIoHash::Zero;
+};
+
+/** A loaded save node whose save data is still being applied to the saveables, possibly across several frames */
+struct FMPendingRestore
+{
+	/** The id of the loaded save node */
+	FGuid SaveId;
+
+	/** The effective save data of the loaded save node */
+	TSharedPtr<const TMap<FString, FMSaveData>> SaveData;
+
+	/** The content hash of every entry of SaveData, empty if unchanged saveables are not skipped */
+	TMap<FString, FIoHash> ContentHashes;
+
+	/** The keys of entries already applied while spawning their actors */
+	TSet<FString> SpawnedIds;
+
+	/** The partitions which were streamed in when the node was loaded. Entries of any other partition are deferred. */
+	TSet<FName> ResidentPartitions;
+
+	/** The entries of SaveData, in the order they are applied */
+	TArray<const TTuple<FString, FMSaveData>*> Order;
+
+	/** The number of entries at the start of Order gameplay depends on (the player, and saveables around it) */
+	int32 NumCritical = 0;
+
+	/** The index into Order of the next entry to apply */
+	int32 NextIndex = 0;
+
+	/** The number of entries applied, and skipped because their saveable was unchanged */
+	int32 NumApplied = 0;
+	int32 NumSkipped = 0;
+
+	/** Whether the node is loaded as part of a recall */
+	bool bRecall = false;
+
+	/** Whether OnRestoreGameplayReady was broadcast */
+	bool bGameplayReady = false;
+
+	/** Whether every entry was applied */
+	bool IsDone() const { return NextIndex >= Order.Num(); }
+
+	/** Whether save data belongs to a partition which was streamed in */
+	bool IsResident(const FMSaveData& Entry) const
+	{
+		return Entry.Partition.IsNone() || ResidentPartitions.Contains(Entry.Partition);
+	}
+};
+
+/**
+ * A reference to a saveable which was not registered yet when a payload was read, e.g. one spawned or streamed in
+ * later during the same load. Patched once the saveable registers, see UMSaveManager::ResolveUnresolvedReferences.
+ */
+struct FMUnresolvedReference
+{
+	/** The saveable whose payload held the reference */
+	TWeakObjectPtr<UObject> Owner;
+
+	/** The save id of the referenced saveable */
+	FString SaveId;
+
+	/** The property the reference was read into. Exactly one of them is set. */
+	UObject**		ObjectSlot = nullptr;
+	FObjectPtr*		ObjectPtrSlot = nullptr;
+	FWeakObjectPtr* WeakSlot = nullptr;
+
+	/** Whether the property lies within the owner itself, rather than in a container the owner may reallocate */
+	bool bInline = false;
+
+	/** The frame the reference was read in */
+	uint64 Frame = 0;
+
+	/**
+	 * Whether the property can still be patched. Properties within containers are only trusted during the frame they
+	 * were read in, since the owner may reallocate the container once it runs again.
+	 */
+	bool IsPatchable() const;
+
+	/** Points the property at the saveable, unless the owner already set it to something else */
+	void Patch(UObject* Saveable) const;
+};
+
+/** A save node whose effective save data is resolved on a worker thread ahead of loading it */
+struct FMPrefetchedNode
+{
+	/** The node itself, which loading it returns */
+	TStrongObjectPtr<UMSaveNode> SaveNode;
+
+	/** Completes with the effective save data of the node (null on failure) */
+	UE::Tasks::TTask<TSharedPtr<const TMap<FString, FMSaveData>>> Task;
+
+	/** Whether the node was prefetched because it neighbours the most recent node, rather than on request */
+	bool bWarm = false;
+};
+
 /** A game instance subsystem that handles non-linear save and load operations */
 UCLASS()
 class MEMENTOSAVESYSTEMRUNTIME_API UMSaveManager : public UGameInstanceSubsystem
@@ -136,6 +257,21 @@ public:
 	/** Called when a save slot is updated (node creation/deletion, save slot change, etc.) */
 	FMOnSaveSlotUpdatedDelegate OnSaveSlotUpdated;
 
+	/**
+	 * Called for every change to the active save graph, with the change itself.
+	 * Prefer it over OnSaveSlotUpdated to keep derived state up to date without rebuilding it on every save or load.
+	 */
+	FMOnSaveGraphChangedDelegate OnSaveGraphChanged;
+
+	/**
+	 * Called while restoring a loaded save node, once the saveables gameplay depends on are restored: the player, and
+	 * saveables around it. The rest may still be restored over the next frames (see UMSaveSettings::RestoreBudgetMs).
+	 */
+	FMOnRestoreDelegate OnRestoreGameplayReady;
+
+	/** Called once every saveable of a loaded save node is restored */
+	FMOnRestoreDelegate OnRestoreCompleted;
+
 	/** Called when the save index is updated (added/removed/cloned save slots, etc.) */
 	FMOnSaveIndexUpdatedDelegate OnSaveIndexUpdated;
 
@@ -160,6 +296,7 @@ public:
 
 	/**
 	 * Loads a node from the save graph.
+	 * With UMSaveSettings::bProgressiveRestore, saveables may still be restored over the next frames afterwards.
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Save System")
 	UMSaveNode* LoadGame(FGuid SaveId);
@@ -169,6 +306,18 @@ public:
 	 */
 	void AsyncLoadGame(FMAsyncLoadGameDelegate Delegate, FGuid SaveId);
 
+	/**
+	 * Reads and resolves a node of the active slot on a worker thread, so loading it later only has to apply it.
+	 * Prefetched nodes are kept until loaded, released, or the active slot changes. Returns false if there is no such
+	 * node. See also UMSaveSettings::bWarmNeighbourNodes.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Save System")
+	bool PrefetchNode(FGuid SaveId);
+
+	/** Drops a prefetched node which is no longer about to be loaded */
+	UFUNCTION(BlueprintCallable, Category = "Save System")
+	void ReleasePrefetchedNode(FGuid SaveId);
+
 	/**
 	 * Asynchronously loads a node from the save graph and calls a delegate.
 	 *
@@ -293,6 +442,7 @@ public:
 
 	/**
 	 * Asynchronously deletes a save slot and all of its save nodes and calls a delegate.
+	 * The slot is never loaded, and its save nodes are deleted on a worker thread.
 	 */
 	void AsyncDeleteSaveSlot(FMAsyncDeleteSlotDelegate Delegate, const FString& SlotName, const int32 UserIndex);
 
@@ -306,7 +456,8 @@ public:
 
 	/**
 	 * Clones a save slot stored with the given slot name and user index, returns the new UMSaveGame.
-	 * Not intended for use in production. Just a debugging aid. VERY SLOW TO RUN.
+	 * The slot's files are copied as they are, without loading any of its save nodes. Replaces any slot already stored
+	 * under the new name, and leaves the active slot as it is.
 	 */
 	UMSaveGame* CloneSaveSlot(
 		const FString& OriginalSlotName,
@@ -314,16 +465,108 @@ public:
 		const FString& NewSlotName,
 		const int32	   NewUserIndex);
 
+	/**
+	 * Asynchronously clones a save slot and calls a delegate.
+	 * The slot's files are copied on a worker thread, see CloneSaveSlot.
+	 */
+	void AsyncCloneSaveSlot(
+		FMAsyncCloneSlotDelegate Delegate,
+		const FString&			 OriginalSlotName,
+		const int32				 OriginalUserIndex,
+		const FString&			 NewSlotName,
+		const int32				 NewUserIndex);
+
+	/**
+	 * Asynchronously clones a save slot and calls a delegate.
+	 * Bluprint-exposed version.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Save System", meta = (DisplayName = "Async Clone Save Slot"))
+	void AsyncCloneSaveSlotDynamic(
+		FMAsyncCloneSlotDelegateDynamic Delegate,
+		const FString&					OriginalSlotName,
+		const int32						OriginalUserIndex,
+		const FString&					NewSlotName,
+		const int32						NewUserIndex);
+
 	/** Returns the index of all known save slots */
 	UFUNCTION(BlueprintCallable, BlueprintPure = false, Category = "Save System")
 	TArray<FMSlotId> GetSaveIndex() const;
 
+	/** Returns the summary of every known save slot, without loading any of them */
+	UFUNCTION(BlueprintCallable, BlueprintPure = false, Category = "Save System")
+	TArray<FMSlotSummary> GetSlotSummaries() const;
+
+	/** Finds the summary of a save slot, without loading it. Returns false if the slot is not in the save index. */
+	UFUNCTION(BlueprintCallable, BlueprintPure = false, Category = "Save System")
+	bool GetSlotSummary(const FString& SlotName, const int32 UserIndex, FMSlotSummary& OutSummary) const;
+
+	/**
+	 * Sets the game-defined data of the active slot's summary, e.g. to show the chapter or play time in a save menu.
+	 * Returns false if it is larger than UMSaveSettings::MaxSlotUserDataBytes.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Save System")
+	bool SetSlotUserData(const TArray<uint8>& UserData);
+
 	/** Returns the currently active save slot */
 	UMSaveGame* GetActiveSaveGame() const { return ActiveSaveGame; }
 
+	/** Whether a loaded save node is still being restored across frames */
+	bool IsRestoring() const { return PendingRestore.IsValid(); }
+
+	/** Returns the revision of the last change broadcast through OnSaveGraphChanged */
+	int64 GetGraphRevision() const { return GraphRevision; }
+
+	/**
+	 * Changes the codec the active save slot compresses new save data with.
+	 * Save data already in the slot stays readable, and keeps the codec it was stored with.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Save System")
+	bool SetCompression(EMSaveCompression Compression);
+
+	/**
+	 * Removes the save nodes of the active slot which the retention settings of UMSaveSettings no longer keep, and
+	 * reclaims their space in the background. Remaining nodes are reparented (and rebased) onto their nearest remaining
+	 * ancestors, so everything stays reachable. Also runs automatically, see UMSaveSettings::CompactionInterval.
+	 * Returns false if nothing is due for removal, or the slot can't be compacted right now (e.g. while saving).
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Save System")
+	bool CompactSaveGraph();
+
 	/** Returns the save history for the currently active save slot */
 	UMSaveHistory* GetSaveHistory() const { return SaveHistory; }
 
+	/** Returns the save manager for the game instance of the given world context object (null if none) */
+	static UMSaveManager* Get(const UObject* WorldContextObject);
+
+	/**
+	 * Registers a saveable so it is included in save and load operations.
+	 * Saveables should register themselves in BeginPlay, and unregister themselves in EndPlay.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Save System")
+	void RegisterSaveable(UObject* Saveable);
+
+	/** Unregisters a saveable, excluding it from further save and load operations. */
+	UFUNCTION(BlueprintCallable, Category = "Save System")
+	void UnregisterSaveable(UObject* Saveable);
+
+	/**
+	 * Re-queries the save id of an already registered saveable.
+	 * Must be called whenever the value returned by IMSaveable::GetSaveId changes.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Save System")
+	void RefreshSaveableId(UObject* Saveable);
+
+	/**
+	 * Forgets the state a saveable was last saved or loaded with, so the next load applies save data to it even if it
+	 * seems unchanged. Only required when UMSaveSettings::bVerifySkippedSaveables is disabled.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Save System")
+	void MarkSaveableDirty(UObject* Saveable);
+
+	/** Returns the registered saveable with the given save id (null if none) */
+	UFUNCTION(BlueprintCallable, BlueprintPure = false, Category = "Save System")
+	UObject* FindSaveable(const FString& SaveId) const;
+
 	/** Initializes the subsystem, add console commands to manipulate the save manager */
 	void Initialize(FSubsystemCollectionBase& Collection) override;
 
@@ -335,6 +578,23 @@ private:
 	UPROPERTY()
 	TObjectPtr<UMSaveIndex> SaveIndex;
 
+	/** Whether the save index is being written, and whether it changed again since that write started */
+	bool bWritingSaveIndex = false;
+	bool bSaveIndexDirty = false;
+
+	/** Writes the save index in the background, after any write already in flight */
+	void WriteSaveIndex();
+
+	/**
+	 * Brings a slot's summary in the save index up to date with its metadata, writing the index if it changed.
+	 * A full scan also recomputes the slot's latest timestamp, which only ever grows as nodes are added.
+	 * Called once per journal record committed to the active slot. Never touches the disk.
+	 */
+	void UpdateSlotSummary(const UMSaveGame& SaveGame, bool bFullScan);
+
+	/** Commits metadata changes to the active slot's journal in the background, updating its summary afterwards */
+	void CommitJournal(TArray<FMSaveJournalOp> JournalOps);
+
 	/** The currently active save slot */
 	UPROPERTY()
 	TObjectPtr<UMSaveGame> ActiveSaveGame;
@@ -343,20 +603,231 @@ private:
 	UPROPERTY()
 	TObjectPtr<UMSaveHistory> SaveHistory;
 
-	/** Finds all saveables in the world */
-	void FindSaveables(TArray<UObject*>& OutSaveables) const;
+	/** Disk storage for the ActiveSaveGame's save nodes */
+	TSharedPtr<FMSaveStorage> ActiveStorage;
+
+	/** Returns the storage for the ActiveSaveGame, opening it if necessary */
+	FMSaveStorage& GetActiveStorage();
+
+	/** Dense array of all registered saveables */
+	TArray<FMRegisteredSaveable> Saveables;
+
+	/** Maps save ids to indices into Saveables */
+	TMap<FString, int32> SaveableIdToIndex;
+
+	/** Maps saveable objects to indices into Saveables */
+	TMap<TWeakObjectPtr<UObject>, int32> SaveableObjectToIndex;
+
+	/** Removes the registered saveable at the given index, keeping the lookup tables in sync */
+	void RemoveSaveableAt(int32 Index);
+
+	/** Returns the save ids of every registered saveable, for loading only the part of a node which can be applied */
+	TSharedRef<const TSet<FString>> GetRegisteredSaveableIds() const;
+
+	/**
+	 * The effective save data of the most recently saved or loaded node, used as the base for delta nodes.
+	 * Immutable once resolved, so worker threads assembling a delta can share it with the game thread.
+	 */
+	TSharedPtr<const TMap<FString, FMSaveData>> ResolvedSaveData;
+
+	/** The id of the save node ResolvedSaveData belongs to */
+	FGuid ResolvedSaveId;
+
+	/** The save node ResolvedSaveData belongs to, if it was saved or loaded as a whole rather than only resolved */
+	TStrongObjectPtr<UMSaveNode> ResolvedSaveNode;
+
+	/** The id of the save node saveables were last captured for, invalidated once anything is loaded afterwards */
+	FGuid CapturedSaveId;
+
+	/** The loaded save node still being restored, if any */
+	TSharedPtr<FMPendingRestore> PendingRestore;
+
+	/** Ticks PendingRestore while it is restored across frames */
+	FTSTicker::FDelegateHandle RestoreTickerHandle;
 
-	/** Creates a new save node and adds it to the save graph */
-	UMSaveNode* CreateSaveNode(FGuid BranchParentId, FGuid SequenceParentId, bool bRecall, bool bInvisible);
+	/**
+	 * Orders the entries of a restore. When prioritizing, the player comes first, then saveables by distance to where
+	 * the player is about to be, then saveables which are not in the world.
+	 */
+	void BuildRestoreOrder(FMPendingRestore& Restore, bool bPrioritize) const;
+
+	/** Restores saveables of the pending restore within the frame budget. Returns whether more frames are needed. */
+	bool TickRestore(float DeltaTime);
+
+	/** Restores the next saveable of the pending restore */
+	void RestoreNextSaveable();
+
+	/** Restores every remaining saveable of the pending restore right away */
+	void FinishRestore();
+
+	/** Drops the pending restore, leaving saveables which were not restored yet as they are */
+	void CancelRestore();
 
-	/** Clones a save node. Does not add it to the save graph. */
-	UMSaveNode* CloneSaveNode(const UMSaveNode* OriginalSaveNode);
+	/** Applies save data to a saveable, unless it is unchanged. Returns whether the save data was applied. */
+	bool ApplySaveable(const FString& SaveId, const FMSaveData& SaveData, const FIoHash* ContentHash, bool bRecall);
 
-	/** Deserializes a save node and triggers the game to load it */
+	/** Actors retired while loading, by class, so loading can reuse them rather than spawn new ones */
+	TMap<TWeakObjectPtr<UClass>, TArray<TWeakObjectPtr<AActor>>> ActorPool;
+
+	/**
+	 * Matches the spawned actors in the world to the ones of a loaded node: spawns (or reuses) the missing ones along
+	 * with their save data, and retires the extra ones.
+	 */
+	void ReconcileSpawnedActors(FMPendingRestore& Restore);
+
+	/**
+	 * Spawns an actor for save data, or reuses the retired actor it was saved from (matched by class, name and
+	 * partition), and reads the save data into it
+	 */
+	AActor* SpawnSaveable(UClass* Class, const FMSaveData& SaveData, bool bRecall);
+
+	/** Unregisters an actor and hides it in the pool for its class, destroying the longest pooled one if it is full */
+	void RetireActor(AActor* Actor);
+
+	/** Reads save data into a saveable */
+	void ReadSaveable(UObject* Saveable, const FMSaveData& SaveData, bool bRecall);
+
+	/** References read from save data to saveables which were not registered yet */
+	TArray<FMUnresolvedReference> UnresolvedReferences;
+
+	/**
+	 * Patches every unresolved reference whose saveable is registered by now. Runs once spawned actors were
+	 * reconciled, after every slice of a progressive restore, once a load has applied every saveable, and whenever a
+	 * partition streams in, so references read into containers are patched within the frame they were read in.
+	 * References to saveables which are still missing are kept, their partition may stream in later.
+	 */
+	void ResolveUnresolvedReferences();
+
+	/** Nodes being or already resolved ahead of loading them, by save id */
+	TMap<FGuid, FMPrefetchedNode> PrefetchedNodes;
+
+	/** Starts resolving a node of the active slot on a worker thread, unless it already is */
+	bool StartPrefetch(const FGuid& SaveId, bool bWarm);
+
+	/**
+	 * Returns a prefetched node if it is already resolved, never waiting for it. Returns null if it is still being
+	 * resolved, or (dropping the node) if it failed or omitted the save data of a saveable registered since then.
+	 */
+	FMPrefetchedNode* FindPrefetchedNode(const FGuid& SaveId, const TSet<FString>& SaveableIds);
+
+	/**
+	 * Returns the resolved or an already prefetched node, which loading it only has to apply. Nodes still being written
+	 * are only ever found here, since they can't be read back from the slot yet.
+	 */
+	UMSaveNode* FindCachedNode(const FGuid& SaveId, const TSet<FString>& SaveableIds);
+
+	/** Prefetches the neighbours of the most recent node, and drops nodes warmed for a previous one */
+	void WarmNeighbourNodes();
+
+	/** Keeps the resolved node around as a warm prefetched node, before a newer node replaces it as resolved */
+	void RetireResolvedNode();
+
+	/** Drops every prefetched node, never waiting for one. Nodes are only released once no worker reads them. */
+	void ReleasePrefetchedNodes();
+
+	/**
+	 * Save data of saveables whose partition (streaming level or World Partition cell) is not streamed in, by
+	 * partition. Filled when loading a node and when a partition streams out, applied once the partition streams in,
+	 * and carried into every save node in the meantime.
+	 */
+	TMap<FName, TMap<FString, FMSaveData>> DeferredSaveData;
+
+	/** Collects the partitions which are currently streamed in, including the persistent level's (none) */
+	void GetResidentPartitions(TSet<FName>& OutPartitions) const;
+
+	/** Returns the streamed in level of a partition (null for the persistent level, or if not streamed in) */
+	ULevel* FindResidentLevel(FName Partition) const;
+
+	/** Applies the deferred save data of a partition once it streams in */
+	void OnLevelAddedToWorld(ULevel* Level, UWorld* World);
+
+	/** Parks the state of a partition's saveables in DeferredSaveData before it streams out */
+	void OnPreLevelRemovedFromWorld(ULevel* Level, UWorld* World);
+
+	/** Drops the deferred save data of the world being torn down */
+	void OnWorldCleanup(UWorld* World, bool bSessionEnded, bool bCleanupResources);
+
+	/** Captures the raw state of a saveable */
+	void CaptureSaveable(UObject* Saveable, bool bRecall, FMSaveData& OutSaveData);
+
+	/** Whether a saveable's current state already matches a content hash, so loading can skip it */
+	bool IsSaveableUnchanged(const FMRegisteredSaveable& Registered, const FIoHash& ContentHash, bool bRecall);
+
+	/**
+	 * Creates a new save node and adds it to the save graph.
+	 * The node is a delta against its sequence parent, unless a keyframe is due.
+	 *
+	 * Only capturing the saveables happens on the game thread. Assembling, storing and writing the node happens on
+	 * worker threads, and OutWriteTask completes once the node is on disk. OnWritten is then called on the game thread.
+	 * The node must not be touched until then.
+	 */
+	UMSaveNode* CreateSaveNode(
+		FGuid													   BranchParentId,
+		FGuid													   SequenceParentId,
+		bool													   bRecall,
+		bool													   bInvisible,
+		UE::Tasks::TTask<bool>&									   OutWriteTask,
+		TUniqueFunction<void(UMSaveNode* SaveNode, bool bSuccess)> OnWritten = nullptr);
+
+	/**
+	 * Completes a save node once its write task finished. Caches a committed node, or takes a failed one back out of
+	 * the save graph. Returns whether the node was committed.
+	 */
+	bool FinishSaveNode(UMSaveNode* SaveNode, bool bCommitted);
+
+	/** Deserializes a save node (resolving its delta chain) and triggers the game to load it */
 	bool LoadSaveNode(UMSaveNode* SaveNode, bool bRecall);
 
-	/** Deletes the save nodes within a slot. Does not delete the slot itself. */
-	void DeleteSaveGraph(UMSaveGame* SaveGame);
+	/**
+	 * Starts copying a save slot's files for CloneSaveSlot, deleting any slot already stored under the new name first.
+	 * Returns an unset task if the original slot does not exist.
+	 */
+	TOptional<UE::Tasks::TTask<bool>> LaunchCloneSaveSlot(
+		const FString& OriginalSlotName,
+		const int32	   OriginalUserIndex,
+		const FString& NewSlotName,
+		const int32	   NewUserIndex);
+
+	/** Indexes a cloned save slot once its files are copied, carrying over the original's summary */
+	void FinishCloneSaveSlot(const FMSlotId& OriginalSlotId, UMSaveGame& NewSaveGame);
+
+	/**
+	 * Deletes a save slot and its save nodes, without loading it. Only the slot itself is deleted on the game thread,
+	 * its nodes are deleted in bulk on a worker thread. The returned task completes once they are gone.
+	 */
+	UE::Tasks::TTask<bool> DeleteSaveGraph(const FString& SlotName, const int32 UserIndex);
+
+	/** Whether the active slot is being compacted, and the number of nodes saved since it last was */
+	bool  bCompactingSaveGraph = false;
+	int32 NodesSinceCompaction = 0;
+
+	/**
+	 * Commits a compaction once the remaining nodes were rebased, unless anything saved or loaded since depends on a
+	 * removed node, then reclaims the space of the removed nodes in the background.
+	 */
+	void FinishCompactSaveGraph(
+		UMSaveGame* SaveGame, bool bRebased, TSet<FGuid> RemovedIds, TArray<FMSaveNodeMetadata> UpdatedNodes);
+
+	/** The revision of the last change broadcast through OnSaveGraphChanged */
+	int64 GraphRevision = 0;
+
+	/** The most recent node as of the last change broadcast, to report ActiveNodeChanged with the previous node */
+	FGuid BroadcastNodeId;
+
+	/** Broadcasts that the active save slot changed, along with OnSaveSlotUpdated */
+	void BroadcastSlotSwitched();
+
+	/** Broadcasts a committed node, then the most recent node change it caused, along with OnSaveSlotUpdated */
+	void BroadcastNodeAdded(const FGuid& SaveId);
+
+	/** Broadcasts a change of the most recent node (if it changed), along with OnSaveSlotUpdated */
+	void BroadcastActiveNodeChanged();
+
+	/** Broadcasts removed nodes, along with OnSaveSlotUpdated */
+	void BroadcastNodesRemoved(TArray<FGuid> NodeIds);
+
+	/** Stamps a change with the next revision and broadcasts it */
+	void BroadcastGraphEvent(FMSaveGraphEvent& Event);
 };
 
 #pragma endregion
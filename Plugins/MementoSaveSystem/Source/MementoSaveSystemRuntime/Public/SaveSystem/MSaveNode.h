@@ -3,10 +3,45 @@
 #pragma once
 
 #include "GameFramework/SaveGame.h"
+#include "SaveSystem/MSaveCompression.h"
 #include "SaveSystem/MSaveData.h"
 
 #include "MSaveNode.generated.h"
 
+/** Storage statistics of a save node, from when it was last written or loaded */
+USTRUCT(BlueprintType)
+struct MEMENTOSAVESYSTEMRUNTIME_API FMSaveNodeStats
+{
+	GENERATED_BODY()
+
+	/** The codec new payload chunks were compressed with */
+	UPROPERTY(BlueprintReadOnly)
+	EMSaveCompression Compression = EMSaveCompression::None;
+
+	/** The uncompressed size of every payload in the node, in bytes */
+	UPROPERTY(BlueprintReadOnly)
+	int64 PayloadSize = 0;
+
+	/** The uncompressed size of the chunks this node added to the slot, in bytes */
+	UPROPERTY(BlueprintReadOnly)
+	int64 NewChunkSize = 0;
+
+	/** The size those chunks take up on disk, in bytes */
+	UPROPERTY(BlueprintReadOnly)
+	int64 StoredSize = 0;
+
+	/** Time spent compressing payloads when writing the node, in milliseconds */
+	UPROPERTY(BlueprintReadOnly)
+	float EncodeTimeMs = 0.0f;
+
+	/** Time spent decompressing payloads when loading the node, in milliseconds */
+	UPROPERTY(BlueprintReadOnly)
+	float DecodeTimeMs = 0.0f;
+
+	/** How much smaller the new chunks got when stored (e.g. 4 for a quarter of their size) */
+	float GetCompressionRatio() const { return StoredSize > 0 ? static_cast<float>(NewChunkSize) / StoredSize : 1.0f; }
+};
+
 /** Container for save data within a single save node */
 UCLASS(BlueprintType)
 class MEMENTOSAVESYSTEMRUNTIME_API UMSaveNode : public USaveGame
@@ -18,7 +53,41 @@ public:
 	UPROPERTY(BlueprintReadOnly)
 	FGuid SaveId;
 
-	/** The save data, mapping actor save ids to save data */
+	/**
+	 * The save data, mapping actor save ids to save data.
+	 * For delta nodes, this only contains the save data which changed since the delta base.
+	 * Nodes loaded for a subset of saveables only hold placeholders for every other entry, see FMSaveData::bOmitted.
+	 */
 	UPROPERTY()
 	TMap<FString, FMSaveData> SaveData;
+
+	/** The id of the node this node is a delta against. Invalid if this node is a keyframe. */
+	UPROPERTY(BlueprintReadOnly)
+	FGuid DeltaBaseId;
+
+	/** Save ids present in the delta base, but absent from this node (tombstones) */
+	UPROPERTY()
+	TArray<FString> RemovedSaveIds;
+
+	/** Storage statistics, not saved with the node */
+	UPROPERTY(Transient, BlueprintReadOnly)
+	FMSaveNodeStats Stats;
+
+	/**
+	 * The content hash of every saveable captured in this node (not only the ones stored in it), while it is written.
+	 * Recorded in the slot's timeline once the node is committed, then discarded.
+	 */
+	TMap<FString, FIoHash> ContentHashes;
+
+	/** Whether this node contains the full save data, rather than a delta */
+	bool IsKeyframe() const { return !DeltaBaseId.IsValid(); }
+
+	/** Applies this node on top of the effective save data of its delta base (or replaces it, if a keyframe) */
+	void ApplyTo(TMap<FString, FMSaveData>& InOutSaveData) const;
+
+	/**
+	 * Merges this node's delta base into it, making it a delta against the base's own delta base (or a keyframe).
+	 * The effective save data of this node is unchanged. Used when compaction removes the delta base.
+	 */
+	void FoldDeltaBase(const UMSaveNode& DeltaBase);
 };
@@ -31,6 +31,14 @@ public:
 	UPROPERTY(BlueprintReadOnly)
 	bool bInvisible = false;
 
+	/** The id of the node this node's save data is a delta against. Invalid if the node is a keyframe. */
+	UPROPERTY(BlueprintReadOnly)
+	FGuid DeltaBaseId;
+
+	/** The number of delta nodes between this node and its keyframe (0 for keyframes). */
+	UPROPERTY(BlueprintReadOnly)
+	int32 DeltaDepth = 0;
+
 	// TODO: move these functions to the SaveManager for blueprint-friendly access
 
 	// UFUNCTION(BlueprintCallable, Category = "SaveSystem")
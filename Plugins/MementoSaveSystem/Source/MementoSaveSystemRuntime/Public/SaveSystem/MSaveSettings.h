@@ -0,0 +1,155 @@
+// Copyright © Bedrockbreaker 2025. MIT License
+
+#pragma once
+
+#include "Engine/DeveloperSettings.h"
+#include "SaveSystem/MSaveCompression.h"
+
+#include "MSaveSettings.generated.h"
+
+/** Project-wide settings for the Memento save system */
+UCLASS(Config = Game, DefaultConfig, meta = (DisplayName = "Memento Save System"))
+class MEMENTOSAVESYSTEMRUNTIME_API UMSaveSettings : public UDeveloperSettings
+{
+	GENERATED_BODY()
+
+public:
+	UMSaveSettings();
+
+	/**
+	 * Whether save nodes only store the save data that changed since their sequence parent.
+	 * Full keyframes are still written periodically to bound the cost of reconstructing a node.
+	 */
+	UPROPERTY(Config, EditAnywhere, Category = "Storage")
+	bool bDeltaNodes = true;
+
+	/** The maximum number of delta nodes chained on top of a single keyframe */
+	UPROPERTY(Config, EditAnywhere, Category = "Storage", meta = (ClampMin = 1, EditCondition = "bDeltaNodes"))
+	int32 KeyframeInterval = 16;
+
+	/**
+	 * The number of metadata journal records after which the slot itself is rewritten in the background.
+	 * Saving only appends to the journal, so lower values trade more slot rewrites for faster loading.
+	 */
+	UPROPERTY(Config, EditAnywhere, Category = "Storage", meta = (ClampMin = 1))
+	int32 JournalCompactionThreshold = 64;
+
+	/**
+	 * The codec new save slots compress their save data with.
+	 * Uncompressed save data is mapped straight from disk when loading, compressed save data has to be read and
+	 * decompressed first, so compression trades load time for disk space.
+	 */
+	UPROPERTY(Config, EditAnywhere, Category = "Storage")
+	EMSaveCompression DefaultCompression = EMSaveCompression::None;
+
+	/**
+	 * The number of save nodes after which a slot retrains its compression dictionary from its most recent save data.
+	 * Only used by codecs which support dictionaries. 0 disables dictionaries.
+	 */
+	UPROPERTY(Config, EditAnywhere, Category = "Storage", meta = (ClampMin = 0))
+	int32 DictionaryTrainingInterval = 32;
+
+	/** The most game-defined data each slot's summary in the save index can hold, see UMSaveManager::SetSlotUserData */
+	UPROPERTY(Config, EditAnywhere, Category = "Storage", meta = (ClampMin = 0, Units = "Bytes"))
+	int32 MaxSlotUserDataBytes = 256;
+
+	/**
+	 * The number of save nodes between automatic compactions of the save graph, which remove nodes the retention
+	 * settings no longer keep and reclaim their space. 0 only compacts through UMSaveManager::CompactSaveGraph.
+	 */
+	UPROPERTY(Config, EditAnywhere, Category = "Retention", meta = (ClampMin = 0))
+	int32 CompactionInterval = 32;
+
+	/**
+	 * The number of invisible save nodes (such as the side effects of recalls) kept, newest first. -1 keeps them all.
+	 * Visible save nodes are only ever removed by sequence thinning.
+	 */
+	UPROPERTY(Config, EditAnywhere, Category = "Retention", meta = (ClampMin = -1))
+	int32 MaxInvisibleNodes = 64;
+
+	/**
+	 * Visible save nodes older than this are thinned out along sequences, keeping one per thinning interval. Nodes
+	 * which branch, start a sequence or were loaded most recently are always kept. 0 keeps every visible node.
+	 */
+	UPROPERTY(Config, EditAnywhere, Category = "Retention", meta = (ClampMin = 0, Units = "Hours"))
+	float SequenceThinningAgeHours = 0.0f;
+
+	/** The span of time thinned sequences keep a single save node for, see SequenceThinningAgeHours */
+	UPROPERTY(Config, EditAnywhere, Category = "Retention", meta = (ClampMin = 1, Units = "Minutes"))
+	float SequenceThinningIntervalMinutes = 60.0f;
+
+	/**
+	 * Game thread time budget for capturing saveables when saving, in milliseconds.
+	 * Everything past the capture runs on worker threads. A warning is logged whenever a capture exceeds this.
+	 */
+	UPROPERTY(Config, EditAnywhere, Category = "Performance", meta = (ClampMin = 0, Units = "ms"))
+	float CaptureBudgetMs = 2.0f;
+
+	/**
+	 * Memory budget for save nodes cached by the save history, in megabytes.
+	 * Least recently used nodes are evicted past this, and reloaded from disk when queried again.
+	 */
+	UPROPERTY(Config, EditAnywhere, Category = "Performance", meta = (ClampMin = 0, Units = "MB"))
+	int32 HistoryCacheBudgetMB = 64;
+
+	/**
+	 * The number of sequence ancestors of the most recent save node which the save history never evicts.
+	 * Saveables mostly query their last few states, so these stay cached regardless of the memory budget.
+	 */
+	UPROPERTY(Config, EditAnywhere, Category = "Performance", meta = (ClampMin = 0))
+	int32 HistoryPinnedAncestors = 8;
+
+	/**
+	 * Whether the neighbours of the most recent save node are kept resolved in memory, so loading one of them only has
+	 * to apply it: its sequence parent and children, and its branch parent.
+	 */
+	UPROPERTY(Config, EditAnywhere, Category = "Performance")
+	bool bWarmNeighbourNodes = true;
+
+	/**
+	 * Whether loading skips saveables whose state would not change.
+	 * Every saveable remembers a hash of the state it was last saved or loaded with, which is compared against the
+	 * loaded save data. Skipped saveables are not moved, deserialized or notified at all.
+	 */
+	UPROPERTY(Config, EditAnywhere, Category = "Performance")
+	bool bDiffRestore = true;
+
+	/**
+	 * Whether saveables about to be skipped are captured again first, in case their state changed since it was last
+	 * saved or loaded. Can be disabled if saveables call UMSaveManager::MarkSaveableDirty whenever their state changes.
+	 */
+	UPROPERTY(Config, EditAnywhere, Category = "Performance", meta = (EditCondition = "bDiffRestore"))
+	bool bVerifySkippedSaveables = true;
+
+	/**
+	 * Whether loading restores saveables across several frames, instead of all at once.
+	 * The player is restored first, then saveables by distance to the player. UMSaveManager::OnRestoreGameplayReady
+	 * and OnRestoreCompleted report the progress. Recalls are always restored at once.
+	 */
+	UPROPERTY(Config, EditAnywhere, Category = "Performance")
+	bool bProgressiveRestore = false;
+
+	/** Game thread time budget per frame for restoring saveables progressively, in milliseconds */
+	UPROPERTY(
+		Config,
+		EditAnywhere,
+		Category = "Performance",
+		meta = (ClampMin = 0, Units = "ms", EditCondition = "bProgressiveRestore"))
+	float RestoreBudgetMs = 4.0f;
+
+	/** Saveables within this distance of the player must be restored before gameplay is considered ready */
+	UPROPERTY(
+		Config,
+		EditAnywhere,
+		Category = "Performance",
+		meta = (ClampMin = 0, Units = "cm", EditCondition = "bProgressiveRestore"))
+	float RestoreCriticalRadius = 2000.0f;
+
+	/**
+	 * The number of actors per class kept hidden for reuse once loading removed them from the world.
+	 * Loading back and forth across the same save nodes then reuses them, rather than destroying and spawning actors.
+	 * Only the very same actor (by name) is reused, so the longest pooled actors are destroyed first.
+	 */
+	UPROPERTY(Config, EditAnywhere, Category = "Performance", meta = (ClampMin = 0))
+	int32 MaxPooledActorsPerClass = 16;
+};
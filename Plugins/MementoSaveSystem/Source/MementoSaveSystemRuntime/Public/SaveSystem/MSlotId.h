@@ -21,4 +21,10 @@ public:
 
 	/** Equality operator */
 	bool operator==(const FMSlotId& Other) const { return SlotName == Other.SlotName && UserIndex == Other.UserIndex; }
+
+	/** Hash function, for keying maps by slot */
+	friend uint32 GetTypeHash(const FMSlotId& SlotId)
+	{
+		return HashCombine(GetTypeHash(SlotId.SlotName), GetTypeHash(SlotId.UserIndex));
+	}
 };
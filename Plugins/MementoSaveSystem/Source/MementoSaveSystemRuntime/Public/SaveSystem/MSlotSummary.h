@@ -0,0 +1,49 @@
+// Copyright © Bedrockbreaker 2025. MIT License
+
+#pragma once
+
+#include "SaveSystem/MSlotId.h"
+
+#include "MSlotSummary.generated.h"
+
+/** A small summary of a save slot, kept in the save index so save menus never have to load the slot itself */
+USTRUCT(BlueprintType)
+struct MEMENTOSAVESYSTEMRUNTIME_API FMSlotSummary
+{
+	GENERATED_BODY()
+
+public:
+	/** The slot this summary is for */
+	UPROPERTY(BlueprintReadOnly)
+	FMSlotId SlotId;
+
+	/** When the latest save node of the slot was saved */
+	UPROPERTY(BlueprintReadOnly)
+	FDateTime LastSaved;
+
+	/** The number of save nodes in the slot */
+	UPROPERTY(BlueprintReadOnly)
+	int32 NumNodes = 0;
+
+	/** The size of the slot's node storage on disk, in bytes */
+	UPROPERTY(BlueprintReadOnly)
+	int64 TotalBytes = 0;
+
+	/** The most recent save node of the slot */
+	UPROPERTY(BlueprintReadOnly)
+	FGuid HeadNodeId;
+
+	/**
+	 * Game-defined data to show alongside the slot (e.g. chapter or play time), see UMSaveManager::SetSlotUserData.
+	 * Limited to UMSaveSettings::MaxSlotUserDataBytes.
+	 */
+	UPROPERTY(BlueprintReadOnly)
+	TArray<uint8> UserData;
+
+	/** Equality operator */
+	bool operator==(const FMSlotSummary& Other) const
+	{
+		return SlotId == Other.SlotId && LastSaved == Other.LastSaved && NumNodes == Other.NumNodes
+			&& TotalBytes == Other.TotalBytes && HeadNodeId == Other.HeadNodeId && UserData == Other.UserData;
+	}
+};
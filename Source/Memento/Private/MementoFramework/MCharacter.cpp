@@ -11,6 +11,7 @@
 #include "GameFramework/Controller.h"
 #include "GameFramework/PlayerController.h"
 #include "InputActionValue.h"
+#include "SaveSystem/MSaveManager.h"
 
 DEFINE_LOG_CATEGORY(LogMCharacter);
 
@@ -74,6 +75,38 @@ void AMCharacter::SetupPlayerInputComponent(UInputComponent* PlayerInputComponen
 	EnhancedInputComponent->BindAction(LookAction, ETriggerEvent::Triggered, this, &AMCharacter::Look);
 }
 
+void AMCharacter::BeginPlay()
+{
+	Super::BeginPlay();
+
+	UMSaveManager* SaveManager = UMSaveManager::Get(this);
+	if (SaveManager) SaveManager->RegisterSaveable(this);
+}
+
+void AMCharacter::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	UMSaveManager* SaveManager = UMSaveManager::Get(this);
+	if (SaveManager) SaveManager->UnregisterSaveable(this);
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void AMCharacter::PossessedBy(AController* NewController)
+{
+	Super::PossessedBy(NewController);
+
+	UMSaveManager* SaveManager = UMSaveManager::Get(this);
+	if (SaveManager && HasActorBegunPlay()) SaveManager->RefreshSaveableId(this);
+}
+
+void AMCharacter::UnPossessed()
+{
+	Super::UnPossessed();
+
+	UMSaveManager* SaveManager = UMSaveManager::Get(this);
+	if (SaveManager && HasActorBegunPlay()) SaveManager->RefreshSaveableId(this);
+}
+
 FString AMCharacter::GetSaveId_Implementation() const
 {
 	APlayerController* PlayerController = GetController<APlayerController>();
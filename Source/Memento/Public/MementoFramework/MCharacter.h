@@ -50,6 +50,18 @@ protected:
 	/** Called when a UPlayerController possesses this Character */
 	virtual void SetupPlayerInputComponent(UInputComponent* PlayerInputComponent) override;
 
+	/** Registers this character with the save manager */
+	virtual void BeginPlay() override;
+
+	/** Unregisters this character from the save manager */
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	/** The save id depends on the controller, so refresh it with the save manager */
+	virtual void PossessedBy(AController* NewController) override;
+
+	/** The save id depends on the controller, so refresh it with the save manager */
+	virtual void UnPossessed() override;
+
 private:
 	// TODO: Replace with just a socket. Have the CamaeraManager attach the camera instead.
 	/** First person camera */
@@ -6,6 +6,7 @@
 #include "Engine/LocalPlayer.h"
 #include "EnhancedInputSubsystems.h"
 #include "InputMappingContext.h"
+#include "SaveSystem/MSaveManager.h"
 
 AMPlayerController::AMPlayerController()
 {
@@ -27,6 +28,22 @@ void AMPlayerController::SetupInputComponent()
 	}
 }
 
+void AMPlayerController::BeginPlay()
+{
+	Super::BeginPlay();
+
+	UMSaveManager* SaveManager = UMSaveManager::Get(this);
+	if (SaveManager) SaveManager->RegisterSaveable(this);
+}
+
+void AMPlayerController::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	UMSaveManager* SaveManager = UMSaveManager::Get(this);
+	if (SaveManager) SaveManager->UnregisterSaveable(this);
+
+	Super::EndPlay(EndPlayReason);
+}
+
 void AMPlayerController::Save(FArchive& OutData, bool bRecall, UMSaveHistory* SaveHistory)
 {
 	OutData << ControlRotation;
@@ -25,6 +25,12 @@ protected:
 	/** Setup input mapping contexts */
 	virtual void SetupInputComponent() override;
 
+	/** Registers this controller with the save manager */
+	virtual void BeginPlay() override;
+
+	/** Unregisters this controller from the save manager */
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 private:
 	/** Consistent save id */
 	virtual FString GetSaveId_Implementation() const override { return TEXT("TheStrangerController"); }